@@ -17,11 +17,13 @@
 
 #include "BasisFactorizationError.h"
 
+#include <cstdio>
+
 SparseColumnsOfBasis::SparseColumnsOfBasis( unsigned m )
     : _columns( NULL )
     , _m( m )
 {
-    _columns = new const SparseUnsortedList *[m];
+    _columns = new SparseSpan[m];
     if ( !_columns )
         throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
                                        "SparseColumnsOfBasis::columns" );
@@ -38,8 +40,17 @@ SparseColumnsOfBasis::~SparseColumnsOfBasis()
 
 void SparseColumnsOfBasis::dump() const
 {
+    double *work = new double[_m];
+
     for ( unsigned i = 0; i < _m; ++i )
-        _columns[i]->dumpDense();
+    {
+        _columns[i].toDense( work, _m );
+        for ( unsigned j = 0; j < _m; ++j )
+            printf( "%6.3lf ", work[j] );
+        printf( "\n" );
+    }
+
+    delete[] work;
 }
 
 //
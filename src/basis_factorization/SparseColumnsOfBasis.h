@@ -16,7 +16,7 @@
 #ifndef __SparseColumnsOfBasis_h__
 #define __SparseColumnsOfBasis_h__
 
-#include "SparseUnsortedList.h"
+#include "SparseSpan.h"
 
 class SparseColumnsOfBasis
 {
@@ -24,7 +24,11 @@ public:
     SparseColumnsOfBasis( unsigned m );
     ~SparseColumnsOfBasis();
 
-    const SparseUnsortedList **_columns;
+    /*
+      The columns of the basis, as views into the storage of the
+      constraint matrix
+    */
+    SparseSpan *_columns;
 
     /*
       For debugging purposes
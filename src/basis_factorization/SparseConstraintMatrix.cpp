@@ -0,0 +1,717 @@
+/*********************                                                        */
+/*! \file SparseConstraintMatrix.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "SparseConstraintMatrix.h"
+
+#include "BasisFactorizationError.h"
+#include "Debug.h"
+#include "FloatUtils.h"
+#include "SparseUnsortedList.h"
+
+#include <cstring>
+
+SparseConstraintMatrix::SegmentedStorage::SegmentedStorage()
+    : _entries( NULL )
+    , _used( 0 )
+    , _allocated( 0 )
+    , _nnz( 0 )
+    , _start( NULL )
+    , _size( NULL )
+    , _capacity( NULL )
+    , _numSegments( 0 )
+    , _allocatedSegments( 0 )
+{
+}
+
+SparseConstraintMatrix::SegmentedStorage::~SegmentedStorage()
+{
+    freeMemoryIfNeeded();
+}
+
+void SparseConstraintMatrix::SegmentedStorage::freeMemoryIfNeeded()
+{
+    if ( _entries )
+    {
+        delete[] _entries;
+        _entries = NULL;
+    }
+
+    if ( _start )
+    {
+        delete[] _start;
+        _start = NULL;
+    }
+
+    if ( _size )
+    {
+        delete[] _size;
+        _size = NULL;
+    }
+
+    if ( _capacity )
+    {
+        delete[] _capacity;
+        _capacity = NULL;
+    }
+}
+
+void SparseConstraintMatrix::SegmentedStorage::initialize( unsigned numSegments,
+                                                           const unsigned *capacities )
+{
+    freeMemoryIfNeeded();
+
+    _numSegments = numSegments;
+    _allocatedSegments = std::max( numSegments, 1U );
+
+    _start = new unsigned[_allocatedSegments];
+    if ( !_start )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseConstraintMatrix::start" );
+
+    _size = new unsigned[_allocatedSegments];
+    if ( !_size )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseConstraintMatrix::size" );
+
+    _capacity = new unsigned[_allocatedSegments];
+    if ( !_capacity )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseConstraintMatrix::capacity" );
+
+    _used = 0;
+    for ( unsigned i = 0; i < _numSegments; ++i )
+    {
+        _start[i] = _used;
+        _size[i] = 0;
+        _capacity[i] = capacities ? capacities[i] : 0;
+        _used += _capacity[i];
+    }
+
+    _allocated = std::max( _used, 1U );
+    _entries = new Entry[_allocated];
+    if ( !_entries )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseConstraintMatrix::entries" );
+
+    _nnz = 0;
+}
+
+void SparseConstraintMatrix::SegmentedStorage::addSegment( unsigned capacity )
+{
+    if ( _numSegments == _allocatedSegments )
+        increaseNumSegments();
+
+    if ( _used + capacity > _allocated )
+        compact( std::max( 2 * _allocated, _used + capacity ) );
+
+    _start[_numSegments] = _used;
+    _size[_numSegments] = 0;
+    _capacity[_numSegments] = capacity;
+    _used += capacity;
+    ++_numSegments;
+}
+
+void SparseConstraintMatrix::SegmentedStorage::increaseNumSegments()
+{
+    unsigned newAllocatedSegments = std::max( 2 * _allocatedSegments, 1U );
+
+    unsigned *newStart = new unsigned[newAllocatedSegments];
+    if ( !newStart )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseConstraintMatrix::newStart" );
+
+    unsigned *newSize = new unsigned[newAllocatedSegments];
+    if ( !newSize )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseConstraintMatrix::newSize" );
+
+    unsigned *newCapacity = new unsigned[newAllocatedSegments];
+    if ( !newCapacity )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseConstraintMatrix::newCapacity" );
+
+    if ( _numSegments > 0 )
+    {
+        memcpy( newStart, _start, sizeof( unsigned ) * _numSegments );
+        memcpy( newSize, _size, sizeof( unsigned ) * _numSegments );
+        memcpy( newCapacity, _capacity, sizeof( unsigned ) * _numSegments );
+    }
+
+    delete[] _start;
+    delete[] _size;
+    delete[] _capacity;
+
+    _start = newStart;
+    _size = newSize;
+    _capacity = newCapacity;
+    _allocatedSegments = newAllocatedSegments;
+}
+
+void SparseConstraintMatrix::SegmentedStorage::increaseSegmentCapacity( unsigned segment )
+{
+    unsigned oldCapacity = _capacity[segment];
+    unsigned newCapacity = std::max( 2 * oldCapacity, (unsigned)MIN_SEGMENT_CAPACITY );
+    unsigned growth = newCapacity - oldCapacity;
+
+    // The last segment in the buffer can simply be extended
+    if ( _start[segment] + oldCapacity == _used && _used + growth <= _allocated )
+    {
+        _capacity[segment] = newCapacity;
+        _used += growth;
+        return;
+    }
+
+    if ( _used + newCapacity > _allocated )
+    {
+        /*
+          Not enough room to relocate the segment: repack the buffer
+          into a larger one. Compaction lays the segments out according
+          to their capacities, so the new capacity is set first.
+        */
+        unsigned liveCapacity = growth;
+        for ( unsigned i = 0; i < _numSegments; ++i )
+            liveCapacity += _capacity[i];
+
+        _capacity[segment] = newCapacity;
+        compact( std::max( 2 * liveCapacity, _allocated ) );
+        return;
+    }
+
+    // Move the segment to the end of the buffer
+    if ( _size[segment] > 0 )
+        memcpy(
+            _entries + _used, _entries + _start[segment], sizeof( Entry ) * _size[segment] );
+
+    _start[segment] = _used;
+    _capacity[segment] = newCapacity;
+    _used += newCapacity;
+}
+
+void SparseConstraintMatrix::SegmentedStorage::compact( unsigned newAllocated )
+{
+    Entry *newEntries = new Entry[newAllocated];
+    if ( !newEntries )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseConstraintMatrix::newEntries" );
+
+    unsigned position = 0;
+    for ( unsigned i = 0; i < _numSegments; ++i )
+    {
+        if ( _size[i] > 0 )
+            memcpy( newEntries + position, _entries + _start[i], sizeof( Entry ) * _size[i] );
+
+        _start[i] = position;
+        position += _capacity[i];
+    }
+
+    ASSERT( position <= newAllocated );
+
+    delete[] _entries;
+    _entries = newEntries;
+    _used = position;
+    _allocated = newAllocated;
+}
+
+unsigned SparseConstraintMatrix::SegmentedStorage::getNumSegments() const
+{
+    return _numSegments;
+}
+
+unsigned SparseConstraintMatrix::SegmentedStorage::getNnz() const
+{
+    return _nnz;
+}
+
+unsigned SparseConstraintMatrix::SegmentedStorage::getSize( unsigned segment ) const
+{
+    ASSERT( segment < _numSegments );
+    return _size[segment];
+}
+
+SparseSpan SparseConstraintMatrix::SegmentedStorage::getSpan( unsigned segment ) const
+{
+    ASSERT( segment < _numSegments );
+    const Entry *begin = _entries + _start[segment];
+    return SparseSpan( begin, begin + _size[segment] );
+}
+
+SparseConstraintMatrix::Entry *
+SparseConstraintMatrix::SegmentedStorage::getEntries( unsigned segment )
+{
+    ASSERT( segment < _numSegments );
+    return _entries + _start[segment];
+}
+
+unsigned SparseConstraintMatrix::SegmentedStorage::find( unsigned segment,
+                                                         unsigned index ) const
+{
+    ASSERT( segment < _numSegments );
+
+    const Entry *entries = _entries + _start[segment];
+    for ( unsigned i = 0; i < _size[segment]; ++i )
+    {
+        if ( entries[i]._index == index )
+            return i;
+    }
+
+    return _size[segment];
+}
+
+void SparseConstraintMatrix::SegmentedStorage::append( unsigned segment,
+                                                       unsigned index,
+                                                       double value )
+{
+    ASSERT( segment < _numSegments );
+
+    if ( _size[segment] == _capacity[segment] )
+        increaseSegmentCapacity( segment );
+
+    _entries[_start[segment] + _size[segment]] = Entry( index, value );
+    ++_size[segment];
+    ++_nnz;
+}
+
+void SparseConstraintMatrix::SegmentedStorage::erase( unsigned segment, unsigned position )
+{
+    ASSERT( segment < _numSegments );
+    ASSERT( position < _size[segment] );
+
+    // Entries are unsorted, so the last entry fills the hole
+    Entry *entries = _entries + _start[segment];
+    entries[position] = entries[_size[segment] - 1];
+    --_size[segment];
+    --_nnz;
+}
+
+void SparseConstraintMatrix::SegmentedStorage::clearSegment( unsigned segment )
+{
+    ASSERT( segment < _numSegments );
+
+    _nnz -= _size[segment];
+    _size[segment] = 0;
+}
+
+void SparseConstraintMatrix::SegmentedStorage::clear()
+{
+    std::fill_n( _size, _numSegments, 0 );
+    _nnz = 0;
+}
+
+void SparseConstraintMatrix::SegmentedStorage::storeIntoOther( SegmentedStorage *other ) const
+{
+    other->freeMemoryIfNeeded();
+
+    other->_used = _used;
+    other->_allocated = _allocated;
+    other->_nnz = _nnz;
+    other->_numSegments = _numSegments;
+    other->_allocatedSegments = _allocatedSegments;
+
+    other->_entries = new Entry[_allocated];
+    if ( !other->_entries )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseConstraintMatrix::otherEntries" );
+    memcpy( other->_entries, _entries, sizeof( Entry ) * _used );
+
+    other->_start = new unsigned[_allocatedSegments];
+    if ( !other->_start )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseConstraintMatrix::otherStart" );
+    memcpy( other->_start, _start, sizeof( unsigned ) * _numSegments );
+
+    other->_size = new unsigned[_allocatedSegments];
+    if ( !other->_size )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseConstraintMatrix::otherSize" );
+    memcpy( other->_size, _size, sizeof( unsigned ) * _numSegments );
+
+    other->_capacity = new unsigned[_allocatedSegments];
+    if ( !other->_capacity )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseConstraintMatrix::otherCapacity" );
+    memcpy( other->_capacity, _capacity, sizeof( unsigned ) * _numSegments );
+}
+
+SparseConstraintMatrix::SparseConstraintMatrix()
+    : _m( 0 )
+    , _n( 0 )
+{
+}
+
+SparseConstraintMatrix::SparseConstraintMatrix( const double *M, unsigned m, unsigned n )
+    : _m( 0 )
+    , _n( 0 )
+{
+    initialize( M, m, n );
+}
+
+SparseConstraintMatrix::~SparseConstraintMatrix()
+{
+}
+
+void SparseConstraintMatrix::initialize( const double *M, unsigned m, unsigned n )
+{
+    _m = m;
+    _n = n;
+
+    unsigned *rowCounts = new unsigned[std::max( m, 1U )];
+    if ( !rowCounts )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseConstraintMatrix::rowCounts" );
+
+    unsigned *columnCounts = new unsigned[std::max( n, 1U )];
+    if ( !columnCounts )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseConstraintMatrix::columnCounts" );
+
+    std::fill_n( rowCounts, m, 0 );
+    std::fill_n( columnCounts, n, 0 );
+    for ( unsigned i = 0; i < m; ++i )
+    {
+        for ( unsigned j = 0; j < n; ++j )
+        {
+            if ( !FloatUtils::isZero( M[i * n + j] ) )
+            {
+                ++rowCounts[i];
+                ++columnCounts[j];
+            }
+        }
+    }
+
+    _rows.initialize( m, rowCounts );
+    _columns.initialize( n, columnCounts );
+
+    delete[] rowCounts;
+    delete[] columnCounts;
+
+    for ( unsigned i = 0; i < m; ++i )
+    {
+        for ( unsigned j = 0; j < n; ++j )
+        {
+            double value = M[i * n + j];
+            if ( FloatUtils::isZero( value ) )
+                continue;
+
+            _rows.append( i, j, value );
+            _columns.append( j, i, value );
+        }
+    }
+
+    _committedChanges.clear();
+}
+
+void SparseConstraintMatrix::initializeToEmpty( unsigned m, unsigned n )
+{
+    _m = m;
+    _n = n;
+
+    _rows.initialize( m, NULL );
+    _columns.initialize( n, NULL );
+
+    _committedChanges.clear();
+}
+
+unsigned SparseConstraintMatrix::getM() const
+{
+    return _m;
+}
+
+unsigned SparseConstraintMatrix::getN() const
+{
+    return _n;
+}
+
+SparseSpan SparseConstraintMatrix::getRowSpan( unsigned row ) const
+{
+    ASSERT( row < _m );
+    return _rows.getSpan( row );
+}
+
+SparseSpan SparseConstraintMatrix::getColumnSpan( unsigned column ) const
+{
+    ASSERT( column < _n );
+    return _columns.getSpan( column );
+}
+
+double SparseConstraintMatrix::get( unsigned row, unsigned column ) const
+{
+    ASSERT( row < _m );
+    ASSERT( column < _n );
+
+    // Scan whichever of the two is shorter
+    if ( _rows.getSize( row ) <= _columns.getSize( column ) )
+        return _rows.getSpan( row ).get( column );
+
+    return _columns.getSpan( column ).get( row );
+}
+
+void SparseConstraintMatrix::getRow( unsigned row, SparseUnsortedList *result ) const
+{
+    result->clear();
+    for ( const auto &entry : getRowSpan( row ) )
+        result->append( entry._index, entry._value );
+}
+
+void SparseConstraintMatrix::getRowDense( unsigned row, double *result ) const
+{
+    getRowSpan( row ).toDense( result, _n );
+}
+
+void SparseConstraintMatrix::getColumn( unsigned column, SparseUnsortedList *result ) const
+{
+    result->clear();
+    for ( const auto &entry : getColumnSpan( column ) )
+        result->append( entry._index, entry._value );
+}
+
+void SparseConstraintMatrix::getColumnDense( unsigned column, double *result ) const
+{
+    getColumnSpan( column ).toDense( result, _m );
+}
+
+void SparseConstraintMatrix::setInSegment( SegmentedStorage &storage,
+                                           unsigned segment,
+                                           unsigned index,
+                                           double value )
+{
+    bool isZero = FloatUtils::isZero( value );
+    unsigned position = storage.find( segment, index );
+
+    if ( position < storage.getSize( segment ) )
+    {
+        if ( isZero )
+            storage.erase( segment, position );
+        else
+            storage.getEntries( segment )[position]._value = value;
+    }
+    else if ( !isZero )
+    {
+        storage.append( segment, index, value );
+    }
+}
+
+void SparseConstraintMatrix::set( unsigned row, unsigned column, double value )
+{
+    ASSERT( row < _m );
+    ASSERT( column < _n );
+
+    setInSegment( _rows, row, column, value );
+    setInSegment( _columns, column, row, value );
+}
+
+void SparseConstraintMatrix::addLastRow( const double *row )
+{
+    unsigned count = 0;
+    for ( unsigned i = 0; i < _n; ++i )
+    {
+        if ( !FloatUtils::isZero( row[i] ) )
+            ++count;
+    }
+
+    _rows.addSegment( count );
+    for ( unsigned i = 0; i < _n; ++i )
+    {
+        if ( FloatUtils::isZero( row[i] ) )
+            continue;
+
+        _rows.append( _m, i, row[i] );
+        _columns.append( i, _m, row[i] );
+    }
+
+    ++_m;
+}
+
+void SparseConstraintMatrix::addLastColumn( const double *column )
+{
+    unsigned count = 0;
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        if ( !FloatUtils::isZero( column[i] ) )
+            ++count;
+    }
+
+    _columns.addSegment( count );
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        if ( FloatUtils::isZero( column[i] ) )
+            continue;
+
+        _columns.append( _n, i, column[i] );
+        _rows.append( i, _n, column[i] );
+    }
+
+    ++_n;
+}
+
+void SparseConstraintMatrix::addEmptyColumn()
+{
+    _columns.addSegment( 0 );
+    ++_n;
+}
+
+void SparseConstraintMatrix::commitChange( unsigned row, unsigned column, double newValue )
+{
+    _committedChanges.append( CommittedChange( row, column, newValue ) );
+}
+
+void SparseConstraintMatrix::executeChanges()
+{
+    for ( const auto &change : _committedChanges )
+        set( change._row, change._column, change._value );
+
+    _committedChanges.clear();
+}
+
+void SparseConstraintMatrix::countElements( unsigned *numRowElements,
+                                            unsigned *numColumnElements )
+{
+    for ( unsigned i = 0; i < _m; ++i )
+        numRowElements[i] = _rows.getSize( i );
+
+    for ( unsigned i = 0; i < _n; ++i )
+        numColumnElements[i] = _columns.getSize( i );
+}
+
+void SparseConstraintMatrix::transposeIntoOther( SparseMatrix *other )
+{
+    other->initializeToEmpty( _n, _m );
+
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        for ( const auto &entry : getRowSpan( i ) )
+            other->commitChange( entry._index, i, entry._value );
+    }
+
+    other->executeChanges();
+}
+
+void SparseConstraintMatrix::storeIntoOther( SparseMatrix *other ) const
+{
+    SparseConstraintMatrix *otherMatrix = (SparseConstraintMatrix *)other;
+
+    otherMatrix->_m = _m;
+    otherMatrix->_n = _n;
+    _rows.storeIntoOther( &otherMatrix->_rows );
+    _columns.storeIntoOther( &otherMatrix->_columns );
+    otherMatrix->_committedChanges.clear();
+}
+
+void SparseConstraintMatrix::mergeColumns( unsigned x1, unsigned x2 )
+{
+    ASSERT( x1 < _n );
+    ASSERT( x2 < _n );
+    ASSERT( x1 != x2 );
+
+    /*
+      Appending to column x1 may relocate the column buffer, so the
+      entries of column x2 are re-fetched on every iteration.
+    */
+    for ( unsigned i = 0; i < _columns.getSize( x2 ); ++i )
+    {
+        Entry entry = _columns.getEntries( x2 )[i];
+        unsigned row = entry._index;
+
+        unsigned x2Position = _rows.find( row, x2 );
+        ASSERT( x2Position < _rows.getSize( row ) );
+
+        unsigned x1Position = _rows.find( row, x1 );
+        if ( x1Position < _rows.getSize( row ) )
+        {
+            /*
+              x1 already has an entry for this row: adjust it, and
+              delete it if the sum is zero.
+            */
+            double sum = _rows.getEntries( row )[x1Position]._value + entry._value;
+            _rows.erase( row, x2Position );
+            setInSegment( _rows, row, x1, sum );
+            setInSegment( _columns, x1, row, sum );
+        }
+        else
+        {
+            // x1 didn't have an entry, so x2's entry is re-used
+            _rows.getEntries( row )[x2Position]._index = x1;
+            _columns.append( x1, row, entry._value );
+        }
+    }
+
+    // Note that _n is not changed: the merged column just stays empty
+    _columns.clearSegment( x2 );
+}
+
+unsigned SparseConstraintMatrix::getNnz() const
+{
+    return _rows.getNnz();
+}
+
+void SparseConstraintMatrix::toDense( double *result ) const
+{
+    std::fill_n( result, _m * _n, 0 );
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        for ( const auto &entry : getRowSpan( i ) )
+            result[i * _n + entry._index] = entry._value;
+    }
+}
+
+void SparseConstraintMatrix::clear()
+{
+    _rows.clear();
+    _columns.clear();
+    _committedChanges.clear();
+}
+
+void SparseConstraintMatrix::dump() const
+{
+    printf( "\nDumping sparse constraint matrix: (m = %u, n = %u, nnz = %u)\n",
+            _m,
+            _n,
+            getNnz() );
+
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        printf( "\tRow %u: ", i );
+        for ( const auto &entry : getRowSpan( i ) )
+            printf( "(%u, %5.2lf) ", entry._index, entry._value );
+        printf( "\n" );
+    }
+
+    printf( "\n" );
+}
+
+void SparseConstraintMatrix::dumpDense() const
+{
+    double *work = new double[_m * _n];
+    toDense( work );
+
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        for ( unsigned j = 0; j < _n; ++j )
+        {
+            printf( "%5.2lf ", work[i * _n + j] );
+        }
+        printf( "\n" );
+    }
+
+    printf( "\n" );
+    delete[] work;
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
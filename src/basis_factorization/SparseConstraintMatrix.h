@@ -0,0 +1,261 @@
+/*********************                                                        */
+/*! \file SparseConstraintMatrix.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#ifndef __SparseConstraintMatrix_h__
+#define __SparseConstraintMatrix_h__
+
+#include "List.h"
+#include "SparseMatrix.h"
+#include "SparseSpan.h"
+
+/*
+  A sparse matrix that simultaneously provides a row-wise (CSR-like)
+  and a column-wise (CSC-like) view of its elements. It is intended
+  for the tableau's constraint matrix, which is accessed both by rows
+  (bound tightening) and by columns (pricing, FTRAN), and which grows
+  when equations are added.
+
+  Each view is stored in a single contiguous buffer of entries. The
+  buffer is split into segments, one per row (resp. column), and each
+  segment has some slack so that elements can be appended in place.
+  When a segment runs out of room it is moved to the end of the
+  buffer with doubled capacity; the buffer is compacted when it fills
+  up. Entries within a segment are unsorted.
+
+  Rows and columns are exposed as SparseSpans, which point directly
+  into the buffers and are invalidated by any modification of the
+  matrix.
+*/
+class SparseConstraintMatrix : public SparseMatrix
+{
+public:
+    typedef SparseSpan::Entry Entry;
+
+    SparseConstraintMatrix();
+    SparseConstraintMatrix( const double *M, unsigned m, unsigned n );
+    ~SparseConstraintMatrix();
+
+    /*
+      Initialize from a dense, row-major matrix M of dimensions m x n,
+      or to an empty matrix of the given dimensions.
+    */
+    void initialize( const double *M, unsigned m, unsigned n );
+    void initializeToEmpty( unsigned m, unsigned n );
+
+    /*
+      Dimensions
+    */
+    unsigned getM() const;
+    unsigned getN() const;
+
+    /*
+      Span-style access to a single row or column
+    */
+    SparseSpan getRowSpan( unsigned row ) const;
+    SparseSpan getColumnSpan( unsigned column ) const;
+
+    /*
+      Obtain a single element/row/column of the matrix.
+    */
+    double get( unsigned row, unsigned column ) const;
+    void getRow( unsigned row, SparseUnsortedList *result ) const;
+    void getRowDense( unsigned row, double *result ) const;
+    void getColumn( unsigned column, SparseUnsortedList *result ) const;
+    void getColumnDense( unsigned column, double *result ) const;
+
+    /*
+      Set a single element, updating both views. Setting an element
+      to zero removes it.
+    */
+    void set( unsigned row, unsigned column, double value );
+
+    /*
+      Add a row/column to the end of the matrix.
+      The new row/column is provided in dense format.
+    */
+    void addLastRow( const double *row );
+    void addLastColumn( const double *column );
+
+    /*
+      Increment n, the number of columns. The new column is empty.
+    */
+    void addEmptyColumn();
+
+    /*
+      A mechanism for storing a set of changes to the matrix,
+      and then executing them all at once.
+    */
+    void commitChange( unsigned row, unsigned column, double newValue );
+    void executeChanges();
+
+    /*
+      Count the number of elements in each row and column
+    */
+    void countElements( unsigned *numRowElements, unsigned *numColumnElements );
+
+    /*
+      Transpose the matrix and store it in another matrix
+    */
+    void transposeIntoOther( SparseMatrix *other );
+
+    /*
+      Storing and restoring. This assumes the other matrix is also a
+      SparseConstraintMatrix.
+    */
+    void storeIntoOther( SparseMatrix *other ) const;
+
+    /*
+      Merge column x2 into column x1, and zero x2 out
+    */
+    void mergeColumns( unsigned x1, unsigned x2 );
+
+    /*
+      Get the number of non-zero elements
+    */
+    unsigned getNnz() const;
+
+    /*
+      Produce a dense, row-major version of the matrix
+    */
+    void toDense( double *result ) const;
+
+    /*
+      Empty the matrix without changing its dimensions
+    */
+    void clear();
+
+    /*
+      For debugging purposes.
+    */
+    void dump() const;
+    void dumpDense() const;
+
+private:
+    /*
+      A contiguous buffer of entries, split into growable segments.
+      Used once for the rows and once for the columns.
+    */
+    class SegmentedStorage
+    {
+    public:
+        SegmentedStorage();
+        ~SegmentedStorage();
+
+        /*
+          Allocate numSegments empty segments, where segment i has
+          room for capacities[i] entries.
+        */
+        void initialize( unsigned numSegments, const unsigned *capacities );
+
+        /*
+          Add a new, empty segment with the given capacity
+        */
+        void addSegment( unsigned capacity );
+
+        unsigned getNumSegments() const;
+        unsigned getNnz() const;
+        unsigned getSize( unsigned segment ) const;
+        SparseSpan getSpan( unsigned segment ) const;
+        Entry *getEntries( unsigned segment );
+
+        /*
+          Find the position of an index within a segment, or return
+          the segment size if it does not exist.
+        */
+        unsigned find( unsigned segment, unsigned index ) const;
+
+        /*
+          Append an entry to a segment. Call only if the index does
+          not already appear in the segment.
+        */
+        void append( unsigned segment, unsigned index, double value );
+
+        /*
+          Remove the entry at the given position of a segment
+        */
+        void erase( unsigned segment, unsigned position );
+
+        /*
+          Remove all the entries, keeping the segments and capacities
+        */
+        void clearSegment( unsigned segment );
+        void clear();
+
+        void storeIntoOther( SegmentedStorage *other ) const;
+
+    private:
+        Entry *_entries;
+        unsigned _used;
+        unsigned _allocated;
+        unsigned _nnz;
+
+        unsigned *_start;
+        unsigned *_size;
+        unsigned *_capacity;
+        unsigned _numSegments;
+        unsigned _allocatedSegments;
+
+        enum {
+            MIN_SEGMENT_CAPACITY = 4,
+        };
+
+        void freeMemoryIfNeeded();
+        void increaseSegmentCapacity( unsigned segment );
+        void increaseNumSegments();
+
+        /*
+          Repack all segments at the beginning of a buffer of the
+          given size, dropping the holes left by relocated segments
+        */
+        void compact( unsigned newAllocated );
+    };
+
+    struct CommittedChange
+    {
+        CommittedChange( unsigned row, unsigned column, double value )
+            : _row( row )
+            , _column( column )
+            , _value( value )
+        {
+        }
+
+        unsigned _row;
+        unsigned _column;
+        double _value;
+    };
+
+    unsigned _m;
+    unsigned _n;
+
+    SegmentedStorage _rows;
+    SegmentedStorage _columns;
+
+    List<CommittedChange> _committedChanges;
+
+    void setInSegment( SegmentedStorage &storage,
+                       unsigned segment,
+                       unsigned index,
+                       double value );
+};
+
+#endif // __SparseConstraintMatrix_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
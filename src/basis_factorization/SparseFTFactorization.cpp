@@ -20,6 +20,7 @@
 #include "FloatUtils.h"
 #include "GlobalConfiguration.h"
 #include "MalformedBasisException.h"
+#include "TimeUtils.h"
 
 SparseFTFactorization::SparseFTFactorization( unsigned m,
                                               const BasisColumnOracle &basisColumnOracle )
@@ -29,6 +30,12 @@ SparseFTFactorization::SparseFTFactorization( unsigned m,
     , _sparseLUFactors( m )
     , _sparseGaussianEliminator( m )
     , _statistics( NULL )
+    , _numUpdatesSinceRefactorization( 0 )
+    , _etaNnz( 0 )
+    , _refactorizationCost( 0 )
+    , _numTransformationsSinceRefactorization( 0 )
+    , _transformationCostSinceRefactorization( 0 )
+    , _averageTransformationCost( 0 )
     , _z1( NULL )
     , _z2( NULL )
     , _z3( NULL )
@@ -110,12 +117,29 @@ void SparseFTFactorization::updateToAdjacentBasis( unsigned columnIndex,
     // p = vRowDiagonalIndex
     // t = lastNonZeroEntryInU
 
-    if ( _etas.size() > GlobalConfiguration::REFACTORIZATION_THRESHOLD )
+    if ( shouldRefactorize() )
     {
+        if ( _statistics )
+        {
+            _statistics->incLongAttribute(
+                Statistics::NUM_BASIS_UPDATE_TRIGGERED_REFACTORIZATIONS );
+            _statistics->incLongAttribute( Statistics::TOTAL_BASIS_REFACTORIZATION_INTERVALS,
+                                           _numUpdatesSinceRefactorization );
+            _statistics->setUnsignedAttribute( Statistics::LAST_BASIS_REFACTORIZATION_INTERVAL,
+                                               _numUpdatesSinceRefactorization );
+            if ( _numUpdatesSinceRefactorization >
+                 _statistics->getUnsignedAttribute(
+                     Statistics::MAX_BASIS_REFACTORIZATION_INTERVAL ) )
+                _statistics->setUnsignedAttribute( Statistics::MAX_BASIS_REFACTORIZATION_INTERVAL,
+                                                   _numUpdatesSinceRefactorization );
+        }
+
         obtainFreshBasis();
         return;
     }
 
+    ++_numUpdatesSinceRefactorization;
+
     fixPForL();
 
     /*
@@ -298,6 +322,7 @@ void SparseFTFactorization::updateToAdjacentBasis( unsigned columnIndex,
       step we performed in the eta file
     */
     _etas.append( sparseEtaMatrix );
+    _etaNnz += sparseEtaMatrix->_sparseColumn.size();
 
     /*
       Step 6:
@@ -319,6 +344,11 @@ void SparseFTFactorization::forwardTransformation( const double *y, double *x )
         B = FHV
     */
 
+    struct timespec start = { 0, 0 };
+    if ( GlobalConfiguration::USE_ADAPTIVE_REFACTORIZATION &&
+         GlobalConfiguration::ADAPTIVE_REFACTORIZATION_USE_MEASURED_TIME )
+        start = TimeUtils::sampleMicro();
+
     // Eliminate F
     _sparseLUFactors.fForwardTransformation( y, _z1 );
 
@@ -327,6 +357,9 @@ void SparseFTFactorization::forwardTransformation( const double *y, double *x )
 
     // Eliminate V
     _sparseLUFactors.vForwardTransformation( _z2, x );
+
+    if ( GlobalConfiguration::USE_ADAPTIVE_REFACTORIZATION )
+        recordTransformationCost( start );
 }
 
 void SparseFTFactorization::backwardTransformation( const double *y, double *x ) const
@@ -337,6 +370,11 @@ void SparseFTFactorization::backwardTransformation( const double *y, double *x )
         B = FHV
     */
 
+    struct timespec start = { 0, 0 };
+    if ( GlobalConfiguration::USE_ADAPTIVE_REFACTORIZATION &&
+         GlobalConfiguration::ADAPTIVE_REFACTORIZATION_USE_MEASURED_TIME )
+        start = TimeUtils::sampleMicro();
+
     // Eliminate V
     _sparseLUFactors.vBackwardTransformation( y, _z1 );
 
@@ -345,6 +383,9 @@ void SparseFTFactorization::backwardTransformation( const double *y, double *x )
 
     // Eliminate F
     _sparseLUFactors.fBackwardTransformation( _z2, x );
+
+    if ( GlobalConfiguration::USE_ADAPTIVE_REFACTORIZATION )
+        recordTransformationCost( start );
 }
 
 void SparseFTFactorization::clearFactorization()
@@ -354,12 +395,20 @@ void SparseFTFactorization::clearFactorization()
         delete *it;
 
     _etas.clear();
+
+    _numUpdatesSinceRefactorization = 0;
+    _etaNnz = 0;
+    _numTransformationsSinceRefactorization = 0;
+    _transformationCostSinceRefactorization = 0;
+    _averageTransformationCost = 0;
 }
 
 void SparseFTFactorization::factorizeBasis()
 {
     clearFactorization();
 
+    struct timespec start = TimeUtils::sampleMicro();
+
     try
     {
         _sparseGaussianEliminator.run( &_B, &_sparseLUFactors );
@@ -372,8 +421,85 @@ void SparseFTFactorization::factorizeBasis()
             throw e;
     }
 
+    double refactorizationTime =
+        TimeUtils::fractionalMicroPassed( start, TimeUtils::sampleMicro() );
+
+    if ( GlobalConfiguration::ADAPTIVE_REFACTORIZATION_USE_MEASURED_TIME )
+        _refactorizationCost = refactorizationTime;
+    else
+    {
+        unsigned basisNnz = 0;
+        for ( unsigned i = 0; i < _m; ++i )
+            basisNnz += _B._columns[i].getNnz();
+
+        _refactorizationCost = basisNnz + getTransformationNnz();
+    }
+
     if ( _statistics )
+    {
         _statistics->incLongAttribute( Statistics::NUM_BASIS_REFACTORIZATIONS );
+        _statistics->incLongAttribute( Statistics::TOTAL_TIME_BASIS_REFACTORIZATION_MICRO,
+                                       (unsigned long long)refactorizationTime );
+    }
+}
+
+bool SparseFTFactorization::shouldRefactorize() const
+{
+    if ( !GlobalConfiguration::USE_ADAPTIVE_REFACTORIZATION )
+        return _etas.size() > GlobalConfiguration::REFACTORIZATION_THRESHOLD;
+
+    if ( _numUpdatesSinceRefactorization <
+         GlobalConfiguration::ADAPTIVE_REFACTORIZATION_MIN_INTERVAL )
+        return false;
+
+    if ( _numUpdatesSinceRefactorization >=
+         GlobalConfiguration::ADAPTIVE_REFACTORIZATION_MAX_INTERVAL )
+        return true;
+
+    // The eta file has become much denser than the factors themselves
+    unsigned factorsNnz = getTransformationNnz() - _etaNnz;
+    if ( _etaNnz > GlobalConfiguration::ADAPTIVE_REFACTORIZATION_MAX_ETA_FILL_RATIO * factorsNnz )
+        return true;
+
+    if ( _numTransformationsSinceRefactorization == 0 )
+        return false;
+
+    /*
+      Continuing with the current factorization costs (roughly) the current
+      transformation cost for each of the upcoming transformations, whereas
+      refactorizing costs the refactorization once, after which the
+      transformations are cheap again. The break-even point is reached once
+      the current transformation cost exceeds the average transformation
+      cost, with the refactorization amortized over the transformations
+      performed so far:
+
+        avg * n > refactorization + sum of transformation costs
+    */
+    return _averageTransformationCost * _numTransformationsSinceRefactorization >
+           _refactorizationCost + _transformationCostSinceRefactorization;
+}
+
+void SparseFTFactorization::recordTransformationCost( const struct timespec &start ) const
+{
+    double cost = GlobalConfiguration::ADAPTIVE_REFACTORIZATION_USE_MEASURED_TIME
+                    ? TimeUtils::fractionalMicroPassed( start, TimeUtils::sampleMicro() )
+                    : getTransformationNnz();
+
+    if ( _numTransformationsSinceRefactorization == 0 )
+        _averageTransformationCost = cost;
+    else
+        _averageTransformationCost =
+            GlobalConfiguration::ADAPTIVE_REFACTORIZATION_SMOOTHING_FACTOR * cost +
+            ( 1 - GlobalConfiguration::ADAPTIVE_REFACTORIZATION_SMOOTHING_FACTOR ) *
+                _averageTransformationCost;
+
+    ++_numTransformationsSinceRefactorization;
+    _transformationCostSinceRefactorization += cost;
+}
+
+unsigned SparseFTFactorization::getTransformationNnz() const
+{
+    return _sparseLUFactors._F->getNnz() + _sparseLUFactors._V->getNnz() + _etaNnz;
 }
 
 void SparseFTFactorization::storeFactorization( IBasisFactorization *other )
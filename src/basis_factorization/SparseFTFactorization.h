@@ -137,6 +137,21 @@ private:
     */
     Statistics *_statistics;
 
+    /*
+      Bookkeeping for the adaptive refactorization: the number of basis
+      updates and the number of non-zeros accumulated in the eta file since
+      the last refactorization, the cost of that refactorization, and the
+      cost of the forward/backward transformations performed since. Costs
+      are either non-zero counts or microseconds, depending on
+      GlobalConfiguration::ADAPTIVE_REFACTORIZATION_USE_MEASURED_TIME.
+    */
+    unsigned _numUpdatesSinceRefactorization;
+    unsigned _etaNnz;
+    double _refactorizationCost;
+    mutable unsigned _numTransformationsSinceRefactorization;
+    mutable double _transformationCostSinceRefactorization;
+    mutable double _averageTransformationCost;
+
     /*
       Work memory.
     */
@@ -177,6 +192,28 @@ private:
     */
     void clearFactorization();
 
+    /*
+      Decide whether the basis should be refactorized before applying the
+      next update. When adaptive refactorization is enabled, this happens once
+      the projected cost of continuing with the current eta file exceeds the
+      cost of refactorizing, i.e. once the transformations have become more
+      expensive than their average cost, amortized over the last
+      refactorization.
+    */
+    bool shouldRefactorize() const;
+
+    /*
+      Record the cost of a forward or backward transformation that started at
+      the given time.
+    */
+    void recordTransformationCost( const struct timespec &start ) const;
+
+    /*
+      The number of non-zeros in the LU factors and in the eta file, i.e. the
+      deterministic cost of a single transformation.
+    */
+    unsigned getTransformationNnz() const;
+
     /*
       Have the Basis Factoriaztion object start reporting statistics.
     */
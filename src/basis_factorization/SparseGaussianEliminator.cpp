@@ -166,7 +166,7 @@ void SparseGaussianEliminator::run( const SparseColumnsOfBasis *A,
     //             for ( unsigned j = 0; j < _m; ++j )
     //             {
     //                 ASSERT( FloatUtils::areEqual( product[i*_m+j],
-    //                                               A->_columns[j]->get( i ) ) );
+    //                                               A->_columns[j].get( i ) ) );
     //             }
 
     //         delete[] product;
@@ -0,0 +1,110 @@
+/*********************                                                        */
+/*! \file SparseSpan.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#ifndef __SparseSpan_h__
+#define __SparseSpan_h__
+
+#include "SparseUnsortedArray.h"
+
+#include <algorithm>
+
+/*
+  A read-only, non-owning view of a contiguous range of sparse
+  entries, e.g. a single row or column of a SparseConstraintMatrix.
+  The entries are unsorted. A span is invalidated by any operation
+  that modifies the underlying storage.
+*/
+class SparseSpan
+{
+public:
+    typedef SparseUnsortedArray::Entry Entry;
+
+    SparseSpan()
+        : _begin( NULL )
+        , _end( NULL )
+    {
+    }
+
+    SparseSpan( const Entry *begin, const Entry *end )
+        : _begin( begin )
+        , _end( end )
+    {
+    }
+
+    explicit SparseSpan( const SparseUnsortedArray &array )
+        : _begin( array.getArray() )
+        , _end( array.getArray() + array.getNnz() )
+    {
+    }
+
+    const Entry *begin() const
+    {
+        return _begin;
+    }
+
+    const Entry *end() const
+    {
+        return _end;
+    }
+
+    unsigned getNnz() const
+    {
+        return _end - _begin;
+    }
+
+    bool empty() const
+    {
+        return _begin == _end;
+    }
+
+    /*
+      Retrieve an element by its (row or column) index. This is a
+      linear scan.
+    */
+    double get( unsigned index ) const
+    {
+        for ( const Entry *it = _begin; it != _end; ++it )
+        {
+            if ( it->_index == index )
+                return it->_value;
+        }
+
+        return 0;
+    }
+
+    /*
+      Scatter the span into a dense vector of the given size
+    */
+    void toDense( double *result, unsigned size ) const
+    {
+        std::fill_n( result, size, 0 );
+        for ( const Entry *it = _begin; it != _end; ++it )
+            result[it->_index] = it->_value;
+    }
+
+private:
+    const Entry *_begin;
+    const Entry *_end;
+};
+
+#endif // __SparseSpan_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
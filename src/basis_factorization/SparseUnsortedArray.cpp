@@ -18,6 +18,7 @@
 #include "BasisFactorizationError.h"
 #include "Debug.h"
 #include "FloatUtils.h"
+#include "SparseSpan.h"
 #include "SparseUnsortedList.h"
 
 SparseUnsortedArray::SparseUnsortedArray()
@@ -100,6 +101,20 @@ void SparseUnsortedArray::initializeFromList( const SparseUnsortedList *list )
     }
 }
 
+void SparseUnsortedArray::initializeFromSpan( const SparseSpan &span, unsigned size )
+{
+    freeMemoryIfNeeded();
+
+    _maxSize = size;
+
+    _allocatedSize = span.getNnz();
+    _array = new Entry[_allocatedSize];
+    _nnz = _allocatedSize;
+
+    if ( _nnz > 0 )
+        memcpy( _array, span.begin(), sizeof( Entry ) * _nnz );
+}
+
 void SparseUnsortedArray::clear()
 {
     _nnz = 0;
@@ -18,6 +18,7 @@
 
 #include "HashMap.h"
 
+class SparseSpan;
 class SparseUnsortedList;
 
 class SparseUnsortedArray
@@ -52,6 +53,7 @@ public:
     void initialize( const double *V, unsigned size );
     void initializeToEmpty();
     void initializeFromList( const SparseUnsortedList *list );
+    void initializeFromSpan( const SparseSpan &span, unsigned size );
 
     /*
       Remove the elements, without changing the allocated memory
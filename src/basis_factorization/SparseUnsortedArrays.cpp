@@ -120,6 +120,29 @@ void SparseUnsortedArrays::initialize( const SparseUnsortedList **V, unsigned m,
     }
 }
 
+void SparseUnsortedArrays::initialize( const SparseSpan *V, unsigned m, unsigned n )
+{
+    freeMemoryIfNeeded();
+
+    _m = m;
+    _n = n;
+
+    _rows = new SparseUnsortedArray *[_m];
+    if ( !_rows )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseUnsortedArrays::rows" );
+
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        _rows[i] = new SparseUnsortedArray;
+        if ( !_rows[i] )
+            throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                           "SparseUnsortedArrays::rows[i]" );
+
+        _rows[i]->initializeFromSpan( V[i], _n );
+    }
+}
+
 void SparseUnsortedArrays::initializeToEmpty( unsigned m, unsigned n )
 {
     freeMemoryIfNeeded();
@@ -17,6 +17,7 @@
 #define __SparseUnsortedArrays_h__
 
 #include "HashMap.h"
+#include "SparseSpan.h"
 #include "SparseUnsortedArray.h"
 #include "SparseUnsortedList.h"
 
@@ -33,6 +34,7 @@ public:
     void initialize( const double *M, unsigned m, unsigned n );
     void initialize( const SparseUnsortedArray **V, unsigned m, unsigned n );
     void initialize( const SparseUnsortedList **V, unsigned m, unsigned n );
+    void initialize( const SparseSpan *V, unsigned m, unsigned n );
 
     /*
       Update a single row from a dense vector
@@ -19,34 +19,138 @@
 #include "Debug.h"
 #include "FloatUtils.h"
 
+#include <cstring>
+
 SparseUnsortedList::SparseUnsortedList()
     : _size( 0 )
+    , _entries( _inlineEntries )
+    , _nnz( 0 )
+    , _capacity( INLINE_CAPACITY )
 {
 }
 
 SparseUnsortedList::SparseUnsortedList( unsigned size )
     : _size( size )
+    , _entries( _inlineEntries )
+    , _nnz( 0 )
+    , _capacity( INLINE_CAPACITY )
 {
 }
 
 SparseUnsortedList::SparseUnsortedList( const SparseUnsortedList &other )
+    : _size( other._size )
+    , _entries( _inlineEntries )
+    , _nnz( 0 )
+    , _capacity( INLINE_CAPACITY )
 {
-    *this = other;
+    copyEntriesFrom( other );
+}
+
+SparseUnsortedList::SparseUnsortedList( SparseUnsortedList &&other ) noexcept
+    : _size( other._size )
+    , _entries( _inlineEntries )
+    , _nnz( 0 )
+    , _capacity( INLINE_CAPACITY )
+{
+    moveEntriesFrom( other );
 }
 
 SparseUnsortedList::SparseUnsortedList( const double *V, unsigned size )
+    : _size( 0 )
+    , _entries( _inlineEntries )
+    , _nnz( 0 )
+    , _capacity( INLINE_CAPACITY )
 {
     initialize( V, size );
 }
 
 SparseUnsortedList::~SparseUnsortedList()
 {
+    freeMemoryIfNeeded();
+}
+
+bool SparseUnsortedList::isInline() const
+{
+    return _entries == _inlineEntries;
+}
+
+void SparseUnsortedList::freeMemoryIfNeeded()
+{
+    if ( !isInline() )
+    {
+        delete[] _entries;
+        _entries = _inlineEntries;
+        _capacity = INLINE_CAPACITY;
+    }
+}
+
+void SparseUnsortedList::reserve( unsigned capacity )
+{
+    if ( capacity <= _capacity )
+        return;
+
+    // Grow geometrically, so that appends are amortized O(1)
+    unsigned newCapacity = std::max( capacity, 2 * _capacity );
+
+    Entry *newEntries = new Entry[newCapacity];
+    if ( !newEntries )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseUnsortedList::newEntries" );
+
+    if ( _nnz > 0 )
+        memcpy( newEntries, _entries, sizeof( Entry ) * _nnz );
+
+    freeMemoryIfNeeded();
+    _entries = newEntries;
+    _capacity = newCapacity;
+}
+
+void SparseUnsortedList::copyEntriesFrom( const SparseUnsortedList &other )
+{
+    _nnz = 0;
+    reserve( other._nnz );
+
+    if ( other._nnz > 0 )
+        memcpy( _entries, other._entries, sizeof( Entry ) * other._nnz );
+    _nnz = other._nnz;
+}
+
+void SparseUnsortedList::moveEntriesFrom( SparseUnsortedList &other )
+{
+    freeMemoryIfNeeded();
+
+    if ( other.isInline() )
+    {
+        if ( other._nnz > 0 )
+            memcpy( _inlineEntries, other._inlineEntries, sizeof( Entry ) * other._nnz );
+    }
+    else
+    {
+        // Steal the heap array
+        _entries = other._entries;
+        _capacity = other._capacity;
+
+        other._entries = other._inlineEntries;
+        other._capacity = INLINE_CAPACITY;
+    }
+
+    _nnz = other._nnz;
+    other._nnz = 0;
 }
 
 void SparseUnsortedList::initialize( const double *V, unsigned size )
 {
     _size = size;
-    _list.clear();
+    _nnz = 0;
+
+    unsigned nnz = 0;
+    for ( unsigned i = 0; i < _size; ++i )
+    {
+        if ( !FloatUtils::isZero( V[i] ) )
+            ++nnz;
+    }
+
+    reserve( nnz );
 
     for ( unsigned i = 0; i < _size; ++i )
     {
@@ -54,34 +158,25 @@ void SparseUnsortedList::initialize( const double *V, unsigned size )
         if ( FloatUtils::isZero( V[i] ) )
             continue;
 
-        _list.append( Entry( i, V[i] ) );
+        _entries[_nnz] = Entry( i, V[i] );
+        ++_nnz;
     }
 }
 
 void SparseUnsortedList::initializeToEmpty()
 {
     _size = 0;
-    _list.clear();
+    _nnz = 0;
 }
 
 void SparseUnsortedList::clear()
 {
-    _list.clear();
-}
-
-unsigned SparseUnsortedList::getNnz() const
-{
-    return _list.size();
-}
-
-bool SparseUnsortedList::empty() const
-{
-    return _list.empty();
+    _nnz = 0;
 }
 
 double SparseUnsortedList::get( unsigned entry ) const
 {
-    for ( const auto &listEntry : _list )
+    for ( const auto &listEntry : *this )
     {
         if ( listEntry._index == entry )
             return listEntry._value;
@@ -92,8 +187,8 @@ double SparseUnsortedList::get( unsigned entry ) const
 
 void SparseUnsortedList::dump() const
 {
-    printf( "\nDumping sparse unsortedList: (nnz = %u)\n", _list.size() );
-    for ( const auto &entry : _list )
+    printf( "\nDumping sparse unsortedList: (nnz = %u)\n", _nnz );
+    for ( const auto &entry : *this )
         printf( "\tEntry %u: %6.2lf\n", entry._index, entry._value );
     printf( "\n" );
 }
@@ -113,42 +208,35 @@ void SparseUnsortedList::toDense( double *result ) const
 {
     std::fill_n( result, _size, 0 );
 
-    for ( const auto &entry : _list )
+    for ( const auto &entry : *this )
         result[entry._index] = entry._value;
 }
 
 SparseUnsortedList &SparseUnsortedList::operator=( const SparseUnsortedList &other )
 {
-    _size = other._size;
-    _list = other._list;
+    if ( this != &other )
+    {
+        _size = other._size;
+        copyEntriesFrom( other );
+    }
 
     return *this;
 }
 
-void SparseUnsortedList::storeIntoOther( SparseUnsortedList *other ) const
-{
-    other->_size = _size;
-    other->_list = _list;
-}
-
-List<SparseUnsortedList::Entry>::const_iterator SparseUnsortedList::begin() const
-{
-    return _list.begin();
-}
-
-List<SparseUnsortedList::Entry>::const_iterator SparseUnsortedList::end() const
+SparseUnsortedList &SparseUnsortedList::operator=( SparseUnsortedList &&other ) noexcept
 {
-    return _list.end();
-}
+    if ( this != &other )
+    {
+        _size = other._size;
+        moveEntriesFrom( other );
+    }
 
-List<SparseUnsortedList::Entry>::iterator SparseUnsortedList::begin()
-{
-    return _list.begin();
+    return *this;
 }
 
-List<SparseUnsortedList::Entry>::iterator SparseUnsortedList::end()
+void SparseUnsortedList::storeIntoOther( SparseUnsortedList *other ) const
 {
-    return _list.end();
+    *other = *this;
 }
 
 void SparseUnsortedList::set( unsigned index, double value )
@@ -160,7 +248,7 @@ void SparseUnsortedList::set( unsigned index, double value )
         if ( it->_index == index )
         {
             if ( isZero )
-                _list.erase( it );
+                erase( it );
             else
                 it->_value = value;
 
@@ -169,18 +257,22 @@ void SparseUnsortedList::set( unsigned index, double value )
     }
 
     if ( !isZero )
-        _list.append( Entry( index, value ) );
+        append( index, value );
 }
 
 void SparseUnsortedList::append( unsigned index, double value )
 {
-    _list.append( Entry( index, value ) );
+    if ( _nnz == _capacity )
+        reserve( _nnz + 1 );
+
+    _entries[_nnz] = Entry( index, value );
+    ++_nnz;
 }
 
 void SparseUnsortedList::addLastEntry( double entry )
 {
     if ( !FloatUtils::isZero( entry ) )
-        _list.append( Entry( _size, entry ) );
+        append( _size, entry );
 
     ++_size;
 }
@@ -192,50 +284,59 @@ void SparseUnsortedList::incrementSize()
 
 void SparseUnsortedList::mergeEntries( unsigned source, unsigned target )
 {
-    List<Entry>::iterator sourceIt = _list.end();
-    List<Entry>::iterator targetIt = _list.end();
-    List<Entry>::iterator it;
+    unsigned sourcePosition = _nnz;
+    unsigned targetPosition = _nnz;
 
-    for ( it = _list.begin(); it != _list.end(); ++it )
+    for ( unsigned i = 0; i < _nnz; ++i )
     {
-        if ( it->_index == source )
+        if ( _entries[i]._index == source )
         {
-            sourceIt = it;
-            if ( targetIt != _list.end() )
+            sourcePosition = i;
+            if ( targetPosition != _nnz )
                 break;
         }
 
-        if ( it->_index == target )
+        if ( _entries[i]._index == target )
         {
-            targetIt = it;
-            if ( sourceIt != _list.end() )
+            targetPosition = i;
+            if ( sourcePosition != _nnz )
                 break;
         }
     }
 
     // If no source entry exists, we are done
-    if ( sourceIt == _list.end() )
+    if ( sourcePosition == _nnz )
         return;
 
     // If no target entry, simply change index on source entry
-    if ( targetIt == _list.end() )
+    if ( targetPosition == _nnz )
     {
-        sourceIt->_index = target;
+        _entries[sourcePosition]._index = target;
         return;
     }
 
     // Both source and target entries
-    targetIt->_value += sourceIt->_value;
+    _entries[targetPosition]._value += _entries[sourcePosition]._value;
+
+    erase( _entries + sourcePosition );
+    if ( targetPosition > sourcePosition )
+        --targetPosition;
 
-    _list.erase( sourceIt );
-    if ( FloatUtils::isZero( targetIt->_value ) )
-        _list.erase( targetIt );
+    if ( FloatUtils::isZero( _entries[targetPosition]._value ) )
+        erase( _entries + targetPosition );
 }
 
-List<SparseUnsortedList::Entry>::iterator
-SparseUnsortedList::erase( List<SparseUnsortedList::Entry>::iterator it )
+SparseUnsortedList::iterator SparseUnsortedList::erase( iterator it )
 {
-    return _list.erase( it );
+    ASSERT( it >= begin() && it < end() );
+
+    unsigned position = it - _entries;
+    unsigned following = _nnz - position - 1;
+    if ( following > 0 )
+        memmove( it, it + 1, sizeof( Entry ) * following );
+
+    --_nnz;
+    return it;
 }
 
 unsigned SparseUnsortedList::getSize() const
@@ -19,11 +19,23 @@
 #include "HashMap.h"
 #include "SparseMatrix.h"
 
+/*
+  A sparse vector, stored as an unsorted array of (index, value)
+  entries. Short vectors are stored inline, without any heap
+  allocation; longer ones are moved to a heap array whose capacity
+  grows geometrically.
+*/
 class SparseUnsortedList
 {
 public:
     struct Entry
     {
+        Entry()
+            : _index( 0 )
+            , _value( 0 )
+        {
+        }
+
         Entry( unsigned index, double value )
             : _index( index )
             , _value( value )
@@ -34,6 +46,9 @@ public:
         double _value;
     };
 
+    typedef Entry *iterator;
+    typedef const Entry *const_iterator;
+
     /*
       Initialization: the size determines the dimension of the
       underlying storage.
@@ -45,6 +60,7 @@ public:
     ~SparseUnsortedList();
     SparseUnsortedList( unsigned size );
     SparseUnsortedList( const SparseUnsortedList &other );
+    SparseUnsortedList( SparseUnsortedList &&other ) noexcept;
     SparseUnsortedList( const double *V, unsigned size );
     void initialize( const double *V, unsigned size );
     void initializeToEmpty();
@@ -66,8 +82,15 @@ public:
     /*
       The number of non-zero elements in the unsortedList
     */
-    unsigned getNnz() const;
-    bool empty() const;
+    unsigned getNnz() const
+    {
+        return _nnz;
+    }
+
+    bool empty() const
+    {
+        return _nnz == 0;
+    }
 
     /*
       Retrieve an element
@@ -89,20 +112,40 @@ public:
       Cloning
     */
     SparseUnsortedList &operator=( const SparseUnsortedList &other );
+    SparseUnsortedList &operator=( SparseUnsortedList &&other ) noexcept;
     void storeIntoOther( SparseUnsortedList *other ) const;
 
     /*
-      Retrieve entries
+      Retrieve entries. Iterators are invalidated by any operation
+      that adds or removes entries. These are on the hot path of row
+      bound computations, so they are defined inline.
     */
-    List<Entry>::const_iterator begin() const;
-    List<Entry>::const_iterator end() const;
-    List<Entry>::iterator begin();
-    List<Entry>::iterator end();
+    const_iterator begin() const
+    {
+        return _entries;
+    }
+
+    const_iterator end() const
+    {
+        return _entries + _nnz;
+    }
+
+    iterator begin()
+    {
+        return _entries;
+    }
+
+    iterator end()
+    {
+        return _entries + _nnz;
+    }
 
     /*
-      Erasing an element by iterator
+      Erasing an element by iterator. The order of the remaining
+      entries is preserved, and the returned iterator points to the
+      entry that followed the erased one.
     */
-    List<Entry>::iterator erase( List<Entry>::iterator it );
+    iterator erase( iterator it );
 
     /*
       Addes the coefficient for entry 'source' to entry 'target'
@@ -122,8 +165,26 @@ public:
     void dumpDense() const;
 
 private:
+    enum {
+        // The number of entries stored without a heap allocation
+        INLINE_CAPACITY = 4,
+    };
+
     unsigned _size;
-    List<Entry> _list;
+
+    /*
+      The entries, stored either in _inlineEntries or on the heap
+    */
+    Entry *_entries;
+    unsigned _nnz;
+    unsigned _capacity;
+    Entry _inlineEntries[INLINE_CAPACITY];
+
+    bool isInline() const;
+    void freeMemoryIfNeeded();
+    void reserve( unsigned capacity );
+    void copyEntriesFrom( const SparseUnsortedList &other );
+    void moveEntriesFrom( SparseUnsortedList &other );
 };
 
 #endif // __SparseUnsortedList_h__
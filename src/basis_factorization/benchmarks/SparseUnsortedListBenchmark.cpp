@@ -0,0 +1,196 @@
+/*********************                                                        */
+/*! \file SparseUnsortedListBenchmark.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Micro-benchmark for SparseUnsortedList, comparing it against the
+ ** std::list based storage that it replaced. Each container is used the
+ ** way the bound explainer uses explanation rows: rows are built by
+ ** appending entries, copied (as context-dependent objects are saved), and
+ ** bounds are computed by a pass over their entries.
+
+**/
+
+#include "FloatUtils.h"
+#include "SparseUnsortedList.h"
+#include "TimeUtils.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+
+/*
+  The previous implementation of SparseUnsortedList, reduced to the
+  operations that are benchmarked
+*/
+class ListSparseUnsortedList
+{
+public:
+    void append( unsigned index, double value )
+    {
+        _list.push_back( SparseUnsortedList::Entry( index, value ) );
+    }
+
+    std::list<SparseUnsortedList::Entry>::const_iterator begin() const
+    {
+        return _list.begin();
+    }
+
+    std::list<SparseUnsortedList::Entry>::const_iterator end() const
+    {
+        return _list.end();
+    }
+
+private:
+    std::list<SparseUnsortedList::Entry> _list;
+};
+
+enum {
+    NUMBER_OF_VARIABLES = 2000,
+    NUMBER_OF_ROWS = 500,
+    NUMBER_OF_ITERATIONS = 200,
+};
+
+/*
+  The bound imposed by a row on its first variable, computed as in
+  BoundManager::computeSparseRowBound
+*/
+template <class Row>
+static double computeRowBound( const Row &row,
+                               bool isUpper,
+                               const double *lowerBounds,
+                               const double *upperBounds )
+{
+    unsigned var = row.begin()->_index;
+    double ci = row.begin()->_value;
+
+    double bound = 0;
+    for ( const auto &entry : row )
+    {
+        if ( FloatUtils::isZero( entry._value ) || entry._index == var )
+            continue;
+
+        double realCoefficient = entry._value / -ci;
+        if ( FloatUtils::isZero( realCoefficient ) )
+            continue;
+
+        bool useUpper = ( isUpper && realCoefficient > 0 ) || ( !isUpper && realCoefficient < 0 );
+        double multiplier = useUpper ? upperBounds[entry._index] : lowerBounds[entry._index];
+        multiplier = FloatUtils::isZero( multiplier ) ? 0 : multiplier * realCoefficient;
+        bound += FloatUtils::isZero( multiplier ) ? 0 : multiplier;
+    }
+
+    return bound;
+}
+
+struct Result
+{
+    unsigned long long _buildMicro;
+    unsigned long long _boundMicro;
+    double _checksum;
+};
+
+template <class Row>
+static Result runBenchmark( unsigned rowLength,
+                            const unsigned *starts,
+                            const double *values,
+                            const double *lowerBounds,
+                            const double *upperBounds )
+{
+    Result result;
+
+    // Build the rows, and copy them as the explainer does when saving
+    struct timespec start = TimeUtils::sampleMicro();
+    Row *rows = new Row[NUMBER_OF_ROWS];
+    Row *copies = new Row[NUMBER_OF_ROWS];
+    for ( unsigned i = 0; i < NUMBER_OF_ROWS; ++i )
+    {
+        for ( unsigned j = 0; j < rowLength; ++j )
+            rows[i].append( starts[i] + j, values[i * rowLength + j] );
+        copies[i] = rows[i];
+    }
+    result._buildMicro = TimeUtils::timePassed( start, TimeUtils::sampleMicro() );
+
+    result._checksum = 0;
+    start = TimeUtils::sampleMicro();
+    for ( unsigned iteration = 0; iteration < NUMBER_OF_ITERATIONS; ++iteration )
+        for ( unsigned i = 0; i < NUMBER_OF_ROWS; ++i )
+            result._checksum +=
+                computeRowBound( copies[i], iteration % 2, lowerBounds, upperBounds );
+    result._boundMicro = TimeUtils::timePassed( start, TimeUtils::sampleMicro() );
+
+    delete[] rows;
+    delete[] copies;
+
+    return result;
+}
+
+static bool checksumsMatch( double x, double y )
+{
+    double scale = std::max( 1.0, std::max( FloatUtils::abs( x ), FloatUtils::abs( y ) ) );
+    return FloatUtils::abs( x - y ) <= 0.000000001 * scale;
+}
+
+int main()
+{
+    srand( 2024 );
+
+    double *lowerBounds = new double[NUMBER_OF_VARIABLES];
+    double *upperBounds = new double[NUMBER_OF_VARIABLES];
+    for ( unsigned i = 0; i < NUMBER_OF_VARIABLES; ++i )
+    {
+        lowerBounds[i] = -( rand() % 100 ) / 10.0;
+        upperBounds[i] = lowerBounds[i] + ( rand() % 100 ) / 10.0;
+    }
+
+    bool success = true;
+    unsigned rowLengths[] = { 2, 4, 8, 32, 256 };
+    for ( unsigned rowLength : rowLengths )
+    {
+        unsigned *starts = new unsigned[NUMBER_OF_ROWS];
+        double *values = new double[NUMBER_OF_ROWS * rowLength];
+        for ( unsigned i = 0; i < NUMBER_OF_ROWS; ++i )
+        {
+            starts[i] = rand() % ( NUMBER_OF_VARIABLES - rowLength );
+            for ( unsigned j = 0; j < rowLength; ++j )
+            {
+                double value = ( ( rand() % 200 ) - 100 ) / 10.0;
+                values[i * rowLength + j] = ( j == 0 && FloatUtils::isZero( value ) ) ? 1 : value;
+            }
+        }
+
+        Result before = runBenchmark<ListSparseUnsortedList>(
+            rowLength, starts, values, lowerBounds, upperBounds );
+        Result after = runBenchmark<SparseUnsortedList>(
+            rowLength, starts, values, lowerBounds, upperBounds );
+
+        printf( "%3u entries per row: build and copy %8llu us -> %8llu us, "
+                "row bounds %8llu us -> %8llu us\n",
+                rowLength,
+                before._buildMicro,
+                after._buildMicro,
+                before._boundMicro,
+                after._boundMicro );
+
+        if ( !checksumsMatch( before._checksum, after._checksum ) )
+        {
+            printf( "\tChecksum mismatch: %.10lf vs %.10lf\n", before._checksum, after._checksum );
+            success = false;
+        }
+
+        delete[] starts;
+        delete[] values;
+    }
+
+    delete[] lowerBounds;
+    delete[] upperBounds;
+
+    return success ? 0 : 1;
+}
@@ -18,6 +18,7 @@
 
 #include "IBasisFactorization.h"
 #include "SparseColumnsOfBasis.h"
+#include "SparseUnsortedArray.h"
 #include "SparseUnsortedList.h"
 
 class MockColumnOracle : public IBasisFactorization::BasisColumnOracle
@@ -25,6 +26,7 @@ class MockColumnOracle : public IBasisFactorization::BasisColumnOracle
 public:
     MockColumnOracle()
         : _basis( NULL )
+        , _sparseColumns( NULL )
         , _sparseBasis( NULL )
     {
     }
@@ -37,17 +39,14 @@ public:
             _basis = NULL;
         }
 
-        if ( _sparseBasis )
+        if ( _sparseColumns )
         {
-            for ( unsigned i = 0; i < _m; ++i )
-            {
-                if ( _sparseBasis->_columns[i] )
-                {
-                    delete _sparseBasis->_columns[i];
-                    _sparseBasis->_columns[i] = NULL;
-                }
-            }
+            delete[] _sparseColumns;
+            _sparseColumns = NULL;
+        }
 
+        if ( _sparseBasis )
+        {
             delete _sparseBasis;
             _sparseBasis = NULL;
         }
@@ -65,6 +64,7 @@ public:
         freeMemoryIfNeeded();
         _m = m;
         _basis = new double[_m * _m];
+        _sparseColumns = new SparseUnsortedArray[_m];
         _sparseBasis = new SparseColumnsOfBasis( _m );
 
         for ( unsigned row = 0; row < _m; ++row )
@@ -76,7 +76,10 @@ public:
         }
 
         for ( unsigned i = 0; i < _m; ++i )
-            _sparseBasis->_columns[i] = new SparseUnsortedList( _basis + ( i * _m ), _m );
+        {
+            _sparseColumns[i].initialize( _basis + ( i * _m ), _m );
+            _sparseBasis->_columns[i] = SparseSpan( _sparseColumns[i] );
+        }
     }
 
     double *_basis;
@@ -91,15 +94,12 @@ public:
         result->initialize( _basis + ( _m * column ), _m );
     }
 
+    SparseUnsortedArray *_sparseColumns;
     SparseColumnsOfBasis *_sparseBasis;
     void getSparseBasis( SparseColumnsOfBasis &basis ) const
     {
         for ( unsigned i = 0; i < _m; ++i )
-        {
             basis._columns[i] = _sparseBasis->_columns[i];
-            if ( !basis._columns[i] )
-                TS_ASSERT( 0 );
-        }
     }
 };
 
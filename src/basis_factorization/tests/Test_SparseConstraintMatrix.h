@@ -0,0 +1,318 @@
+/*********************                                                        */
+/*! \file Test_SparseConstraintMatrix.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "CSRMatrix.h"
+#include "MString.h"
+#include "SparseConstraintMatrix.h"
+#include "SparseUnsortedList.h"
+
+#include <cxxtest/TestSuite.h>
+
+class MockForSparseConstraintMatrix
+{
+public:
+};
+
+class SparseConstraintMatrixTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockForSparseConstraintMatrix *mock;
+
+    void setUp()
+    {
+        TS_ASSERT( mock = new MockForSparseConstraintMatrix );
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete mock );
+    }
+
+    void checkAgainstDense( const SparseConstraintMatrix &matrix,
+                            const double *M,
+                            unsigned m,
+                            unsigned n )
+    {
+        TS_ASSERT_EQUALS( matrix.getM(), m );
+        TS_ASSERT_EQUALS( matrix.getN(), n );
+
+        unsigned nnz = 0;
+        for ( unsigned i = 0; i < m; ++i )
+        {
+            for ( unsigned j = 0; j < n; ++j )
+            {
+                TS_ASSERT_EQUALS( matrix.get( i, j ), M[i * n + j] );
+                if ( M[i * n + j] != 0 )
+                    ++nnz;
+            }
+        }
+
+        TS_ASSERT_EQUALS( matrix.getNnz(), nnz );
+
+        // The row and column views must agree with the dense matrix
+        for ( unsigned i = 0; i < m; ++i )
+        {
+            SparseSpan row = matrix.getRowSpan( i );
+            unsigned rowNnz = 0;
+            for ( unsigned j = 0; j < n; ++j )
+            {
+                TS_ASSERT_EQUALS( row.get( j ), M[i * n + j] );
+                if ( M[i * n + j] != 0 )
+                    ++rowNnz;
+            }
+            TS_ASSERT_EQUALS( row.getNnz(), rowNnz );
+        }
+
+        for ( unsigned j = 0; j < n; ++j )
+        {
+            SparseSpan column = matrix.getColumnSpan( j );
+            unsigned columnNnz = 0;
+            for ( unsigned i = 0; i < m; ++i )
+            {
+                TS_ASSERT_EQUALS( column.get( i ), M[i * n + j] );
+                if ( M[i * n + j] != 0 )
+                    ++columnNnz;
+            }
+            TS_ASSERT_EQUALS( column.getNnz(), columnNnz );
+        }
+    }
+
+    void test_sanity()
+    {
+        double M1[] = {
+            0, 0, 0, 0, //
+            5, 8, 0, 0, //
+            0, 0, 3, 0, //
+            0, 6, 0, 0, //
+        };
+
+        SparseConstraintMatrix matrix1;
+        matrix1.initialize( M1, 4, 4 );
+        checkAgainstDense( matrix1, M1, 4, 4 );
+
+        double M2[] = {
+            1, 2, 3, 4, //
+            5, 8, 5, 6, //
+            1, 2, 3, 4, //
+            5, 6, 7, 8, //
+            9, 1, 2, 3, //
+        };
+
+        SparseConstraintMatrix matrix2( M2, 5, 4 );
+        checkAgainstDense( matrix2, M2, 5, 4 );
+
+        double dense[20];
+        matrix2.toDense( dense );
+        for ( unsigned i = 0; i < 20; ++i )
+            TS_ASSERT_EQUALS( dense[i], M2[i] );
+    }
+
+    void test_get_row_and_column()
+    {
+        double M[] = {
+            1, 0, 0, 2, //
+            0, 3, 0, 0, //
+            4, 0, 5, 0, //
+        };
+
+        SparseConstraintMatrix matrix( M, 3, 4 );
+
+        double row[4];
+        matrix.getRowDense( 2, row );
+        TS_ASSERT_EQUALS( row[0], 4 );
+        TS_ASSERT_EQUALS( row[1], 0 );
+        TS_ASSERT_EQUALS( row[2], 5 );
+        TS_ASSERT_EQUALS( row[3], 0 );
+
+        double column[3];
+        matrix.getColumnDense( 0, column );
+        TS_ASSERT_EQUALS( column[0], 1 );
+        TS_ASSERT_EQUALS( column[1], 0 );
+        TS_ASSERT_EQUALS( column[2], 4 );
+
+        SparseUnsortedList list;
+        matrix.getRow( 0, &list );
+        TS_ASSERT_EQUALS( list.getNnz(), 2U );
+        TS_ASSERT_EQUALS( list.get( 0 ), 1 );
+        TS_ASSERT_EQUALS( list.get( 3 ), 2 );
+
+        matrix.getColumn( 2, &list );
+        TS_ASSERT_EQUALS( list.getNnz(), 1U );
+        TS_ASSERT_EQUALS( list.get( 2 ), 5 );
+    }
+
+    void test_add_last_row_and_column()
+    {
+        double M[] = {
+            1, 0, 2, //
+            0, 3, 0, //
+        };
+
+        SparseConstraintMatrix matrix( M, 2, 3 );
+
+        // Repeatedly add rows, forcing the column segments to grow
+        double rows[] = {
+            1, 2, 3, //
+            0, 0, 4, //
+            5, 0, 6, //
+            7, 8, 9, //
+            0, 1, 0, //
+            2, 2, 2, //
+        };
+
+        for ( unsigned i = 0; i < 6; ++i )
+            matrix.addLastRow( rows + 3 * i );
+
+        double expected[24];
+        memcpy( expected, M, sizeof( double ) * 6 );
+        memcpy( expected + 6, rows, sizeof( double ) * 18 );
+        checkAgainstDense( matrix, expected, 8, 3 );
+
+        // Add an empty column and then a non-empty one
+        matrix.addEmptyColumn();
+        double column[] = { 0, 1, 0, 0, 2, 0, 0, 3 };
+        matrix.addLastColumn( column );
+
+        double expected2[40];
+        for ( unsigned i = 0; i < 8; ++i )
+        {
+            for ( unsigned j = 0; j < 3; ++j )
+                expected2[i * 5 + j] = expected[i * 3 + j];
+            expected2[i * 5 + 3] = 0;
+            expected2[i * 5 + 4] = column[i];
+        }
+        checkAgainstDense( matrix, expected2, 8, 5 );
+
+        // The new empty column can be populated in place
+        matrix.set( 7, 3, 11 );
+        matrix.set( 0, 3, -1 );
+        expected2[7 * 5 + 3] = 11;
+        expected2[0 * 5 + 3] = -1;
+        checkAgainstDense( matrix, expected2, 8, 5 );
+
+        // Setting a zero removes the element
+        matrix.set( 0, 0, 0 );
+        expected2[0] = 0;
+        checkAgainstDense( matrix, expected2, 8, 5 );
+    }
+
+    void test_store_restore()
+    {
+        double M[] = {
+            1, 0, 2, //
+            0, 3, 0, //
+            4, 0, 0, //
+        };
+
+        SparseConstraintMatrix matrix( M, 3, 3 );
+        SparseConstraintMatrix other;
+
+        matrix.storeIntoOther( &other );
+        checkAgainstDense( other, M, 3, 3 );
+
+        // Changing the original does not affect the copy
+        double row[] = { 0, 0, 7 };
+        matrix.addLastRow( row );
+        checkAgainstDense( other, M, 3, 3 );
+
+        double expected[] = {
+            1, 0, 2, //
+            0, 3, 0, //
+            4, 0, 0, //
+            0, 0, 7, //
+        };
+        checkAgainstDense( matrix, expected, 4, 3 );
+
+        other.storeIntoOther( &matrix );
+        checkAgainstDense( matrix, M, 3, 3 );
+    }
+
+    void test_merge_columns()
+    {
+        double M[] = {
+            1, 0, 2, 0, //
+            0, 3, 0, 4, //
+            5, 0, -5, 0, //
+            0, 0, 6, 7, //
+        };
+
+        SparseConstraintMatrix matrix( M, 4, 4 );
+        matrix.mergeColumns( 0, 2 );
+
+        double expected[] = {
+            3, 0, 0, 0, //
+            0, 3, 0, 4, //
+            0, 0, 0, 0, //
+            6, 0, 0, 7, //
+        };
+        checkAgainstDense( matrix, expected, 4, 4 );
+
+        // Compare against the CSR implementation
+        CSRMatrix csr( M, 4, 4 );
+        csr.mergeColumns( 0, 2 );
+        for ( unsigned i = 0; i < 4; ++i )
+            for ( unsigned j = 0; j < 4; ++j )
+                TS_ASSERT_EQUALS( matrix.get( i, j ), csr.get( i, j ) );
+    }
+
+    void test_changes_count_and_transpose()
+    {
+        double M[] = {
+            1, 0, 2, //
+            0, 3, 0, //
+        };
+
+        SparseConstraintMatrix matrix( M, 2, 3 );
+        matrix.commitChange( 0, 0, 0 );
+        matrix.commitChange( 1, 2, 8 );
+        matrix.commitChange( 0, 1, 9 );
+
+        // Nothing changes until the changes are executed
+        checkAgainstDense( matrix, M, 2, 3 );
+        matrix.executeChanges();
+
+        double expected[] = {
+            0, 9, 2, //
+            0, 3, 8, //
+        };
+        checkAgainstDense( matrix, expected, 2, 3 );
+
+        unsigned rowCounts[2];
+        unsigned columnCounts[3];
+        matrix.countElements( rowCounts, columnCounts );
+        TS_ASSERT_EQUALS( rowCounts[0], 2U );
+        TS_ASSERT_EQUALS( rowCounts[1], 2U );
+        TS_ASSERT_EQUALS( columnCounts[0], 0U );
+        TS_ASSERT_EQUALS( columnCounts[1], 2U );
+        TS_ASSERT_EQUALS( columnCounts[2], 2U );
+
+        SparseConstraintMatrix transposed;
+        matrix.transposeIntoOther( &transposed );
+
+        double expectedTransposed[] = {
+            0, 0, //
+            9, 3, //
+            2, 8, //
+        };
+        checkAgainstDense( transposed, expectedTransposed, 3, 2 );
+
+        matrix.clear();
+        TS_ASSERT_EQUALS( matrix.getNnz(), 0U );
+        TS_ASSERT_EQUALS( matrix.getM(), 2U );
+        TS_ASSERT_EQUALS( matrix.getN(), 3U );
+        TS_ASSERT( matrix.getRowSpan( 0 ).empty() );
+        TS_ASSERT( matrix.getColumnSpan( 2 ).empty() );
+    }
+};
@@ -21,6 +21,7 @@
 #include "MockColumnOracle.h"
 #include "MockErrno.h"
 #include "SparseFTFactorization.h"
+#include "Statistics.h"
 
 #include <cxxtest/TestSuite.h>
 
@@ -375,6 +376,186 @@ public:
         TS_ASSERT_THROWS_NOTHING( basis.forwardTransformation( a3, d3 ) );
         TS_ASSERT( memcmp( d3other, d3, sizeof( double ) * 3 ) );
     }
+
+    void test_refactorization_intervals()
+    {
+        SparseFTFactorization basis( 3, *oracle );
+        Statistics statistics;
+        ( (IBasisFactorization *)&basis )->setStatistics( &statistics );
+
+        double B[] = {
+            1, 0, 0, //
+            0, 1, 0, //
+            0, 0, 1, //
+        };
+        oracle->storeBasis( 3, B );
+        basis.obtainFreshBasis();
+
+        TS_ASSERT_EQUALS( statistics.getLongAttribute( Statistics::NUM_BASIS_REFACTORIZATIONS ),
+                          1U );
+
+        // Alternately replace the first column, then restore it
+        double a[] = { 2, 1, 3 };
+        double e1[] = { 1, 0, 0 };
+        double x[] = { 0, 0, 0 };
+        unsigned numUpdates = 3 * GlobalConfiguration::ADAPTIVE_REFACTORIZATION_MAX_INTERVAL;
+        for ( unsigned i = 0; i < numUpdates; ++i )
+        {
+            TS_ASSERT_THROWS_NOTHING( basis.forwardTransformation( a, x ) );
+            TS_ASSERT_THROWS_NOTHING( basis.backwardTransformation( a, x ) );
+            TS_ASSERT_THROWS_NOTHING( basis.updateToAdjacentBasis( 0, NULL, i % 2 ? e1 : a ) );
+        }
+
+        unsigned long long numTriggered =
+            statistics.getLongAttribute( Statistics::NUM_BASIS_UPDATE_TRIGGERED_REFACTORIZATIONS );
+        TS_ASSERT_EQUALS( statistics.getLongAttribute( Statistics::NUM_BASIS_REFACTORIZATIONS ),
+                          numTriggered + 1 );
+
+        unsigned maxInterval =
+            statistics.getUnsignedAttribute( Statistics::MAX_BASIS_REFACTORIZATION_INTERVAL );
+        unsigned lastInterval =
+            statistics.getUnsignedAttribute( Statistics::LAST_BASIS_REFACTORIZATION_INTERVAL );
+
+        if ( GlobalConfiguration::USE_ADAPTIVE_REFACTORIZATION )
+        {
+            TS_ASSERT( numTriggered >= 2U );
+            TS_ASSERT( lastInterval >= GlobalConfiguration::ADAPTIVE_REFACTORIZATION_MIN_INTERVAL );
+            TS_ASSERT( maxInterval <= GlobalConfiguration::ADAPTIVE_REFACTORIZATION_MAX_INTERVAL );
+        }
+
+        TS_ASSERT( lastInterval <= maxInterval );
+        TS_ASSERT( statistics.getLongAttribute(
+                       Statistics::TOTAL_BASIS_REFACTORIZATION_INTERVALS ) <= numUpdates );
+    }
+
+    /*
+      Start from an m x m identity basis and cycle through its columns,
+      replacing column j with a column of ones whose j'th entry is 2 or 3.
+      The k'th update after a refactorization adds min( k - 1, m - 1 )
+      multipliers to the eta file, while V fills up its upper triangle,
+      i.e. m * ( m + 1 ) / 2 non-zeros, within the first m - 1 updates. No
+      transformations are performed, so only the fill ratio and the interval
+      clamps can trigger a refactorization.
+    */
+    unsigned runCyclicUpdates( unsigned m, unsigned numUpdates, Statistics &statistics )
+    {
+        SparseFTFactorization basis( m, *oracle );
+        ( (IBasisFactorization *)&basis )->setStatistics( &statistics );
+
+        double *B = new double[m * m];
+        double *column = new double[m];
+        for ( unsigned i = 0; i < m; ++i )
+            for ( unsigned j = 0; j < m; ++j )
+                B[i * m + j] = ( i == j ) ? 1 : 0;
+        oracle->storeBasis( m, B );
+        basis.obtainFreshBasis();
+
+        for ( unsigned k = 0; k < numUpdates; ++k )
+        {
+            unsigned j = k % m;
+            for ( unsigned i = 0; i < m; ++i )
+                column[i] = ( i == j ) ? 2 + ( k % 2 ) : 1;
+            TS_ASSERT_THROWS_NOTHING( basis.updateToAdjacentBasis( j, NULL, column ) );
+        }
+
+        delete[] column;
+        delete[] B;
+
+        return statistics.getUnsignedAttribute( Statistics::LAST_BASIS_REFACTORIZATION_INTERVAL );
+    }
+
+    unsigned expectedFillRatioInterval( unsigned m )
+    {
+        unsigned factorsNnz = m * ( m + 1 ) / 2;
+        unsigned etaNnz = 0;
+        unsigned k = 0;
+        while ( etaNnz <=
+                GlobalConfiguration::ADAPTIVE_REFACTORIZATION_MAX_ETA_FILL_RATIO * factorsNnz )
+        {
+            ++k;
+            etaNnz += ( k - 1 < m - 1 ) ? k - 1 : m - 1;
+        }
+
+        if ( k < GlobalConfiguration::ADAPTIVE_REFACTORIZATION_MIN_INTERVAL )
+            return GlobalConfiguration::ADAPTIVE_REFACTORIZATION_MIN_INTERVAL;
+        if ( k > GlobalConfiguration::ADAPTIVE_REFACTORIZATION_MAX_INTERVAL )
+            return GlobalConfiguration::ADAPTIVE_REFACTORIZATION_MAX_INTERVAL;
+        return k;
+    }
+
+    void test_refactorization_on_eta_fill()
+    {
+        if ( !GlobalConfiguration::USE_ADAPTIVE_REFACTORIZATION )
+            return;
+
+        // A 7 x 7 basis: with the default fill ratio of 2, the eta file has
+        // 57 > 2 * 28 non-zeros after 13 updates
+        unsigned interval = expectedFillRatioInterval( 7 );
+        TS_ASSERT_LESS_THAN( GlobalConfiguration::ADAPTIVE_REFACTORIZATION_MIN_INTERVAL, interval );
+
+        // Each refactorization happens instead of the ( interval + 1 )'th update
+        Statistics statistics;
+        TS_ASSERT_EQUALS( runCyclicUpdates( 7, 3 * ( interval + 1 ), statistics ), interval );
+        TS_ASSERT_EQUALS(
+            statistics.getLongAttribute( Statistics::NUM_BASIS_UPDATE_TRIGGERED_REFACTORIZATIONS ),
+            3U );
+        TS_ASSERT_EQUALS(
+            statistics.getUnsignedAttribute( Statistics::MAX_BASIS_REFACTORIZATION_INTERVAL ),
+            interval );
+        TS_ASSERT_EQUALS(
+            statistics.getLongAttribute( Statistics::TOTAL_BASIS_REFACTORIZATION_INTERVALS ),
+            3 * interval );
+    }
+
+    void test_refactorization_min_interval()
+    {
+        if ( !GlobalConfiguration::USE_ADAPTIVE_REFACTORIZATION )
+            return;
+
+        // A 3 x 3 basis: the eta file passes the fill ratio after 7 updates,
+        // but refactorization is postponed until the minimal interval
+        unsigned interval = expectedFillRatioInterval( 3 );
+        TS_ASSERT_EQUALS( interval, GlobalConfiguration::ADAPTIVE_REFACTORIZATION_MIN_INTERVAL );
+
+        Statistics statistics;
+        TS_ASSERT_EQUALS( runCyclicUpdates( 3, 2 * ( interval + 1 ), statistics ), interval );
+        TS_ASSERT_EQUALS(
+            statistics.getLongAttribute( Statistics::NUM_BASIS_UPDATE_TRIGGERED_REFACTORIZATIONS ),
+            2U );
+    }
+
+    void test_refactorization_max_interval()
+    {
+        if ( !GlobalConfiguration::USE_ADAPTIVE_REFACTORIZATION )
+            return;
+
+        SparseFTFactorization basis( 3, *oracle );
+        Statistics statistics;
+        ( (IBasisFactorization *)&basis )->setStatistics( &statistics );
+
+        double B[] = {
+            1, 0, 0, //
+            0, 1, 0, //
+            0, 0, 1, //
+        };
+        oracle->storeBasis( 3, B );
+        basis.obtainFreshBasis();
+
+        // Scaling the first column keeps U upper triangular, so the eta file
+        // stays empty and only the maximal interval triggers refactorization
+        double a[] = { 2, 0, 0 };
+        double e1[] = { 1, 0, 0 };
+        unsigned interval = GlobalConfiguration::ADAPTIVE_REFACTORIZATION_MAX_INTERVAL;
+        for ( unsigned i = 0; i < 2 * ( interval + 1 ); ++i )
+            TS_ASSERT_THROWS_NOTHING( basis.updateToAdjacentBasis( 0, NULL, i % 2 ? e1 : a ) );
+
+        TS_ASSERT_EQUALS(
+            statistics.getLongAttribute( Statistics::NUM_BASIS_UPDATE_TRIGGERED_REFACTORIZATIONS ),
+            2U );
+        TS_ASSERT_EQUALS(
+            statistics.getUnsignedAttribute( Statistics::LAST_BASIS_REFACTORIZATION_INTERVAL ),
+            interval );
+    }
 };
 
 //
@@ -68,7 +68,7 @@ public:
         }
     }
 
-    List<SparseUnsortedList *> cleanup;
+    List<SparseUnsortedArray *> cleanup;
     void basisIntoSparseColumns( double *B, unsigned m, SparseColumnsOfBasis &sparse )
     {
         double *denseColumn = new double[m];
@@ -80,9 +80,9 @@ public:
                 denseColumn[row] = B[row * m + col];
             }
 
-            SparseUnsortedList *list = new SparseUnsortedList( denseColumn, m );
-            sparse._columns[col] = list;
-            cleanup.append( list );
+            SparseUnsortedArray *array = new SparseUnsortedArray( denseColumn, m );
+            sparse._columns[col] = SparseSpan( *array );
+            cleanup.append( array );
         }
 
         delete[] denseColumn;
@@ -18,6 +18,7 @@
 #include "SparseUnsortedList.h"
 
 #include <cxxtest/TestSuite.h>
+#include <utility>
 
 class MockForSparseUnsortedList
 {
@@ -174,6 +175,170 @@ public:
 
         TS_ASSERT_EQUALS( v1.getNnz(), 0U );
     }
+
+    void test_merge_entries_target_after_source()
+    {
+        SparseUnsortedList v1( 10 );
+
+        for ( unsigned i = 0; i < 8; ++i )
+            v1.append( i, i + 1 );
+
+        TS_ASSERT_THROWS_NOTHING( v1.mergeEntries( 1, 6 ) );
+
+        TS_ASSERT_EQUALS( v1.getNnz(), 7U );
+        TS_ASSERT_EQUALS( v1.get( 1 ), 0 );
+        TS_ASSERT_EQUALS( v1.get( 6 ), 9 );
+
+        unsigned expectedIndices[] = { 0, 2, 3, 4, 5, 6, 7 };
+        unsigned position = 0;
+        for ( const auto &entry : v1 )
+        {
+            TS_ASSERT_EQUALS( entry._index, expectedIndices[position] );
+            ++position;
+        }
+
+        // Merging entries that cancel out removes both of them
+        v1.set( 0, -4 );
+        TS_ASSERT_THROWS_NOTHING( v1.mergeEntries( 0, 3 ) );
+        TS_ASSERT_EQUALS( v1.getNnz(), 5U );
+        TS_ASSERT_EQUALS( v1.get( 0 ), 0 );
+        TS_ASSERT_EQUALS( v1.get( 3 ), 0 );
+        TS_ASSERT_EQUALS( v1.get( 7 ), 8 );
+    }
+
+    void test_grow_beyond_inline_storage()
+    {
+        SparseUnsortedList v1( 20 );
+
+        v1.append( 0, 1 );
+        const SparseUnsortedList::Entry *inlineEntries = v1.begin();
+
+        // Short lists are stored inline
+        for ( unsigned i = 1; i < 4; ++i )
+            v1.append( i, i + 1 );
+        TS_ASSERT_EQUALS( v1.begin(), inlineEntries );
+
+        // Longer ones are moved to the heap, keeping their entries
+        for ( unsigned i = 4; i < 20; ++i )
+            v1.append( i, i + 1 );
+        TS_ASSERT_DIFFERS( v1.begin(), inlineEntries );
+
+        TS_ASSERT_EQUALS( v1.getNnz(), 20U );
+        unsigned position = 0;
+        for ( const auto &entry : v1 )
+        {
+            TS_ASSERT_EQUALS( entry._index, position );
+            TS_ASSERT_EQUALS( entry._value, position + 1 );
+            ++position;
+        }
+    }
+
+    void test_move()
+    {
+        // Moving an inline list copies its entries
+        SparseUnsortedList inlineSource( 5 );
+        inlineSource.append( 1, 2 );
+        inlineSource.append( 3, 4 );
+
+        SparseUnsortedList v1( std::move( inlineSource ) );
+        TS_ASSERT_EQUALS( v1.getSize(), 5U );
+        TS_ASSERT_EQUALS( v1.getNnz(), 2U );
+        TS_ASSERT_EQUALS( v1.get( 1 ), 2 );
+        TS_ASSERT_EQUALS( v1.get( 3 ), 4 );
+        TS_ASSERT( inlineSource.empty() );
+
+        // Moving a heap list steals its storage
+        SparseUnsortedList heapSource( 10 );
+        for ( unsigned i = 0; i < 10; ++i )
+            heapSource.append( i, i + 1 );
+        const SparseUnsortedList::Entry *heapEntries = heapSource.begin();
+
+        SparseUnsortedList v2( std::move( heapSource ) );
+        TS_ASSERT_EQUALS( v2.begin(), heapEntries );
+        TS_ASSERT_EQUALS( v2.getNnz(), 10U );
+        TS_ASSERT( heapSource.empty() );
+
+        // Move assignment, into both inline and heap lists
+        TS_ASSERT_THROWS_NOTHING( v1 = std::move( v2 ) );
+        TS_ASSERT_EQUALS( v1.begin(), heapEntries );
+        TS_ASSERT_EQUALS( v1.getSize(), 10U );
+        TS_ASSERT_EQUALS( v1.getNnz(), 10U );
+        TS_ASSERT_EQUALS( v1.get( 9 ), 10 );
+        TS_ASSERT( v2.empty() );
+
+        SparseUnsortedList v3( 3 );
+        v3.append( 2, 7 );
+        TS_ASSERT_THROWS_NOTHING( v1 = std::move( v3 ) );
+        TS_ASSERT_EQUALS( v1.getSize(), 3U );
+        TS_ASSERT_EQUALS( v1.getNnz(), 1U );
+        TS_ASSERT_EQUALS( v1.get( 2 ), 7 );
+        TS_ASSERT_EQUALS( v1.get( 9 ), 0 );
+
+        // The moved-from lists remain usable
+        for ( unsigned i = 0; i < 6; ++i )
+            v2.append( i, 1 );
+        TS_ASSERT_EQUALS( v2.getNnz(), 6U );
+    }
+
+    void test_self_assignment()
+    {
+        SparseUnsortedList v1( 10 );
+        v1.append( 0, 1 );
+        v1.append( 5, 2 );
+
+        SparseUnsortedList &alias = v1;
+        TS_ASSERT_THROWS_NOTHING( v1 = alias );
+        TS_ASSERT_EQUALS( v1.getNnz(), 2U );
+        TS_ASSERT_EQUALS( v1.get( 5 ), 2 );
+
+        for ( unsigned i = 1; i < 5; ++i )
+            v1.append( i, 3 );
+
+        TS_ASSERT_THROWS_NOTHING( v1 = alias );
+        TS_ASSERT_THROWS_NOTHING( v1 = std::move( alias ) );
+        TS_ASSERT_EQUALS( v1.getNnz(), 6U );
+        TS_ASSERT_EQUALS( v1.get( 0 ), 1 );
+        TS_ASSERT_EQUALS( v1.get( 3 ), 3 );
+        TS_ASSERT_EQUALS( v1.get( 5 ), 2 );
+    }
+
+    void test_erase()
+    {
+        SparseUnsortedList v1( 10 );
+        for ( unsigned i = 0; i < 6; ++i )
+            v1.append( i, i + 1 );
+
+        // Erasing keeps the order, and returns the following entry
+        auto it = v1.begin() + 2;
+        it = v1.erase( it );
+        TS_ASSERT_EQUALS( it->_index, 3U );
+
+        unsigned expectedIndices[] = { 0, 1, 3, 4, 5 };
+        unsigned position = 0;
+        for ( const auto &entry : v1 )
+        {
+            TS_ASSERT_EQUALS( entry._index, expectedIndices[position] );
+            ++position;
+        }
+
+        // Erasing the last entry returns end()
+        it = v1.erase( v1.end() - 1 );
+        TS_ASSERT_EQUALS( it, v1.end() );
+        TS_ASSERT_EQUALS( v1.getNnz(), 4U );
+
+        // Erasing while iterating
+        for ( it = v1.begin(); it != v1.end(); )
+        {
+            if ( it->_index % 2 == 1 )
+                it = v1.erase( it );
+            else
+                ++it;
+        }
+
+        TS_ASSERT_EQUALS( v1.getNnz(), 2U );
+        TS_ASSERT_EQUALS( v1.get( 0 ), 1 );
+        TS_ASSERT_EQUALS( v1.get( 4 ), 5 );
+    }
 };
 
 //
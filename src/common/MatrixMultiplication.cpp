@@ -15,6 +15,11 @@
 
 #include "MatrixMultiplication.h"
 
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
 #ifdef ENABLE_OPENBLAS
 #include "cblas.h"
 void matrixMultiplication( const double *matA,
@@ -65,3 +70,326 @@ void matrixMultiplication( const double *matA,
     }
 }
 #endif
+
+/*
+  The fused sign split kernel goes over matB in blocks of
+  SIGN_SPLIT_ROW_BLOCK x SIGN_SPLIT_COLUMN_BLOCK entries, so that a block is
+  reused, from cache, by all the rows of the A matrices. With OpenBLAS, it
+  is only used when at most 1 / SIGN_SPLIT_SPARSITY_RATIO of the entries of
+  the A matrices are non-zero; for denser matrices, the GEMMs of
+  centerRadiusMultiplication() are faster.
+*/
+enum {
+    SIGN_SPLIT_ROW_BLOCK = 64,
+    SIGN_SPLIT_COLUMN_BLOCK = 512,
+    SIGN_SPLIT_SPARSITY_RATIO = 8,
+};
+
+/*
+  Compute the sign split product in a single pass over the A matrices,
+  skipping entries that are zero in both of them. Where the lower and upper
+  entries are equal the sign split is not needed, as
+
+    a * max( b, 0 ) + a * min( b, 0 ) = a * b
+*/
+static void fusedSignSplitMultiplication( const double *lowerA,
+                                          const double *upperA,
+                                          const double *lowerB,
+                                          const double *upperB,
+                                          double *lowerC,
+                                          double *upperC,
+                                          unsigned rowsA,
+                                          unsigned columnsA,
+                                          unsigned columnsB )
+{
+    for ( unsigned kStart = 0; kStart < columnsA; kStart += SIGN_SPLIT_ROW_BLOCK )
+    {
+        unsigned kEnd = std::min<unsigned>( columnsA, kStart + SIGN_SPLIT_ROW_BLOCK );
+        for ( unsigned jStart = 0; jStart < columnsB; jStart += SIGN_SPLIT_COLUMN_BLOCK )
+        {
+            unsigned jEnd = std::min<unsigned>( columnsB, jStart + SIGN_SPLIT_COLUMN_BLOCK );
+            for ( unsigned i = 0; i < rowsA; ++i )
+            {
+                double *lowerRow = lowerC + i * columnsB;
+                double *upperRow = upperC + i * columnsB;
+
+                for ( unsigned k = kStart; k < kEnd; ++k )
+                {
+                    double lower = lowerA[i * columnsA + k];
+                    double upper = upperA[i * columnsA + k];
+                    if ( lower == 0 && upper == 0 )
+                        continue;
+
+                    const double *lowerCoefficients = lowerB + k * columnsB;
+                    const double *upperCoefficients = upperB + k * columnsB;
+
+                    if ( lower == upper )
+                    {
+                        for ( unsigned j = jStart; j < jEnd; ++j )
+                        {
+                            lowerRow[j] += lower * lowerCoefficients[j];
+                            upperRow[j] += lower * upperCoefficients[j];
+                        }
+                    }
+                    else if ( lowerB == upperB )
+                    {
+                        for ( unsigned j = jStart; j < jEnd; ++j )
+                        {
+                            double positive = std::max( lowerCoefficients[j], 0.0 );
+                            double negative = std::min( lowerCoefficients[j], 0.0 );
+                            lowerRow[j] += lower * positive + upper * negative;
+                            upperRow[j] += upper * positive + lower * negative;
+                        }
+                    }
+                    else
+                    {
+                        for ( unsigned j = jStart; j < jEnd; ++j )
+                        {
+                            lowerRow[j] += lower * std::max( lowerCoefficients[j], 0.0 ) +
+                                           upper * std::min( lowerCoefficients[j], 0.0 );
+                            upperRow[j] += upper * std::max( upperCoefficients[j], 0.0 ) +
+                                           lower * std::min( upperCoefficients[j], 0.0 );
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+#ifdef ENABLE_OPENBLAS
+static void dgemm( const double *matA,
+                   const double *matB,
+                   double *matC,
+                   unsigned rowsA,
+                   unsigned columnsA,
+                   unsigned columnsB,
+                   double alpha,
+                   double beta )
+{
+    cblas_dgemm( CblasRowMajor,
+                 CblasNoTrans,
+                 CblasNoTrans,
+                 rowsA,
+                 columnsB,
+                 columnsA,
+                 alpha,
+                 matA,
+                 columnsA,
+                 matB,
+                 columnsB,
+                 beta,
+                 matC,
+                 columnsB );
+}
+
+/*
+  Gather the given columns of matA, transformed by f, into a dense
+  rowsA x columns.size() matrix, and the corresponding rows of matB,
+  transformed by g, into a columns.size() x columnsB matrix.
+*/
+template <class F, class G>
+static void gatherColumns( const double *lowerA,
+                           const double *upperA,
+                           const double *matB,
+                           unsigned rowsA,
+                           unsigned columnsA,
+                           unsigned columnsB,
+                           const std::vector<unsigned> &columns,
+                           F f,
+                           G g,
+                           double *gatheredA,
+                           double *gatheredB )
+{
+    unsigned count = columns.size();
+    for ( unsigned i = 0; i < rowsA; ++i )
+    {
+        for ( unsigned c = 0; c < count; ++c )
+        {
+            unsigned index = i * columnsA + columns[c];
+            gatheredA[i * count + c] = f( lowerA[index], upperA[index] );
+        }
+    }
+
+    for ( unsigned c = 0; c < count; ++c )
+    {
+        const double *row = matB + columns[c] * columnsB;
+        for ( unsigned j = 0; j < columnsB; ++j )
+            gatheredB[c * columnsB + j] = g( row[j] );
+    }
+}
+
+/*
+  Compute the sign split product with GEMMs, by writing each pair of lower
+  and upper entries as an interval center +- radius, with radius >= 0:
+
+    lowerC += center * lowerB - radius * | lowerB |
+    upperC += center * upperB + radius * | upperB |
+
+  When lowerB and upperB are the same matrix, this takes two GEMMs instead of
+  four. Columns of the A matrices that are zero are left out of both GEMMs,
+  and columns whose lower and upper entries are all equal (e.g., those of
+  active ReLUs) are left out of the radius GEMMs.
+*/
+static void centerRadiusMultiplication( const double *lowerA,
+                                        const double *upperA,
+                                        const double *lowerB,
+                                        const double *upperB,
+                                        double *lowerC,
+                                        double *upperC,
+                                        unsigned rowsA,
+                                        unsigned columnsA,
+                                        unsigned columnsB,
+                                        const std::vector<unsigned> &nonZeroColumns,
+                                        const std::vector<unsigned> &unstableColumns )
+{
+    auto center = []( double lower, double upper ) { return ( lower + upper ) / 2; };
+    auto radius = []( double lower, double upper ) { return ( upper - lower ) / 2; };
+    auto identity = []( double value ) { return value; };
+    auto absolute = []( double value ) { return std::abs( value ); };
+
+    unsigned sizeC = rowsA * columnsB;
+    std::unique_ptr<double[]> product( lowerB == upperB ? new double[sizeC] : nullptr );
+
+    unsigned count = nonZeroColumns.size();
+    if ( count > 0 )
+    {
+        std::unique_ptr<double[]> gatheredA( new double[rowsA * count] );
+        std::unique_ptr<double[]> gatheredB( new double[count * columnsB] );
+
+        gatherColumns( lowerA,
+                       upperA,
+                       lowerB,
+                       rowsA,
+                       columnsA,
+                       columnsB,
+                       nonZeroColumns,
+                       center,
+                       identity,
+                       gatheredA.get(),
+                       gatheredB.get() );
+
+        if ( lowerB == upperB )
+        {
+            dgemm( gatheredA.get(), gatheredB.get(), product.get(), rowsA, count, columnsB, 1, 0 );
+            for ( unsigned i = 0; i < sizeC; ++i )
+            {
+                lowerC[i] += product[i];
+                upperC[i] += product[i];
+            }
+        }
+        else
+        {
+            dgemm( gatheredA.get(), gatheredB.get(), lowerC, rowsA, count, columnsB, 1, 1 );
+            for ( unsigned c = 0; c < count; ++c )
+                std::copy_n( upperB + nonZeroColumns[c] * columnsB,
+                             columnsB,
+                             gatheredB.get() + c * columnsB );
+            dgemm( gatheredA.get(), gatheredB.get(), upperC, rowsA, count, columnsB, 1, 1 );
+        }
+    }
+
+    count = unstableColumns.size();
+    if ( count > 0 )
+    {
+        std::unique_ptr<double[]> gatheredA( new double[rowsA * count] );
+        std::unique_ptr<double[]> gatheredB( new double[count * columnsB] );
+
+        gatherColumns( lowerA,
+                       upperA,
+                       lowerB,
+                       rowsA,
+                       columnsA,
+                       columnsB,
+                       unstableColumns,
+                       radius,
+                       absolute,
+                       gatheredA.get(),
+                       gatheredB.get() );
+
+        if ( lowerB == upperB )
+        {
+            dgemm( gatheredA.get(), gatheredB.get(), product.get(), rowsA, count, columnsB, 1, 0 );
+            for ( unsigned i = 0; i < sizeC; ++i )
+            {
+                lowerC[i] -= product[i];
+                upperC[i] += product[i];
+            }
+        }
+        else
+        {
+            dgemm( gatheredA.get(), gatheredB.get(), lowerC, rowsA, count, columnsB, -1, 1 );
+            for ( unsigned c = 0; c < count; ++c )
+            {
+                const double *row = upperB + unstableColumns[c] * columnsB;
+                for ( unsigned j = 0; j < columnsB; ++j )
+                    gatheredB[c * columnsB + j] = std::abs( row[j] );
+            }
+            dgemm( gatheredA.get(), gatheredB.get(), upperC, rowsA, count, columnsB, 1, 1 );
+        }
+    }
+}
+#endif
+
+void signSplitMatrixMultiplication( const double *lowerA,
+                                    const double *upperA,
+                                    const double *lowerB,
+                                    const double *upperB,
+                                    double *lowerC,
+                                    double *upperC,
+                                    unsigned rowsA,
+                                    unsigned columnsA,
+                                    unsigned columnsB )
+{
+#ifdef ENABLE_OPENBLAS
+    // Find the columns of the A matrices that are not zero, and those that
+    // are not zero and have different lower and upper entries
+    std::vector<bool> isNonZero( columnsA, false );
+    std::vector<bool> isUnstable( columnsA, false );
+    unsigned nonZeros = 0;
+    for ( unsigned i = 0; i < rowsA; ++i )
+    {
+        for ( unsigned k = 0; k < columnsA; ++k )
+        {
+            double lower = lowerA[i * columnsA + k];
+            double upper = upperA[i * columnsA + k];
+            if ( lower == 0 && upper == 0 )
+                continue;
+
+            ++nonZeros;
+            isNonZero[k] = true;
+            if ( lower != upper )
+                isUnstable[k] = true;
+        }
+    }
+
+    if ( (unsigned long long)nonZeros * SIGN_SPLIT_SPARSITY_RATIO > rowsA * columnsA )
+    {
+        std::vector<unsigned> nonZeroColumns;
+        std::vector<unsigned> unstableColumns;
+        for ( unsigned k = 0; k < columnsA; ++k )
+        {
+            if ( isNonZero[k] )
+                nonZeroColumns.push_back( k );
+            if ( isUnstable[k] )
+                unstableColumns.push_back( k );
+        }
+
+        centerRadiusMultiplication( lowerA,
+                                    upperA,
+                                    lowerB,
+                                    upperB,
+                                    lowerC,
+                                    upperC,
+                                    rowsA,
+                                    columnsA,
+                                    columnsB,
+                                    nonZeroColumns,
+                                    unstableColumns );
+        return;
+    }
+#endif
+
+    fusedSignSplitMultiplication(
+        lowerA, upperA, lowerB, upperB, lowerC, upperC, rowsA, columnsA, columnsB );
+}
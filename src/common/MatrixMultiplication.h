@@ -1,4 +1,3 @@
-
 #ifndef __MatrixMultiplication_h__
 #define __MatrixMultiplication_h__
 
@@ -14,4 +13,27 @@ void matrixMultiplication( const double *matA,
                            unsigned columnsA,
                            unsigned columnsB );
 
+/*
+  Multiply a pair of lower and upper symbolic bound matrices by the
+  coefficients of a linear map, splitting the coefficients by sign. The
+  sizes of lowerA and upperA are rowsA x columnsA, and the sizes of lowerB
+  and upperB are columnsA x columnsB. Compute
+
+    lowerC += lowerA * max( lowerB, 0 ) + upperA * min( lowerB, 0 )
+    upperC += upperA * max( upperB, 0 ) + lowerA * min( upperB, 0 )
+
+  lowerB and upperB may be the same matrix, e.g. the weights of a weighted
+  sum layer. This replaces four matrixMultiplication() calls on separately
+  stored positive and negative coefficients.
+*/
+void signSplitMatrixMultiplication( const double *lowerA,
+                                    const double *upperA,
+                                    const double *lowerB,
+                                    const double *upperB,
+                                    double *lowerC,
+                                    double *upperC,
+                                    unsigned rowsA,
+                                    unsigned columnsA,
+                                    unsigned columnsB );
+
 #endif // __MatrixMultiplication_h__
@@ -45,6 +45,8 @@ Statistics::Statistics()
     _unsignedAttributes[NUM_LEMMAS] = 0;
     _unsignedAttributes[NUM_LEMMAS_USED] = 0;
     _unsignedAttributes[CERTIFIED_UNSAT] = 0;
+    _unsignedAttributes[LAST_BASIS_REFACTORIZATION_INTERVAL] = 0;
+    _unsignedAttributes[MAX_BASIS_REFACTORIZATION_INTERVAL] = 0;
 
     _longAttributes[NUM_MAIN_LOOP_ITERATIONS] = 0;
     _longAttributes[NUM_SIMPLEX_STEPS] = 0;
@@ -73,6 +75,9 @@ Statistics::Statistics()
     _longAttributes[NUM_BOUND_TIGHTENINGS_ON_CONSTRAINT_MATRIX] = 0;
     _longAttributes[NUM_TIGHTENINGS_FROM_CONSTRAINT_MATRIX] = 0;
     _longAttributes[NUM_BASIS_REFACTORIZATIONS] = 0;
+    _longAttributes[NUM_BASIS_UPDATE_TRIGGERED_REFACTORIZATIONS] = 0;
+    _longAttributes[TOTAL_BASIS_REFACTORIZATION_INTERVALS] = 0;
+    _longAttributes[TOTAL_TIME_BASIS_REFACTORIZATION_MICRO] = 0;
     _longAttributes[PSE_NUM_ITERATIONS] = 0;
     _longAttributes[PSE_NUM_RESET_REFERENCE_SPACE] = 0;
     _longAttributes[TOTAL_TIME_PERFORMING_VALID_CASE_SPLITS_MICRO] = 0;
@@ -347,8 +352,18 @@ void Statistics::print()
             getLongAttribute( Statistics::NUM_BOUNDS_PROPOSED_BY_PL_CONSTRAINTS ) );
 
     printf( "\t--- Basis Factorization statistics ---\n" );
-    printf( "\tNumber of basis refactorizations: %llu\n",
-            getLongAttribute( Statistics::NUM_BASIS_REFACTORIZATIONS ) );
+    printf( "\tNumber of basis refactorizations: %llu. Total time: %llu milli\n",
+            getLongAttribute( Statistics::NUM_BASIS_REFACTORIZATIONS ),
+            getLongAttribute( Statistics::TOTAL_TIME_BASIS_REFACTORIZATION_MICRO ) / 1000 );
+    unsigned long long numUpdateTriggeredRefactorizations =
+        getLongAttribute( Statistics::NUM_BASIS_UPDATE_TRIGGERED_REFACTORIZATIONS );
+    printf( "\t\tTriggered by basis updates: %llu. Updates between refactorizations: "
+            "average %.2lf, last %u, max %u\n",
+            numUpdateTriggeredRefactorizations,
+            printAverage( getLongAttribute( Statistics::TOTAL_BASIS_REFACTORIZATION_INTERVALS ),
+                          numUpdateTriggeredRefactorizations ),
+            getUnsignedAttribute( Statistics::LAST_BASIS_REFACTORIZATION_INTERVAL ),
+            getUnsignedAttribute( Statistics::MAX_BASIS_REFACTORIZATION_INTERVAL ) );
 
     unsigned long long pseNumIterations = getLongAttribute( Statistics::PSE_NUM_ITERATIONS );
     unsigned long long pseNumResetReferenceSpace =
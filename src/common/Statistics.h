@@ -75,6 +75,11 @@ public:
 
         // 1 if returned UNSAT and proof was certified by proof checker, 0 otherwise.
         CERTIFIED_UNSAT,
+
+        // The number of basis updates between the last two refactorizations triggered by basis
+        // updates, and the longest such interval so far
+        LAST_BASIS_REFACTORIZATION_INTERVAL,
+        MAX_BASIS_REFACTORIZATION_INTERVAL,
     };
 
     enum StatisticsLongAttribute {
@@ -163,6 +168,12 @@ public:
         // Basis factorization statistics
         NUM_BASIS_REFACTORIZATIONS,
 
+        // Number of refactorizations triggered by basis updates (as opposed to explicit requests),
+        // the total number of basis updates between them, and the total time refactorizing
+        NUM_BASIS_UPDATE_TRIGGERED_REFACTORIZATIONS,
+        TOTAL_BASIS_REFACTORIZATION_INTERVALS,
+        TOTAL_TIME_BASIS_REFACTORIZATION_MICRO,
+
         // Projected steepest edge statistics
         PSE_NUM_ITERATIONS,
         PSE_NUM_RESET_REFERENCE_SPACE,
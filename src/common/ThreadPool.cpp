@@ -0,0 +1,174 @@
+/*********************                                                        */
+/*! \file ThreadPool.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "ThreadPool.h"
+
+// The pool whose task the current thread is running, if any, and the worker
+// index of the current thread in that pool
+static thread_local const ThreadPool *currentPool = nullptr;
+static thread_local unsigned currentWorker = 0;
+
+class CurrentWorkerGuard
+{
+public:
+    CurrentWorkerGuard( const ThreadPool *pool, unsigned worker )
+        : _previousPool( currentPool )
+        , _previousWorker( currentWorker )
+    {
+        currentPool = pool;
+        currentWorker = worker;
+    }
+
+    ~CurrentWorkerGuard()
+    {
+        currentPool = _previousPool;
+        currentWorker = _previousWorker;
+    }
+
+private:
+    const ThreadPool *_previousPool;
+    unsigned _previousWorker;
+};
+
+ThreadPool::ThreadPool( unsigned numberOfWorkers )
+    : _numberOfWorkers( numberOfWorkers > 0 ? numberOfWorkers : 1 )
+    , _task( nullptr )
+    , _count( 0 )
+    , _nextIndex( 0 )
+    , _busyWorkers( 0 )
+    , _generation( 0 )
+    , _shuttingDown( false )
+    , _exceptionIndex( 0 )
+{
+    for ( unsigned i = 1; i < _numberOfWorkers; ++i )
+        _threads.push_back( std::thread( &ThreadPool::workerLoop, this, i ) );
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+        _shuttingDown = true;
+    }
+    _jobAvailable.notify_all();
+
+    for ( auto &thread : _threads )
+        thread.join();
+}
+
+unsigned ThreadPool::getNumberOfWorkers() const
+{
+    return _numberOfWorkers;
+}
+
+bool ThreadPool::isRunningTask() const
+{
+    return currentPool == this;
+}
+
+void ThreadPool::parallelFor( unsigned count, const Task &task )
+{
+    if ( count == 0 )
+        return;
+
+    // A nested call, from one of our own tasks: the other workers may all be
+    // busy, so run inline
+    if ( isRunningTask() )
+    {
+        for ( unsigned i = 0; i < count; ++i )
+            task( i, currentWorker );
+        return;
+    }
+
+    std::lock_guard<std::mutex> callLock( _callMutex );
+    CurrentWorkerGuard guard( this, 0 );
+
+    if ( _numberOfWorkers == 1 || count == 1 )
+    {
+        for ( unsigned i = 0; i < count; ++i )
+            task( i, 0 );
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock( _mutex );
+    _task = &task;
+    _count = count;
+    _nextIndex = 0;
+    _exception = nullptr;
+    _exceptionIndex = count;
+    _busyWorkers = _numberOfWorkers - 1;
+    ++_generation;
+    _jobAvailable.notify_all();
+
+    runTasks( 0, lock );
+
+    // Every worker checks in once per job, so that none of them can miss the
+    // next one
+    _jobDone.wait( lock, [this] { return _busyWorkers == 0; } );
+    _task = nullptr;
+
+    std::exception_ptr exception = _exception;
+    _exception = nullptr;
+    lock.unlock();
+
+    if ( exception )
+        std::rethrow_exception( exception );
+}
+
+void ThreadPool::workerLoop( unsigned worker )
+{
+    CurrentWorkerGuard guard( this, worker );
+    unsigned long long seenGeneration = 0;
+
+    std::unique_lock<std::mutex> lock( _mutex );
+    while ( true )
+    {
+        _jobAvailable.wait( lock, [&] { return _shuttingDown || _generation != seenGeneration; } );
+        if ( _shuttingDown )
+            return;
+
+        seenGeneration = _generation;
+        runTasks( worker, lock );
+
+        if ( --_busyWorkers == 0 )
+            _jobDone.notify_one();
+    }
+}
+
+void ThreadPool::runTasks( unsigned worker, std::unique_lock<std::mutex> &lock )
+{
+    while ( _nextIndex < _count )
+    {
+        unsigned index = _nextIndex++;
+        lock.unlock();
+
+        std::exception_ptr exception = nullptr;
+        try
+        {
+            ( *_task )( index, worker );
+        }
+        catch ( ... )
+        {
+            exception = std::current_exception();
+        }
+
+        lock.lock();
+        if ( exception && index < _exceptionIndex )
+        {
+            _exception = exception;
+            _exceptionIndex = index;
+        }
+    }
+}
@@ -0,0 +1,93 @@
+/*********************                                                        */
+/*! \file ThreadPool.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** A fixed-size pool of threads for evaluating independent tasks in
+ ** parallel. The thread calling parallelFor() takes part in the work as
+ ** worker 0, and the pool's own threads are workers 1, ..., n-1. Every task
+ ** is told which worker runs it, so that callers can keep per-worker scratch
+ ** state instead of allocating it per task.
+ **
+ ** Tasks are handed out dynamically, so which worker runs which task is not
+ ** deterministic; callers that need deterministic results should store each
+ ** task's result by its index and combine the results afterwards, in order.
+ **
+ ** A parallelFor() issued from within one of the pool's tasks runs inline, on
+ ** the calling worker, rather than waiting on workers that may all be busy.
+
+ **/
+
+#ifndef __ThreadPool_h__
+#define __ThreadPool_h__
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool
+{
+public:
+    typedef std::function<void( unsigned index, unsigned worker )> Task;
+
+    explicit ThreadPool( unsigned numberOfWorkers );
+    ~ThreadPool();
+
+    ThreadPool( const ThreadPool & ) = delete;
+    ThreadPool &operator=( const ThreadPool & ) = delete;
+
+    unsigned getNumberOfWorkers() const;
+
+    /*
+      Whether the calling thread is running one of this pool's tasks, in
+      which case parallelFor() runs inline
+    */
+    bool isRunningTask() const;
+
+    /*
+      Run task( i, worker ) for every i in [0, count), and return once all of
+      them are done. If any of the tasks throws, the exception of the task
+      with the smallest index is rethrown.
+    */
+    void parallelFor( unsigned count, const Task &task );
+
+private:
+    unsigned _numberOfWorkers;
+    std::vector<std::thread> _threads;
+
+    // Serializes parallelFor() calls from different threads
+    std::mutex _callMutex;
+
+    // Guards the state of the current job below
+    std::mutex _mutex;
+    std::condition_variable _jobAvailable;
+    std::condition_variable _jobDone;
+
+    const Task *_task;
+    unsigned _count;
+    unsigned _nextIndex;
+    unsigned _busyWorkers;
+    unsigned long long _generation;
+    bool _shuttingDown;
+
+    std::exception_ptr _exception;
+    unsigned _exceptionIndex;
+
+    void workerLoop( unsigned worker );
+
+    /*
+      Take tasks of the current job and run them, until none are left.
+    */
+    void runTasks( unsigned worker, std::unique_lock<std::mutex> &lock );
+};
+
+#endif // __ThreadPool_h__
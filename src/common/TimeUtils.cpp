@@ -56,6 +56,11 @@ unsigned long long TimeUtils::timePassed( const struct timespec &then, const str
     return secondsAsMicro + nanoAsMicro;
 }
 
+double TimeUtils::fractionalMicroPassed( const struct timespec &then, const struct timespec &now )
+{
+    return ( now.tv_sec - then.tv_sec ) * 1000000.0 + ( now.tv_nsec - then.tv_nsec ) / 1000.0;
+}
+
 String TimeUtils::now()
 {
     time_t secondsSinceEpoch = time( NULL );
@@ -33,6 +33,7 @@ class TimeUtils
 public:
     static struct timespec sampleMicro();
     static unsigned long long timePassed( const struct timespec &then, const struct timespec &now );
+    static double fractionalMicroPassed( const struct timespec &then, const struct timespec &now );
     static String now();
 };
 
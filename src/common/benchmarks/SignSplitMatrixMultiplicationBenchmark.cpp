@@ -0,0 +1,200 @@
+/*********************                                                        */
+/*! \file SignSplitMatrixMultiplicationBenchmark.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Micro-benchmark for signSplitMatrixMultiplication, comparing it against
+ ** the four matrixMultiplication() calls on positive and negative weights
+ ** that symbolic bound tightening used for weighted sum layers. The layer
+ ** shapes are those of fully connected MNIST and CIFAR-10 networks: the
+ ** symbolic bounds of a layer that follows the input layer are the identity
+ ** matrix, and those of a layer that follows a ReLU layer have a mix of
+ ** inactive (zero), active (equal lower and upper) and unstable columns.
+
+**/
+
+#include "FloatUtils.h"
+#include "MatrixMultiplication.h"
+#include "TimeUtils.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+enum {
+    NUMBER_OF_ITERATIONS = 3,
+};
+
+struct Shape
+{
+    const char *_name;
+    unsigned _inputSize;
+    unsigned _sourceSize;
+    unsigned _targetSize;
+    bool _sourceIsInput;
+};
+
+static double randomValue()
+{
+    return ( ( rand() % 2001 ) - 1000 ) / 1000.0;
+}
+
+static void fourMultiplications( const double *lowerA,
+                                 const double *upperA,
+                                 const double *positiveWeights,
+                                 const double *negativeWeights,
+                                 double *lowerC,
+                                 double *upperC,
+                                 unsigned rows,
+                                 unsigned columnsA,
+                                 unsigned columnsB )
+{
+    matrixMultiplication( upperA, positiveWeights, upperC, rows, columnsA, columnsB );
+    matrixMultiplication( lowerA, negativeWeights, upperC, rows, columnsA, columnsB );
+    matrixMultiplication( lowerA, positiveWeights, lowerC, rows, columnsA, columnsB );
+    matrixMultiplication( upperA, negativeWeights, lowerC, rows, columnsA, columnsB );
+}
+
+int main()
+{
+    srand( 2024 );
+
+    Shape shapes[] = {
+        { "MNIST, first layer ", 784, 784, 256, true },
+        { "MNIST, hidden layer", 784, 256, 256, false },
+        { "MNIST, wide hidden ", 784, 1024, 1024, false },
+        { "CIFAR, first layer ", 3072, 3072, 512, true },
+        { "CIFAR, hidden layer", 3072, 512, 512, false },
+        { "CIFAR, output layer", 3072, 512, 10, false },
+    };
+
+    bool success = true;
+    for ( const auto &shape : shapes )
+    {
+        unsigned rows = shape._inputSize;
+        unsigned sizeA = rows * shape._sourceSize;
+        unsigned sizeB = shape._sourceSize * shape._targetSize;
+        unsigned sizeC = rows * shape._targetSize;
+
+        double *lowerA = new double[sizeA];
+        double *upperA = new double[sizeA];
+        for ( unsigned i = 0; i < rows; ++i )
+        {
+            for ( unsigned j = 0; j < shape._sourceSize; ++j )
+            {
+                unsigned index = i * shape._sourceSize + j;
+                if ( shape._sourceIsInput )
+                {
+                    lowerA[index] = ( i == j ) ? 1 : 0;
+                    upperA[index] = lowerA[index];
+                    continue;
+                }
+
+                // A quarter of the ReLUs are inactive, half are active and
+                // a quarter are unstable
+                switch ( j % 4 )
+                {
+                case 0:
+                    lowerA[index] = 0;
+                    upperA[index] = 0;
+                    break;
+                case 3:
+                    lowerA[index] = randomValue() / 2;
+                    upperA[index] = lowerA[index] + ( 1 + randomValue() ) / 2;
+                    break;
+                default:
+                    lowerA[index] = randomValue();
+                    upperA[index] = lowerA[index];
+                }
+            }
+        }
+
+        double *weights = new double[sizeB];
+        double *positiveWeights = new double[sizeB];
+        double *negativeWeights = new double[sizeB];
+        for ( unsigned i = 0; i < sizeB; ++i )
+        {
+            weights[i] = randomValue();
+            positiveWeights[i] = weights[i] > 0 ? weights[i] : 0;
+            negativeWeights[i] = weights[i] < 0 ? weights[i] : 0;
+        }
+
+        double *lowerBefore = new double[sizeC];
+        double *upperBefore = new double[sizeC];
+        double *lowerAfter = new double[sizeC];
+        double *upperAfter = new double[sizeC];
+
+        unsigned long long beforeMicro = 0;
+        unsigned long long afterMicro = 0;
+        for ( unsigned iteration = 0; iteration < NUMBER_OF_ITERATIONS; ++iteration )
+        {
+            std::fill_n( lowerBefore, sizeC, 0 );
+            std::fill_n( upperBefore, sizeC, 0 );
+            struct timespec start = TimeUtils::sampleMicro();
+            fourMultiplications( lowerA,
+                                 upperA,
+                                 positiveWeights,
+                                 negativeWeights,
+                                 lowerBefore,
+                                 upperBefore,
+                                 rows,
+                                 shape._sourceSize,
+                                 shape._targetSize );
+            beforeMicro += TimeUtils::timePassed( start, TimeUtils::sampleMicro() );
+
+            std::fill_n( lowerAfter, sizeC, 0 );
+            std::fill_n( upperAfter, sizeC, 0 );
+            start = TimeUtils::sampleMicro();
+            signSplitMatrixMultiplication( lowerA,
+                                           upperA,
+                                           weights,
+                                           weights,
+                                           lowerAfter,
+                                           upperAfter,
+                                           rows,
+                                           shape._sourceSize,
+                                           shape._targetSize );
+            afterMicro += TimeUtils::timePassed( start, TimeUtils::sampleMicro() );
+        }
+
+        double maxDifference = 0;
+        for ( unsigned i = 0; i < sizeC; ++i )
+        {
+            maxDifference =
+                std::max( maxDifference, FloatUtils::abs( lowerBefore[i] - lowerAfter[i] ) );
+            maxDifference =
+                std::max( maxDifference, FloatUtils::abs( upperBefore[i] - upperAfter[i] ) );
+        }
+
+        printf( "%s (%4u x %4u x %4u): four GEMMs %9llu us -> sign split %9llu us, "
+                "max difference %.2e\n",
+                shape._name,
+                rows,
+                shape._sourceSize,
+                shape._targetSize,
+                beforeMicro / NUMBER_OF_ITERATIONS,
+                afterMicro / NUMBER_OF_ITERATIONS,
+                maxDifference );
+
+        if ( maxDifference > 0.000000001 )
+            success = false;
+
+        delete[] lowerA;
+        delete[] upperA;
+        delete[] weights;
+        delete[] positiveWeights;
+        delete[] negativeWeights;
+        delete[] lowerBefore;
+        delete[] upperBefore;
+        delete[] lowerAfter;
+        delete[] upperAfter;
+    }
+
+    return success ? 0 : 1;
+}
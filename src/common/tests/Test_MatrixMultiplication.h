@@ -14,6 +14,7 @@
  ** [[ Add lengthier description here ]]
  **/
 
+#include "FloatUtils.h"
 #include "MatrixMultiplication.h"
 
 #include <cxxtest/TestSuite.h>
@@ -54,6 +55,143 @@ public:
         TS_ASSERT( matC[4] == 23 );
         TS_ASSERT( matC[5] == 34 );
     }
+
+    void computeSignSplitProduct( const double *lowerA,
+                                  const double *upperA,
+                                  const double *lowerB,
+                                  const double *upperB,
+                                  double *lowerC,
+                                  double *upperC,
+                                  unsigned rowsA,
+                                  unsigned columnsA,
+                                  unsigned columnsB )
+    {
+        for ( unsigned i = 0; i < rowsA; ++i )
+        {
+            for ( unsigned j = 0; j < columnsB; ++j )
+            {
+                for ( unsigned k = 0; k < columnsA; ++k )
+                {
+                    double lower = lowerB[k * columnsB + j];
+                    double upper = upperB[k * columnsB + j];
+
+                    lowerC[i * columnsB + j] +=
+                        lowerA[i * columnsA + k] * ( lower > 0 ? lower : 0 ) +
+                        upperA[i * columnsA + k] * ( lower < 0 ? lower : 0 );
+                    upperC[i * columnsB + j] +=
+                        upperA[i * columnsA + k] * ( upper > 0 ? upper : 0 ) +
+                        lowerA[i * columnsA + k] * ( upper < 0 ? upper : 0 );
+                }
+            }
+        }
+    }
+
+    void checkSignSplitProduct( const double *lowerA,
+                                const double *upperA,
+                                const double *lowerB,
+                                const double *upperB,
+                                unsigned rowsA,
+                                unsigned columnsA,
+                                unsigned columnsB )
+    {
+        double *lowerC = new double[rowsA * columnsB];
+        double *upperC = new double[rowsA * columnsB];
+        double *expectedLowerC = new double[rowsA * columnsB];
+        double *expectedUpperC = new double[rowsA * columnsB];
+        for ( unsigned i = 0; i < rowsA * columnsB; ++i )
+        {
+            lowerC[i] = expectedLowerC[i] = i;
+            upperC[i] = expectedUpperC[i] = 2 * i;
+        }
+
+        signSplitMatrixMultiplication(
+            lowerA, upperA, lowerB, upperB, lowerC, upperC, rowsA, columnsA, columnsB );
+        computeSignSplitProduct( lowerA,
+                                 upperA,
+                                 lowerB,
+                                 upperB,
+                                 expectedLowerC,
+                                 expectedUpperC,
+                                 rowsA,
+                                 columnsA,
+                                 columnsB );
+
+        for ( unsigned i = 0; i < rowsA * columnsB; ++i )
+        {
+            TS_ASSERT( FloatUtils::areEqual( lowerC[i], expectedLowerC[i] ) );
+            TS_ASSERT( FloatUtils::areEqual( upperC[i], expectedUpperC[i] ) );
+        }
+
+        delete[] lowerC;
+        delete[] upperC;
+        delete[] expectedLowerC;
+        delete[] expectedUpperC;
+    }
+
+    void test_sign_split_small()
+    {
+        double lowerA[] = { 1, -2, 0, 3 }; // [1,-2], [0,3]
+        double upperA[] = { 2, -1, 0, 3 }; // [2,-1], [0,3]
+        double matB[] = { 1, -2, -3, 4 };  // [1,-2], [-3,4]
+        double lowerC[4] = { 0 };
+        double upperC[4] = { 0 };
+
+        signSplitMatrixMultiplication( lowerA, upperA, matB, matB, lowerC, upperC, 2, 2, 2 );
+
+        // lowerC[0] = 1*1 + -1*-3 = 4,  upperC[0] = 2*1 + -2*-3 = 8
+        // lowerC[1] = 2*-2 + -2*4 = -12, upperC[1] = 1*-2 + -1*4 = -6
+        // lowerC[2] = 3*-3 = -9,         upperC[2] = 3*-3 = -9
+        // lowerC[3] = 3*4 = 12,          upperC[3] = 3*4 = 12
+        TS_ASSERT( lowerC[0] == 4 );
+        TS_ASSERT( upperC[0] == 8 );
+        TS_ASSERT( lowerC[1] == -12 );
+        TS_ASSERT( upperC[1] == -6 );
+        TS_ASSERT( lowerC[2] == -9 );
+        TS_ASSERT( upperC[2] == -9 );
+        TS_ASSERT( lowerC[3] == 12 );
+        TS_ASSERT( upperC[3] == 12 );
+    }
+
+    void test_sign_split_against_separate_products()
+    {
+        unsigned rowsA = 20;
+        unsigned columnsA = 90;
+        unsigned columnsB = 600;
+
+        double *lowerA = new double[rowsA * columnsA];
+        double *upperA = new double[rowsA * columnsA];
+        double *lowerB = new double[columnsA * columnsB];
+        double *upperB = new double[columnsA * columnsB];
+        for ( unsigned i = 0; i < columnsA * columnsB; ++i )
+        {
+            lowerB[i] = ( ( i * 7 ) % 11 ) - 5.5;
+            upperB[i] = lowerB[i] + ( i % 3 );
+        }
+
+        // Dense A matrices, with zero, fixed and non-fixed columns
+        for ( unsigned i = 0; i < rowsA * columnsA; ++i )
+        {
+            unsigned column = i % columnsA;
+            lowerA[i] = ( column % 3 == 0 ) ? 0 : ( ( i * 5 ) % 13 ) - 6.0;
+            upperA[i] = lowerA[i] + ( ( column % 3 == 2 ) ? ( i % 4 ) : 0 );
+        }
+        checkSignSplitProduct( lowerA, upperA, lowerB, lowerB, rowsA, columnsA, columnsB );
+        checkSignSplitProduct( lowerA, upperA, lowerB, upperB, rowsA, columnsA, columnsB );
+
+        // Sparse A matrices
+        for ( unsigned i = 0; i < rowsA * columnsA; ++i )
+        {
+            lowerA[i] = ( i % 37 == 0 ) ? ( ( i * 5 ) % 13 ) - 6.0 : 0;
+            upperA[i] = lowerA[i] + ( ( i % 74 == 0 ) ? 1 : 0 );
+        }
+        checkSignSplitProduct( lowerA, upperA, lowerB, lowerB, rowsA, columnsA, columnsB );
+        checkSignSplitProduct( lowerA, upperA, lowerB, upperB, rowsA, columnsA, columnsB );
+
+        delete[] lowerA;
+        delete[] upperA;
+        delete[] lowerB;
+        delete[] upperB;
+    }
 };
 
 //
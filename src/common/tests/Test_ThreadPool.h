@@ -0,0 +1,114 @@
+/*********************                                                        */
+/*! \file Test_ThreadPool.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief [[ Add one-line brief description here ]]
+ **
+ ** [[ Add lengthier description here ]]
+ **/
+
+#include "ThreadPool.h"
+
+#include <atomic>
+#include <cxxtest/TestSuite.h>
+#include <stdexcept>
+#include <vector>
+
+class ThreadPoolTestSuite : public CxxTest::TestSuite
+{
+public:
+    void test_every_index_runs_once()
+    {
+        for ( unsigned workers = 1; workers <= 4; ++workers )
+        {
+            ThreadPool pool( workers );
+            TS_ASSERT_EQUALS( pool.getNumberOfWorkers(), workers );
+
+            for ( unsigned count : { 0u, 1u, 3u, 100u } )
+            {
+                std::vector<std::atomic_uint> hits( count );
+                for ( auto &hit : hits )
+                    hit = 0;
+
+                std::atomic_bool workerInRange( true );
+                TS_ASSERT_THROWS_NOTHING( pool.parallelFor( count, [&]( unsigned i, unsigned w ) {
+                    ++hits[i];
+                    if ( w >= workers )
+                        workerInRange = false;
+                } ) );
+
+                for ( unsigned i = 0; i < count; ++i )
+                    TS_ASSERT_EQUALS( hits[i].load(), 1u );
+                TS_ASSERT( workerInRange.load() );
+            }
+        }
+    }
+
+    void test_zero_workers_means_one()
+    {
+        ThreadPool pool( 0 );
+        TS_ASSERT_EQUALS( pool.getNumberOfWorkers(), 1u );
+
+        unsigned sum = 0;
+        pool.parallelFor( 10, [&]( unsigned i, unsigned w ) {
+            TS_ASSERT_EQUALS( w, 0u );
+            sum += i;
+        } );
+        TS_ASSERT_EQUALS( sum, 45u );
+    }
+
+    void test_nested_calls_run_on_the_calling_worker()
+    {
+        ThreadPool pool( 3 );
+        std::vector<std::atomic_uint> hits( 8 * 8 );
+        for ( auto &hit : hits )
+            hit = 0;
+
+        std::atomic_bool sameWorker( true );
+        pool.parallelFor( 8, [&]( unsigned i, unsigned outerWorker ) {
+            pool.parallelFor( 8, [&]( unsigned j, unsigned innerWorker ) {
+                ++hits[i * 8 + j];
+                if ( innerWorker != outerWorker )
+                    sameWorker = false;
+            } );
+        } );
+
+        for ( const auto &hit : hits )
+            TS_ASSERT_EQUALS( hit.load(), 1u );
+        TS_ASSERT( sameWorker.load() );
+    }
+
+    void test_exception_of_smallest_index_is_rethrown()
+    {
+        ThreadPool pool( 4 );
+        std::atomic_uint done( 0 );
+
+        try
+        {
+            pool.parallelFor( 50, [&]( unsigned i, unsigned ) {
+                ++done;
+                if ( i % 10 == 7 )
+                    throw std::runtime_error( std::to_string( i ) );
+            } );
+            TS_ASSERT( false );
+        }
+        catch ( const std::runtime_error &e )
+        {
+            TS_ASSERT_EQUALS( std::string( e.what() ), "7" );
+        }
+
+        // All the other tasks still ran, and the pool is still usable
+        TS_ASSERT_EQUALS( done.load(), 50u );
+
+        std::atomic_uint count( 0 );
+        pool.parallelFor( 20, [&]( unsigned, unsigned ) { ++count; } );
+        TS_ASSERT_EQUALS( count.load(), 20u );
+    }
+};
@@ -64,6 +64,7 @@ const unsigned GlobalConfiguration::INTERVAL_SPLITTING_FREQUENCY = 10;
 const unsigned GlobalConfiguration::INTERVAL_SPLITTING_THRESHOLD = 10;
 const unsigned GlobalConfiguration::BOUND_TIGHTENING_ON_CONSTRAINT_MATRIX_FREQUENCY = 100;
 const unsigned GlobalConfiguration::ROW_BOUND_TIGHTENER_SATURATION_ITERATIONS = 20;
+const unsigned GlobalConfiguration::MIN_ROW_LENGTH_FOR_VECTORIZED_BOUNDS = 16;
 const double GlobalConfiguration::COST_FUNCTION_ERROR_THRESHOLD = 0.0000000001;
 
 const unsigned GlobalConfiguration::SIMULATION_RANDOM_SEED = 1;
@@ -75,6 +76,11 @@ const unsigned GlobalConfiguration::PREIMAGE_APPROXIMATION_OPTIMIZATION_MAX_ITER
 const double GlobalConfiguration::PREIMAGE_APPROXIMATION_OPTIMIZATION_STEP_SIZE = 0.025;
 const double GlobalConfiguration::PREIMAGE_APPROXIMATION_OPTIMIZATION_LEARNING_RATE = 0.25;
 const double GlobalConfiguration::PREIMAGE_APPROXIMATION_OPTIMIZATION_WEIGHT_DECAY = 0;
+const bool GlobalConfiguration::PREIMAGE_APPROXIMATION_OPTIMIZATION_USE_ADAM = false;
+const double GlobalConfiguration::PREIMAGE_APPROXIMATION_OPTIMIZATION_ADAM_BETA1 = 0.9;
+const double GlobalConfiguration::PREIMAGE_APPROXIMATION_OPTIMIZATION_ADAM_BETA2 = 0.999;
+const double GlobalConfiguration::PREIMAGE_APPROXIMATION_OPTIMIZATION_ADAM_EPSILON = 0.00000001;
+const bool GlobalConfiguration::PREIMAGE_APPROXIMATION_OPTIMIZATION_INCREMENTAL_GRADIENT = false;
 
 const unsigned GlobalConfiguration::INVPROP_MAX_ITERATIONS = 10;
 const double GlobalConfiguration::INVPROP_STEP_SIZE = 0.025;
@@ -93,6 +99,10 @@ const double GlobalConfiguration::LP_TIGHTENING_ROUNDING_CONSTANT = 0.00000001;
 
 const double GlobalConfiguration::SIGMOID_CUTOFF_CONSTANT = 20;
 
+const bool GlobalConfiguration::DEEP_POLY_DEMAND_DRIVEN_BACK_SUBSTITUTION = false;
+
+const unsigned GlobalConfiguration::NLR_BOUND_CACHE_MAX_ENTRIES = 256;
+
 const bool GlobalConfiguration::PREPROCESS_INPUT_QUERY = true;
 const bool GlobalConfiguration::PREPROCESSOR_ELIMINATE_VARIABLES = true;
 const bool GlobalConfiguration::PL_CONSTRAINTS_ADD_AUX_EQUATIONS_AFTER_PREPROCESSING = true;
@@ -122,6 +132,12 @@ const bool GlobalConfiguration::EXPLICIT_BOUND_TIGHTENING_UNTIL_SATURATION = fal
 const double GlobalConfiguration::EXPLICIT_BASIS_BOUND_TIGHTENING_ROUNDING_CONSTANT = 1e-6;
 
 const unsigned GlobalConfiguration::REFACTORIZATION_THRESHOLD = 100;
+const bool GlobalConfiguration::USE_ADAPTIVE_REFACTORIZATION = true;
+const bool GlobalConfiguration::ADAPTIVE_REFACTORIZATION_USE_MEASURED_TIME = false;
+const unsigned GlobalConfiguration::ADAPTIVE_REFACTORIZATION_MIN_INTERVAL = 10;
+const unsigned GlobalConfiguration::ADAPTIVE_REFACTORIZATION_MAX_INTERVAL = 400;
+const double GlobalConfiguration::ADAPTIVE_REFACTORIZATION_SMOOTHING_FACTOR = 0.1;
+const double GlobalConfiguration::ADAPTIVE_REFACTORIZATION_MAX_ETA_FILL_RATIO = 2.0;
 const GlobalConfiguration::BasisFactorizationType GlobalConfiguration::BASIS_FACTORIZATION_TYPE =
     GlobalConfiguration::SPARSE_FORREST_TOMLIN_FACTORIZATION;
 
@@ -129,6 +145,7 @@ const unsigned GlobalConfiguration::BABSR_CANDIDATES_THRESHOLD = 5;
 const unsigned GlobalConfiguration::POLARITY_CANDIDATES_THRESHOLD = 5;
 
 const unsigned GlobalConfiguration::DNC_DEPTH_THRESHOLD = 5;
+const bool GlobalConfiguration::DNC_SCORE_INPUT_BISECTIONS = true;
 
 const double GlobalConfiguration::MINIMAL_COEFFICIENT_FOR_TIGHTENING = 0.01;
 const double GlobalConfiguration::LEMMA_CERTIFICATION_TOLERANCE = 0.000001;
@@ -198,6 +215,7 @@ void GlobalConfiguration::print()
     printf( "  MAX_SIMPLEX_PIVOT_SEARCH_ITERATIONS: %u\n", MAX_SIMPLEX_PIVOT_SEARCH_ITERATIONS );
     printf( "  BOUND_TIGHTENING_ON_CONSTRAINT_MATRIX_FREQUENCY: %u\n",
             BOUND_TIGHTENING_ON_CONSTRAINT_MATRIX_FREQUENCY );
+    printf( "  MIN_ROW_LENGTH_FOR_VECTORIZED_BOUNDS: %u\n", MIN_ROW_LENGTH_FOR_VECTORIZED_BOUNDS );
     printf( "  COST_FUNCTION_ERROR_THRESHOLD: %.15lf\n", COST_FUNCTION_ERROR_THRESHOLD );
     printf( "  USE_HARRIS_RATIO_TEST: %s\n", USE_HARRIS_RATIO_TEST ? "Yes" : "No" );
 
@@ -229,6 +247,17 @@ void GlobalConfiguration::print()
     printf( "  EXPLICIT_BOUND_TIGHTENING_UNTIL_SATURATION: %s\n",
             EXPLICIT_BOUND_TIGHTENING_UNTIL_SATURATION ? "Yes" : "No" );
     printf( "  REFACTORIZATION_THRESHOLD: %u\n", REFACTORIZATION_THRESHOLD );
+    printf( "  USE_ADAPTIVE_REFACTORIZATION: %s\n", USE_ADAPTIVE_REFACTORIZATION ? "Yes" : "No" );
+    printf( "  ADAPTIVE_REFACTORIZATION_USE_MEASURED_TIME: %s\n",
+            ADAPTIVE_REFACTORIZATION_USE_MEASURED_TIME ? "Yes" : "No" );
+    printf( "  ADAPTIVE_REFACTORIZATION_MIN_INTERVAL: %u\n",
+            ADAPTIVE_REFACTORIZATION_MIN_INTERVAL );
+    printf( "  ADAPTIVE_REFACTORIZATION_MAX_INTERVAL: %u\n",
+            ADAPTIVE_REFACTORIZATION_MAX_INTERVAL );
+    printf( "  ADAPTIVE_REFACTORIZATION_SMOOTHING_FACTOR: %.15lf\n",
+            ADAPTIVE_REFACTORIZATION_SMOOTHING_FACTOR );
+    printf( "  ADAPTIVE_REFACTORIZATION_MAX_ETA_FILL_RATIO: %.15lf\n",
+            ADAPTIVE_REFACTORIZATION_MAX_ETA_FILL_RATIO );
 
     String basisFactorizationType;
     if ( GlobalConfiguration::BASIS_FACTORIZATION_TYPE == GlobalConfiguration::LU_FACTORIZATION )
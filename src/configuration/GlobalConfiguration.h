@@ -145,6 +145,10 @@ public:
     // due to tiny increments in bounds. This number limits the number of iterations it can perform.
     static const unsigned ROW_BOUND_TIGHTENER_SATURATION_ITERATIONS;
 
+    // Rows with fewer entries than this have their bounds computed by a plain loop, rather than
+    // being unpacked for the vectorized row bound kernels
+    static const unsigned MIN_ROW_LENGTH_FOR_VECTORIZED_BOUNDS;
+
     // If the cost function error exceeds this threshold, it is recomputed
     static const double COST_FUNCTION_ERROR_THRESHOLD;
 
@@ -172,6 +176,18 @@ public:
     // Weight decay for PreimageApproximation optimization.
     static const double PREIMAGE_APPROXIMATION_OPTIMIZATION_WEIGHT_DECAY;
 
+    // Whether PreimageApproximation optimization takes Adam steps, rather than plain projected
+    // gradient steps, and the decay rates and epsilon of Adam's moment estimates.
+    static const bool PREIMAGE_APPROXIMATION_OPTIMIZATION_USE_ADAM;
+    static const double PREIMAGE_APPROXIMATION_OPTIMIZATION_ADAM_BETA1;
+    static const double PREIMAGE_APPROXIMATION_OPTIMIZATION_ADAM_BETA2;
+    static const double PREIMAGE_APPROXIMATION_OPTIMIZATION_ADAM_EPSILON;
+
+    // Whether PreimageApproximation optimization estimates each partial derivative by only
+    // re-propagating the layers from the parameter's layer onwards. Symbolic bound propagation
+    // tightens bounds as a side effect, so this may lead to different (equally sound) bounds.
+    static const bool PREIMAGE_APPROXIMATION_OPTIMIZATION_INCREMENTAL_GRADIENT;
+
     // Maximum iterations for INVPROP optimization.
     static const unsigned INVPROP_MAX_ITERATIONS;
 
@@ -246,6 +262,16 @@ public:
 
     static const double SIGMOID_CUTOFF_CONSTANT;
 
+    // If true, DeepPoly back-substitutes only the neurons whose bounds matter: those of the last
+    // weighted sum layer, and, if these are inconclusive, those feeding an activation whose
+    // relaxation depends on its input bounds (e.g., an unstable ReLU). The other neurons are
+    // bounded in terms of their immediate predecessors only.
+    static const bool DEEP_POLY_DEMAND_DRIVEN_BACK_SUBSTITUTION;
+
+    // The maximal number of entries kept by the bound cache (see --bound-cache); the oldest
+    // entries are evicted first.
+    static const unsigned NLR_BOUND_CACHE_MAX_ENTRIES;
+
     /*
       Constraint fixing heuristics
     */
@@ -265,6 +291,29 @@ public:
     // The number of accumualted eta matrices, after which the basis will be refactorized
     static const unsigned REFACTORIZATION_THRESHOLD;
 
+    // If true, the sparse Forrest-Tomlin factorization decides when to refactorize adaptively:
+    // it compares the cost of the last refactorization with the projected cost of continuing to
+    // solve with the growing eta file, and refactorizes at the break-even point.
+    static const bool USE_ADAPTIVE_REFACTORIZATION;
+
+    // How the adaptive refactorization measures costs. If false (the default), the cost of a
+    // refactorization is the number of non-zeros in the basis and its LU factors, and the cost of
+    // a transformation is the number of non-zeros in the factors and the eta file it passes
+    // through. This is a deterministic proxy, so that a run always refactorizes at the same
+    // points. If true, wall-clock time is measured instead, which tracks the actual costs more
+    // closely but makes runs non-reproducible.
+    static const bool ADAPTIVE_REFACTORIZATION_USE_MEASURED_TIME;
+
+    // The minimal and maximal number of basis updates between two adaptive refactorizations
+    static const unsigned ADAPTIVE_REFACTORIZATION_MIN_INTERVAL;
+    static const unsigned ADAPTIVE_REFACTORIZATION_MAX_INTERVAL;
+
+    // The weight of the latest sample in the moving average of the transformation cost
+    static const double ADAPTIVE_REFACTORIZATION_SMOOTHING_FACTOR;
+
+    // Refactorize once the eta file holds this many times more non-zeros than the LU factors
+    static const double ADAPTIVE_REFACTORIZATION_MAX_ETA_FILL_RATIO;
+
     // The kind of basis factorization algorithm in use
     enum BasisFactorizationType {
         LU_FACTORIZATION,
@@ -288,6 +337,12 @@ public:
      */
     static const unsigned DNC_DEPTH_THRESHOLD;
 
+    /* If true, the largest-interval input splitter bisects the input dimension that tightens the
+       output bounds the most, as estimated by batched bound propagation over all the candidate
+       bisections, rather than the dimension with the largest interval.
+     */
+    static const bool DNC_SCORE_INPUT_BISECTIONS;
+
     /* Minimal coefficient of a variable in a Tableau row, that is used for bound tightening
      */
     static const double MINIMAL_COEFFICIENT_FOR_TIGHTENING;
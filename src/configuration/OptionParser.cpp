@@ -110,6 +110,12 @@ void OptionParser::initialize()
         boost::program_options::value<std::string>( &( *_stringOptions )[Options::QUERY_DUMP_FILE] )
             ->default_value( ( *_stringOptions )[Options::QUERY_DUMP_FILE] ),
         "Dump the verification query in Marabou's input query format." )(
+        "bound-cache",
+        boost::program_options::value<std::string>(
+            &( ( *_stringOptions )[Options::BOUND_CACHE_FILE] ) )
+            ->default_value( ( *_stringOptions )[Options::BOUND_CACHE_FILE] ),
+        "Cache the bounds computed by the network level reasoner in this file, and reuse them "
+        "for later queries on the same network whose input box is contained in a cached one." )(
         "summary-file",
         boost::program_options::value<std::string>(
             &( ( *_stringOptions )[Options::SUMMARY_FILE] ) )
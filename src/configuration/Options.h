@@ -155,7 +155,11 @@ public:
         SOI_INITIALIZATION_STRATEGY,
 
         // The procedure/solver for solving the LP
-        LP_SOLVER
+        LP_SOLVER,
+
+        // The file in which the bounds computed by the network level
+        // reasoner are cached across runs
+        BOUND_CACHE_FILE,
     };
 
     /*
@@ -17,7 +17,9 @@
 
 #include "Debug.h"
 #include "FloatUtils.h"
+#include "GlobalConfiguration.h"
 #include "MarabouError.h"
+#include "RowBoundKernels.h"
 #include "Tableau.h"
 #include "Tightening.h"
 
@@ -514,23 +516,46 @@ unsigned BoundManager::getInconsistentVariable() const
 double BoundManager::computeRowBound( const TableauRow &row, const bool isUpper ) const
 {
     double bound = 0;
-    double multiplier;
-    unsigned var;
 
+    /*
+      Short rows are not worth unpacking for the vectorized kernels
+    */
+    if ( row._size < GlobalConfiguration::MIN_ROW_LENGTH_FOR_VECTORIZED_BOUNDS )
+    {
+        double multiplier;
+        unsigned var;
+
+        for ( unsigned i = 0; i < row._size; ++i )
+        {
+            var = row._row[i]._var;
+            if ( FloatUtils::isZero( row[i] ) )
+                continue;
+
+            multiplier = ( isUpper && FloatUtils::isPositive( row[i] ) ) ||
+                                 ( !isUpper && FloatUtils::isNegative( row[i] ) )
+                           ? _upperBounds[var]
+                           : _lowerBounds[var];
+            multiplier = FloatUtils::isZero( multiplier ) ? 0 : multiplier * row[i];
+            bound += FloatUtils::isZero( multiplier ) ? 0 : multiplier;
+        }
+
+        bound += FloatUtils::isZero( row._scalar ) ? 0 : row._scalar;
+        return bound;
+    }
+
+    ensureRowScratchSize( row._size );
+
+    double *coefficients = _rowCoefficients.data();
+    unsigned *indices = _rowIndices.data();
     for ( unsigned i = 0; i < row._size; ++i )
     {
-        var = row._row[i]._var;
-        if ( FloatUtils::isZero( row[i] ) )
-            continue;
-
-        multiplier = ( isUpper && FloatUtils::isPositive( row[i] ) ) ||
-                             ( !isUpper && FloatUtils::isNegative( row[i] ) )
-                       ? _upperBounds[var]
-                       : _lowerBounds[var];
-        multiplier = FloatUtils::isZero( multiplier ) ? 0 : multiplier * row[i];
-        bound += FloatUtils::isZero( multiplier ) ? 0 : multiplier;
+        coefficients[i] = row._row[i]._coefficient;
+        indices[i] = row._row[i]._var;
     }
 
+    bound = RowBoundKernels::computeRowBound(
+        row._size, coefficients, indices, _lowerBounds, _upperBounds, isUpper );
+
     bound += FloatUtils::isZero( row._scalar ) ? 0 : row._scalar;
     return bound;
 }
@@ -541,12 +566,7 @@ double BoundManager::computeSparseRowBound( const SparseUnsortedList &row,
 {
     ASSERT( !row.empty() && var < _size );
 
-    unsigned curVar;
     double ci = 0;
-    double bound = 0;
-    double realCoefficient;
-    double curVal;
-    double multiplier;
 
     for ( const auto &entry : row )
     {
@@ -559,27 +579,61 @@ double BoundManager::computeSparseRowBound( const SparseUnsortedList &row,
 
     ASSERT( !FloatUtils::isZero( ci ) );
 
-    for ( const auto &entry : row )
+    if ( row.getNnz() < GlobalConfiguration::MIN_ROW_LENGTH_FOR_VECTORIZED_BOUNDS )
     {
-        curVar = entry._index;
-        curVal = entry._value;
+        double bound = 0;
+        double realCoefficient;
+        double multiplier;
 
-        if ( FloatUtils::isZero( curVal ) || curVar == var )
-            continue;
+        for ( const auto &entry : row )
+        {
+            if ( FloatUtils::isZero( entry._value ) || entry._index == var )
+                continue;
 
-        realCoefficient = curVal / -ci;
+            realCoefficient = entry._value / -ci;
 
-        if ( FloatUtils::isZero( realCoefficient ) )
-            continue;
+            if ( FloatUtils::isZero( realCoefficient ) )
+                continue;
 
-        multiplier = ( isUpper && realCoefficient > 0 ) || ( !isUpper && realCoefficient < 0 )
-                       ? _upperBounds[curVar]
-                       : _lowerBounds[curVar];
-        multiplier = FloatUtils::isZero( multiplier ) ? 0 : multiplier * realCoefficient;
-        bound += FloatUtils::isZero( multiplier ) ? 0 : multiplier;
+            multiplier = ( isUpper && realCoefficient > 0 ) || ( !isUpper && realCoefficient < 0 )
+                           ? _upperBounds[entry._index]
+                           : _lowerBounds[entry._index];
+            multiplier = FloatUtils::isZero( multiplier ) ? 0 : multiplier * realCoefficient;
+            bound += FloatUtils::isZero( multiplier ) ? 0 : multiplier;
+        }
+
+        return bound;
     }
 
-    return bound;
+    /*
+      Isolate var, i.e. divide the row by -ci. The entry of var itself,
+      as well as any zero entries, get a zero coefficient and are ignored
+      by the kernel.
+    */
+    ensureRowScratchSize( row.getNnz() );
+
+    double *coefficients = _rowCoefficients.data();
+    unsigned *indices = _rowIndices.data();
+    unsigned count = 0;
+    for ( const auto &entry : row )
+    {
+        bool ignore = FloatUtils::isZero( entry._value ) || entry._index == var;
+        coefficients[count] = ignore ? 0 : entry._value / -ci;
+        indices[count] = entry._index;
+        ++count;
+    }
+
+    return RowBoundKernels::computeRowBound(
+        count, coefficients, indices, _lowerBounds, _upperBounds, isUpper );
+}
+
+void BoundManager::ensureRowScratchSize( unsigned size ) const
+{
+    if ( _rowCoefficients.size() < size )
+    {
+        _rowCoefficients.assign( size, 0 );
+        _rowIndices.assign( size, 0 );
+    }
 }
 
 bool BoundManager::isExplanationTrivial( unsigned var, bool isUpper ) const
@@ -236,6 +236,13 @@ private:
     Vector<CVC4::context::CDO<bool> *> _tightenedLower;
     Vector<CVC4::context::CDO<bool> *> _tightenedUpper;
 
+    /*
+      Scratch space into which rows are unpacked before their bounds are
+      computed by the vectorized row bound kernels
+    */
+    mutable Vector<double> _rowCoefficients;
+    mutable Vector<unsigned> _rowIndices;
+
     /*
        Record first tightening that violates bounds
      */
@@ -243,6 +250,8 @@ private:
 
     void allocateLocalBounds( unsigned size );
 
+    void ensureRowScratchSize( unsigned size ) const;
+
     /*
       Tighten bounds and update their explanations according to some object representing the row
      */
@@ -104,14 +104,14 @@ void ConstraintMatrixAnalyzer::analyze( const double *matrix, unsigned m, unsign
     gaussianElimination();
 }
 
-void ConstraintMatrixAnalyzer::analyze( const SparseUnsortedList **matrix, unsigned m, unsigned n )
+void ConstraintMatrixAnalyzer::analyze( const SparseSpan *rows, unsigned m, unsigned n )
 {
     freeMemoryIfNeeded();
 
     _m = m;
     _n = n;
 
-    _A.initialize( matrix, m, n );
+    _A.initialize( rows, m, n );
     _A.transposeIntoOther( &_At );
 
     allocateMemory();
@@ -34,7 +34,7 @@ public:
       (in)dependent columns and rows
     */
     void analyze( const double *matrix, unsigned m, unsigned n );
-    void analyze( const SparseUnsortedList **matrix, unsigned m, unsigned n );
+    void analyze( const SparseSpan *rows, unsigned m, unsigned n );
     List<unsigned> getIndependentColumns() const;
     Set<unsigned> getRedundantRows() const;
 
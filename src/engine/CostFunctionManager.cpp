@@ -29,7 +29,6 @@ CostFunctionManager::CostFunctionManager( ITableau *tableau )
     , _n( 0 )
     , _m( 0 )
     , _costFunctionStatus( COST_FUNCTION_INVALID )
-    , _ANColumn( NULL )
 {
 }
 
@@ -310,9 +309,7 @@ void CostFunctionManager::computeReducedCosts()
 void CostFunctionManager::computeReducedCost( unsigned nonBasic )
 {
     unsigned nonBasicIndex = _tableau->nonBasicIndexToVariable( nonBasic );
-    _ANColumn = _tableau->getSparseAColumn( nonBasicIndex );
-
-    for ( const auto &entry : *_ANColumn )
+    for ( const auto &entry : _tableau->getSparseAColumn( nonBasicIndex ) )
         _costFunction[nonBasic] -= ( _multipliers[entry._index] * entry._value );
 }
 
@@ -122,11 +122,6 @@ private:
     */
     CostFunctionStatus _costFunctionStatus;
 
-    /*
-      Work memeory
-    */
-    const SparseUnsortedList *_ANColumn;
-
     /*
       Free memory.
     */
@@ -388,6 +388,7 @@ bool DnCManager::createEngines( unsigned numberOfEngines )
     {
         auto engine = std::make_shared<Engine>();
         engine->setVerbosity( 0 );
+        engine->shareInitialTableau( *_baseEngine );
         _engines.append( engine );
     }
 
@@ -423,8 +424,8 @@ void DnCManager::initialDivide( SubQueries &subQueries )
     else // Default is LargestInterval
     {
         const List<unsigned> inputVariables( _baseEngine->getInputVariables() );
-        queryDivider =
-            std::unique_ptr<QueryDivider>( new LargestIntervalDivider( inputVariables ) );
+        queryDivider = std::unique_ptr<QueryDivider>(
+            new LargestIntervalDivider( inputVariables, _baseEngine->getNetworkLevelReasoner() ) );
         Query *inputQuery = _baseEngine->getQuery();
         // Add bound as equations for each input variable
         for ( const auto &variable : inputVariables )
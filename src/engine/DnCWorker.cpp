@@ -69,8 +69,8 @@ void DnCWorker::setQueryDivider( SnCDivideStrategy divideStrategy )
     else
     {
         const List<unsigned> &inputVariables = _engine->getInputVariables();
-        _queryDivider =
-            std::unique_ptr<LargestIntervalDivider>( new LargestIntervalDivider( inputVariables ) );
+        _queryDivider = std::unique_ptr<LargestIntervalDivider>(
+            new LargestIntervalDivider( inputVariables, _engine->getNetworkLevelReasoner() ) );
     }
 }
 
@@ -20,6 +20,7 @@
 #include "Debug.h"
 #include "DisjunctionConstraint.h"
 #include "EngineState.h"
+#include "IFile.h"
 #include "InfeasibleQueryException.h"
 #include "MStringf.h"
 #include "MalformedBasisException.h"
@@ -934,10 +935,12 @@ bool Engine::calculateBounds( const IQuery &inputQuery )
 
         initializeNetworkLevelReasoning();
 
+        applyCachedBounds();
         performSymbolicBoundTightening( &( *_preprocessedQuery ) );
         performSimulation();
         performMILPSolverBoundedTightening( &( *_preprocessedQuery ) );
         performAdditionalBackwardAnalysisIfNeeded();
+        storeBoundsInCache();
 
         if ( _networkLevelReasoner && Options::get()->getBool( Options::DUMP_BOUNDS ) )
             _networkLevelReasoner->dumpBounds();
@@ -1337,8 +1340,11 @@ void Engine::initializeTableau( const double *constraintMatrix, const List<unsig
         ++equationIndex;
     }
 
-    // Populate constraint matrix
-    _tableau->setConstraintMatrix( constraintMatrix );
+    // Populate constraint matrix, unless it is shared with another engine
+    if ( constraintMatrix )
+        _tableau->setConstraintMatrix( constraintMatrix );
+    else
+        _tableau->setConstraintMatrix( _sharedConstraintMatrix );
 
     _tableau->registerToWatchAllVariables( _rowBoundTightener );
     _tableau->registerResizeWatcher( _rowBoundTightener );
@@ -1348,6 +1354,7 @@ void Engine::initializeTableau( const double *constraintMatrix, const List<unsig
     initializeBoundsAndConstraintWatchersInTableau( n );
 
     _tableau->initializeTableau( initialBasis );
+    _initialBasis = initialBasis;
 
     _costFunctionManager->initialize();
     _tableau->registerCostFunctionManager( _costFunctionManager );
@@ -1404,6 +1411,26 @@ void Engine::initializeNetworkLevelReasoning()
     }
 }
 
+void Engine::shareInitialTableau( const Engine &other )
+{
+    if ( other._lpSolverType != LPSolverType::NATIVE || other._initialBasis.empty() )
+        return;
+
+    _sharedConstraintMatrix = other._tableau->getSharedConstraintMatrix();
+    _sharedInitialBasis = other._initialBasis;
+}
+
+bool Engine::canUseSharedInitialTableau() const
+{
+    if ( !_sharedConstraintMatrix || _lpSolverType != LPSolverType::NATIVE || _produceUNSATProofs )
+        return false;
+
+    // The input query should be the preprocessed query of the other
+    // engine, which already includes the auxiliary equations and variables
+    return _preprocessedQuery->getEquations().size() == _sharedConstraintMatrix->getM() &&
+           _preprocessedQuery->getNumberOfVariables() == _sharedConstraintMatrix->getN();
+}
+
 bool Engine::processInputQuery( const IQuery &inputQuery, bool preprocess )
 {
     ENGINE_LOG( "processInputQuery starting\n" );
@@ -1417,17 +1444,28 @@ bool Engine::processInputQuery( const IQuery &inputQuery, bool preprocess )
         initializeNetworkLevelReasoning();
         if ( preprocess )
         {
+            applyCachedBounds();
             performSymbolicBoundTightening( &( *_preprocessedQuery ) );
             performSimulation();
             performMILPSolverBoundedTightening( &( *_preprocessedQuery ) );
             performAdditionalBackwardAnalysisIfNeeded();
+            storeBoundsInCache();
         }
 
-        if ( GlobalConfiguration::PL_CONSTRAINTS_ADD_AUX_EQUATIONS_AFTER_PREPROCESSING )
+        bool useSharedTableau = canUseSharedInitialTableau();
+        if ( !useSharedTableau )
+        {
+            _sharedConstraintMatrix = nullptr;
+            _sharedInitialBasis.clear();
+        }
+
+        if ( GlobalConfiguration::PL_CONSTRAINTS_ADD_AUX_EQUATIONS_AFTER_PREPROCESSING &&
+             !useSharedTableau )
             for ( auto &plConstraint : _preprocessedQuery->getPiecewiseLinearConstraints() )
                 plConstraint->addAuxiliaryEquationsAfterPreprocessing( *_preprocessedQuery );
 
-        if ( GlobalConfiguration::NL_CONSTRAINTS_ADD_AUX_EQUATIONS_AFTER_PREPROCESSING )
+        if ( GlobalConfiguration::NL_CONSTRAINTS_ADD_AUX_EQUATIONS_AFTER_PREPROCESSING &&
+             !useSharedTableau )
             for ( auto &nlConstraint : _preprocessedQuery->getNonlinearConstraints() )
                 nlConstraint->addAuxiliaryEquationsAfterPreprocessing( *_preprocessedQuery );
 
@@ -1450,7 +1488,21 @@ bool Engine::processInputQuery( const IQuery &inputQuery, bool preprocess )
             }
         }
 
-        if ( _lpSolverType == LPSolverType::NATIVE )
+        if ( _lpSolverType == LPSolverType::NATIVE && useSharedTableau )
+        {
+            storeEquationsInDegradationChecker();
+
+            unsigned n = _preprocessedQuery->getNumberOfVariables();
+            _boundManager.initialize( n );
+
+            initializeTableau( NULL, _sharedInitialBasis );
+            _boundManager.initializeBoundExplainer( n, _tableau->getM() );
+
+            // The tableau holds on to the matrix for as long as it needs it
+            _sharedConstraintMatrix = nullptr;
+            _sharedInitialBasis.clear();
+        }
+        else if ( _lpSolverType == LPSolverType::NATIVE )
         {
             double *constraintMatrix = createConstraintMatrix();
             removeRedundantEquations( constraintMatrix );
@@ -2421,6 +2473,11 @@ List<unsigned> Engine::getInputVariables() const
     return _preprocessedQuery->getInputVariables();
 }
 
+const NLR::NetworkLevelReasoner *Engine::getNetworkLevelReasoner() const
+{
+    return _networkLevelReasoner;
+}
+
 void Engine::performSimulation()
 {
     if ( _simulationSize == 0 || !_networkLevelReasoner ||
@@ -2534,6 +2591,74 @@ unsigned Engine::performSymbolicBoundTightening( Query *inputQuery )
     return numTightenedBounds;
 }
 
+void Engine::applyCachedBounds()
+{
+    String path = Options::get()->getString( Options::BOUND_CACHE_FILE );
+    if ( path == "" || !_networkLevelReasoner || _produceUNSATProofs )
+        return;
+
+    if ( !_boundCache )
+    {
+        _boundCache = std::unique_ptr<NLR::BoundCache>( new NLR::BoundCache );
+        if ( IFile::exists( path ) )
+        {
+            try
+            {
+                _boundCache->load( path );
+            }
+            catch ( const NLRError &e )
+            {
+                printf( "Warning: ignoring the bound cache: %s\n", e.getUserMessage() );
+                _boundCache->clear();
+            }
+        }
+    }
+
+    _networkLevelReasoner->obtainCurrentBounds( *_preprocessedQuery );
+    _networkLevelReasoner->clearConstraintTightenings();
+    unsigned numberOfEntries = _networkLevelReasoner->applyCachedBounds( *_boundCache );
+
+    List<Tightening> tightenings;
+    _networkLevelReasoner->getConstraintTightenings( tightenings );
+
+    unsigned numTightenedBounds = 0;
+    for ( const auto &tightening : tightenings )
+    {
+        if ( tightening._type == Tightening::LB &&
+             FloatUtils::gt( tightening._value,
+                             _preprocessedQuery->getLowerBound( tightening._variable ) ) )
+        {
+            _preprocessedQuery->setLowerBound( tightening._variable, tightening._value );
+            ++numTightenedBounds;
+        }
+
+        if ( tightening._type == Tightening::UB &&
+             FloatUtils::lt( tightening._value,
+                             _preprocessedQuery->getUpperBound( tightening._variable ) ) )
+        {
+            _preprocessedQuery->setUpperBound( tightening._variable, tightening._value );
+            ++numTightenedBounds;
+        }
+    }
+
+    if ( _verbosity > 0 )
+        printf( "Bound cache: applied %u cached entries, tightened %u bounds\n",
+                numberOfEntries,
+                numTightenedBounds );
+}
+
+void Engine::storeBoundsInCache()
+{
+    if ( !_boundCache || !_networkLevelReasoner || _produceUNSATProofs )
+        return;
+
+    _networkLevelReasoner->obtainCurrentBounds( *_preprocessedQuery );
+    _networkLevelReasoner->storeBoundsInCache(
+        *_boundCache,
+        _symbolicBoundTighteningType == SymbolicBoundTighteningType::SYMBOLIC_BOUND_TIGHTENING );
+    _boundCache->save( Options::get()->getString( Options::BOUND_CACHE_FILE ) );
+}
+
 bool Engine::shouldExitDueToTimeout( double timeout ) const
 {
     // A timeout value of 0 means no time limit
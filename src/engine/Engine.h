@@ -21,6 +21,7 @@
 #include "AutoRowBoundTightener.h"
 #include "AutoTableau.h"
 #include "BlandsRule.h"
+#include "BoundCache.h"
 #include "BoundManager.h"
 #include "Checker.h"
 #include "DantzigsRule.h"
@@ -63,6 +64,7 @@
 class EngineState;
 class Query;
 class PiecewiseLinearConstraint;
+class SparseConstraintMatrix;
 class String;
 
 
@@ -104,6 +106,17 @@ public:
     bool processInputQuery( const IQuery &inputQuery );
     bool processInputQuery( const IQuery &inputQuery, bool preprocess );
 
+    /*
+      Reuse the initial tableau of another engine, which has already
+      processed a query whose preprocessed form is the input query of
+      this engine (as is the case for the workers of a DnC run). The
+      constraint matrix is shared copy-on-write, and the redundancy
+      analysis and basis selection are skipped. Must be called before
+      processInputQuery; ignored if the dimensions do not match or if
+      proofs are produced.
+    */
+    void shareInitialTableau( const Engine &other );
+
     Query prepareSnCQuery();
     void exportQueryWithError( String errorMessage );
 
@@ -162,6 +175,11 @@ public:
     */
     List<unsigned> getInputVariables() const override;
 
+    /*
+      Get the network level reasoner, if any
+    */
+    const NLR::NetworkLevelReasoner *getNetworkLevelReasoner() const override;
+
     /*
       Add equations and tightenings from a split.
     */
@@ -381,6 +399,15 @@ private:
     */
     std::unique_ptr<Query> _preprocessedQuery;
 
+    /*
+      The constraint matrix and initial basis of another engine's
+      tableau, to be reused by processInputQuery, and the initial basis
+      of this engine's tableau.
+    */
+    std::shared_ptr<SparseConstraintMatrix> _sharedConstraintMatrix;
+    List<unsigned> _sharedInitialBasis;
+    List<unsigned> _initialBasis;
+
     /*
       Pivot selection strategies.
     */
@@ -469,6 +496,12 @@ private:
      */
     NLR::NetworkLevelReasoner *_networkLevelReasoner;
 
+    /*
+      The bounds cached across runs in the file given by --bound-cache,
+      if any. Loaded on first use.
+    */
+    std::unique_ptr<NLR::BoundCache> _boundCache;
+
     /*
       Verbosity level:
       0: print out minimal information
@@ -733,6 +766,7 @@ private:
                                          List<unsigned> &initialBasis,
                                          List<unsigned> &basicRows );
     void initializeTableau( const double *constraintMatrix, const List<unsigned> &initialBasis );
+    bool canUseSharedInitialTableau() const;
     void initializeBoundsAndConstraintWatchersInTableau( unsigned numberOfVariables );
     void initializeNetworkLevelReasoning();
     double *createConstraintMatrix();
@@ -743,6 +777,15 @@ private:
 
     void performAdditionalBackwardAnalysisIfNeeded();
 
+    /*
+      If a bound cache file is given, tighten the bounds of the
+      preprocessed query with the cached bounds that apply to it before
+      the network level reasoning starts; and once it is done, cache the
+      bounds that it computed.
+    */
+    void applyCachedBounds();
+    void storeBoundsInCache();
+
     /*
       Call MILP bound tightening for a single layer.
     */
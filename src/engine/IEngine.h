@@ -40,6 +40,10 @@ class PiecewiseLinearConstraint;
 class PLCLemma;
 class UnsatCertificateNode;
 
+namespace NLR {
+class NetworkLevelReasoner;
+}
+
 class IEngine
 {
 public:
@@ -108,6 +112,12 @@ public:
     virtual void reset() = 0;
     virtual List<unsigned> getInputVariables() const = 0;
 
+    /*
+      The network level reasoner of the preprocessed query, or nullptr if
+      there is none
+    */
+    virtual const NLR::NetworkLevelReasoner *getNetworkLevelReasoner() const = 0;
+
     /*
       Pick the piecewise linear constraint for internal splitting
     */
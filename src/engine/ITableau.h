@@ -20,14 +20,18 @@
 #include "IBoundManager.h"
 #include "List.h"
 #include "Set.h"
+#include "SparseSpan.h"
 #include "TableauStateStorageLevel.h"
 
+#include <memory>
+
 class EntrySelectionStrategy;
 class Equation;
 class GurobiWrapper;
 class IBoundManager;
 class ICostFunctionManager;
 class PiecewiseLinearCaseSplit;
+class SparseConstraintMatrix;
 class SparseMatrix;
 class SparseUnsortedList;
 class SparseVector;
@@ -163,12 +167,28 @@ public:
     virtual unsigned getM() const = 0;
     virtual unsigned getN() const = 0;
     virtual void getTableauRow( unsigned index, TableauRow *row ) = 0;
+
+    /*
+      Get a column of the constraint matrix in dense form. The column is
+      scattered into a work buffer owned by the tableau and shared between
+      calls, so the returned pointer is only valid until the next call to
+      getAColumn: callers that need two columns at once should either copy
+      the first one, or use getSparseAColumn, whose views remain valid until
+      the constraint matrix changes.
+    */
     virtual const double *getAColumn( unsigned variable ) const = 0;
-    virtual void getSparseAColumn( unsigned variable, SparseUnsortedList *result ) const = 0;
-    virtual void getSparseARow( unsigned row, SparseUnsortedList *result ) const = 0;
-    virtual const SparseUnsortedList *getSparseAColumn( unsigned variable ) const = 0;
-    virtual const SparseUnsortedList *getSparseARow( unsigned row ) const = 0;
+    virtual SparseSpan getSparseAColumn( unsigned variable ) const = 0;
+    virtual SparseSpan getSparseARow( unsigned row ) const = 0;
     virtual const SparseMatrix *getSparseA() const = 0;
+
+    /*
+      Share the constraint matrix with another tableau over the same
+      equations, e.g. between the engines of a DnC run. The matrix is
+      copied on write: the first tableau that modifies it (by adding a
+      row or merging columns) gets a private copy.
+    */
+    virtual std::shared_ptr<SparseConstraintMatrix> getSharedConstraintMatrix() const = 0;
+    virtual void setConstraintMatrix( const std::shared_ptr<SparseConstraintMatrix> &A ) = 0;
     virtual void performDegeneratePivot() = 0;
     virtual void storeState( TableauState &state, TableauStateStorageLevel level ) const = 0;
     virtual void restoreState( const TableauState &state, TableauStateStorageLevel level ) = 0;
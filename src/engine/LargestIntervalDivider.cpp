@@ -17,11 +17,16 @@
 
 #include "Debug.h"
 #include "FloatUtils.h"
+#include "GlobalConfiguration.h"
 #include "MStringf.h"
 #include "PiecewiseLinearCaseSplit.h"
 
-LargestIntervalDivider::LargestIntervalDivider( const List<unsigned> &inputVariables )
+LargestIntervalDivider::LargestIntervalDivider(
+    const List<unsigned> &inputVariables,
+    const NLR::NetworkLevelReasoner *networkLevelReasoner )
     : _inputVariables( inputVariables )
+    , _networkLevelReasoner( GlobalConfiguration::DNC_SCORE_INPUT_BISECTIONS ? networkLevelReasoner
+                                                                             : nullptr )
 {
 }
 
@@ -56,12 +61,17 @@ void LargestIntervalDivider::createSubQueries( unsigned numNewSubqueries,
     // Repeatedly bisect the dimension with the largest interval
     for ( unsigned i = 0; i < numBisects; ++i )
     {
-        List<InputRegion> newInputRegions;
-        for ( const auto &inputRegion : inputRegions )
+        Vector<unsigned> dimensionsToSplit;
+        if ( !getBestBisections( inputRegions, dimensionsToSplit ) )
         {
-            unsigned dimensionToSplit = getLargestInterval( inputRegion );
-            bisectInputRegion( inputRegion, dimensionToSplit, newInputRegions );
+            for ( const auto &inputRegion : inputRegions )
+                dimensionsToSplit.append( getLargestInterval( inputRegion ) );
         }
+
+        List<InputRegion> newInputRegions;
+        unsigned regionIndex = 0;
+        for ( const auto &inputRegion : inputRegions )
+            bisectInputRegion( inputRegion, dimensionsToSplit[regionIndex++], newInputRegions );
         inputRegions = newInputRegions;
     }
 
@@ -124,6 +134,102 @@ unsigned LargestIntervalDivider::getLargestInterval( const InputRegion &inputReg
     return dimensionToSplit;
 }
 
+bool LargestIntervalDivider::getBestBisections( const List<InputRegion> &inputRegions,
+                                                Vector<unsigned> &dimensionsToSplit )
+{
+    if ( !_networkLevelReasoner || _networkLevelReasoner->getNumberOfLayers() == 0 )
+        return false;
+
+    // The input variable of every neuron of the input layer
+    const NLR::Layer *inputLayer = _networkLevelReasoner->getLayer( 0 );
+    unsigned inputLayerSize = inputLayer->getSize();
+    Vector<unsigned> neuronToVariable;
+    for ( unsigned i = 0; i < inputLayerSize; ++i )
+        neuronToVariable.append( inputLayer->neuronToVariable( i ) );
+
+    if ( neuronToVariable.size() != _inputVariables.size() )
+        return false;
+
+    for ( const auto &variable : _inputVariables )
+    {
+        if ( !neuronToVariable.exists( variable ) )
+            return false;
+    }
+
+    // Two boxes, the lower and the upper half, per region and variable
+    Vector<Vector<double>> inputLbs;
+    Vector<Vector<double>> inputUbs;
+    for ( const auto &inputRegion : inputRegions )
+    {
+        Vector<double> lbs( inputLayerSize );
+        Vector<double> ubs( inputLayerSize );
+        for ( unsigned i = 0; i < inputLayerSize; ++i )
+        {
+            lbs[i] = inputRegion._lowerBounds[neuronToVariable[i]];
+            ubs[i] = inputRegion._upperBounds[neuronToVariable[i]];
+        }
+
+        for ( unsigned i = 0; i < inputLayerSize; ++i )
+        {
+            double middle = ( lbs[i] + ubs[i] ) / 2;
+
+            Vector<double> halfUbs( ubs );
+            halfUbs[i] = middle;
+            inputLbs.append( lbs );
+            inputUbs.append( halfUbs );
+
+            Vector<double> halfLbs( lbs );
+            halfLbs[i] = middle;
+            inputLbs.append( halfLbs );
+            inputUbs.append( ubs );
+        }
+    }
+
+    Vector<Vector<double>> outputLbs;
+    Vector<Vector<double>> outputUbs;
+    if ( !_networkLevelReasoner->batchedBoundPropagation(
+             inputLbs, inputUbs, outputLbs, outputUbs ) )
+        return false;
+
+    // Pick the bisection with the smallest total output width, breaking
+    // ties in favor of the larger interval
+    unsigned box = 0;
+    for ( const auto &inputRegion : inputRegions )
+    {
+        unsigned bestDimension = getLargestInterval( inputRegion );
+        double bestScore = FloatUtils::infinity();
+        double bestInterval = 0;
+
+        for ( unsigned i = 0; i < inputLayerSize; ++i, box += 2 )
+        {
+            unsigned variable = neuronToVariable[i];
+            double interval =
+                inputRegion._upperBounds[variable] - inputRegion._lowerBounds[variable];
+            if ( !FloatUtils::isPositive( interval ) )
+                continue;
+
+            double score = 0;
+            for ( unsigned half = box; half < box + 2; ++half )
+            {
+                for ( unsigned j = 0; j < outputLbs[half].size(); ++j )
+                    score += outputUbs[half][j] - outputLbs[half][j];
+            }
+
+            if ( FloatUtils::lt( score, bestScore ) ||
+                 ( FloatUtils::areEqual( score, bestScore ) && interval > bestInterval ) )
+            {
+                bestDimension = variable;
+                bestScore = score;
+                bestInterval = interval;
+            }
+        }
+
+        dimensionsToSplit.append( bestDimension );
+    }
+
+    return true;
+}
+
 //
 // Local Variables:
 // compile-command: "make -C ../.. "
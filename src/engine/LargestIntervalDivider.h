@@ -17,6 +17,7 @@
 #define __LargestIntervalDivider_h__
 
 #include "List.h"
+#include "NetworkLevelReasoner.h"
 #include "QueryDivider.h"
 
 #include <math.h>
@@ -24,7 +25,14 @@
 class LargestIntervalDivider : public QueryDivider
 {
 public:
-    LargestIntervalDivider( const List<unsigned> &inputVariables );
+    /*
+      If a network level reasoner is given, and
+      GlobalConfiguration::DNC_SCORE_INPUT_BISECTIONS is set, each region is
+      bisected along the dimension that tightens the output bounds the
+      most, instead of the one with the largest interval.
+    */
+    LargestIntervalDivider( const List<unsigned> &inputVariables,
+                            const NLR::NetworkLevelReasoner *networkLevelReasoner = nullptr );
 
     void createSubQueries( unsigned numNewSubQueries,
                            const String queryIdPrefix,
@@ -38,11 +46,22 @@ public:
     */
     unsigned getLargestInterval( const InputRegion &inputRegion );
 
+    /*
+      For every region, the variable whose bisection minimizes the total
+      width of the output bounds of the two halves. Every candidate
+      bisection of every region is propagated in a single batch. Returns
+      false if the network does not support batched propagation.
+    */
+    bool getBestBisections( const List<InputRegion> &inputRegions,
+                            Vector<unsigned> &dimensionsToSplit );
+
 private:
     /*
       All input variables of the network
     */
     const List<unsigned> _inputVariables;
+
+    const NLR::NetworkLevelReasoner *_networkLevelReasoner;
 };
 
 #endif // __LargestIntervalDivider_h__
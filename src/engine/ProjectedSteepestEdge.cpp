@@ -28,7 +28,6 @@ ProjectedSteepestEdgeRule::ProjectedSteepestEdgeRule()
     , _gamma( NULL )
     , _work1( NULL )
     , _work2( NULL )
-    , _AColumn( NULL )
     , _iterationsUntilReset( GlobalConfiguration::PSE_ITERATIONS_BEFORE_RESET )
     , _errorInGamma( 0.0 )
 {
@@ -240,9 +239,8 @@ void ProjectedSteepestEdgeRule::prePivotHook( const ITableau &tableau, bool fake
          * is constraint matrix column corresponding to xN[j] */
         unsigned nonBasic = tableau.nonBasicIndexToVariable( i );
 
-        _AColumn = tableau.getSparseAColumn( nonBasic );
         s = 0.0;
-        for ( const auto &entry : *_AColumn )
+        for ( const auto &entry : tableau.getSparseAColumn( nonBasic ) )
             s += entry._value * _work2[entry._index];
 
         /* compute new gamma[j] */
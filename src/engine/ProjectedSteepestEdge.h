@@ -76,7 +76,6 @@ private:
     */
     double *_work1;
     double *_work2;
-    const SparseUnsortedList *_AColumn;
 
     /*
       Tableau dimensions.
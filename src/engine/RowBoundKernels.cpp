@@ -0,0 +1,572 @@
+/*********************                                                        */
+/*! \file RowBoundKernels.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "RowBoundKernels.h"
+
+#include "Debug.h"
+#include "FloatUtils.h"
+#include "GlobalConfiguration.h"
+
+#if !defined( _WIN32 ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+#define ROW_BOUND_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+/*
+  Scalar implementations. These are also used for the tails of the
+  vectorized loops.
+*/
+static double scalarRowBound( unsigned begin,
+                              unsigned count,
+                              const double *coefficients,
+                              const unsigned *indices,
+                              const double *lowerBounds,
+                              const double *upperBounds,
+                              bool isUpper )
+{
+    double bound = 0;
+    for ( unsigned i = begin; i < count; ++i )
+    {
+        double ci = coefficients[i];
+        if ( FloatUtils::isZero( ci ) )
+            continue;
+
+        unsigned xi = indices[i];
+        double multiplier = ( isUpper == ( ci > 0 ) ) ? upperBounds[xi] : lowerBounds[xi];
+        multiplier = FloatUtils::isZero( multiplier ) ? 0 : multiplier * ci;
+        bound += FloatUtils::isZero( multiplier ) ? 0 : multiplier;
+    }
+    return bound;
+}
+
+static void scalarContributions( unsigned begin,
+                                 unsigned count,
+                                 const double *coefficients,
+                                 const unsigned *indices,
+                                 const double *lowerBounds,
+                                 const double *upperBounds,
+                                 double *minContributions,
+                                 double *maxContributions,
+                                 double &minSum,
+                                 double &maxSum,
+                                 unsigned &minUnbounded,
+                                 unsigned &maxUnbounded )
+{
+    for ( unsigned i = begin; i < count; ++i )
+    {
+        double ci = coefficients[i];
+        if ( FloatUtils::isZero( ci ) )
+        {
+            minContributions[i] = 0;
+            maxContributions[i] = 0;
+            continue;
+        }
+
+        unsigned xi = indices[i];
+        double minBound = ci > 0 ? lowerBounds[xi] : upperBounds[xi];
+        double maxBound = ci > 0 ? upperBounds[xi] : lowerBounds[xi];
+
+        if ( FloatUtils::abs( minBound ) >= FloatUtils::infinity() )
+        {
+            minContributions[i] = FloatUtils::negativeInfinity();
+            ++minUnbounded;
+        }
+        else
+        {
+            minContributions[i] = ci * minBound;
+            minSum += minContributions[i];
+        }
+
+        if ( FloatUtils::abs( maxBound ) >= FloatUtils::infinity() )
+        {
+            maxContributions[i] = FloatUtils::infinity();
+            ++maxUnbounded;
+        }
+        else
+        {
+            maxContributions[i] = ci * maxBound;
+            maxSum += maxContributions[i];
+        }
+    }
+}
+
+static void scalarResiduals( unsigned begin,
+                             unsigned count,
+                             double total,
+                             unsigned unbounded,
+                             double unboundedValue,
+                             const double *contributions,
+                             double *residuals )
+{
+    for ( unsigned i = begin; i < count; ++i )
+    {
+        if ( unbounded == 0 )
+            residuals[i] = total - contributions[i];
+        else if ( unbounded == 1 && contributions[i] == unboundedValue )
+            residuals[i] = total;
+        else
+            residuals[i] = unboundedValue;
+    }
+}
+
+#ifdef ROW_BOUND_KERNELS_X86
+
+/*
+  SSE implementations, processing two entries at a time. SSE has no
+  gather instruction, so the bounds are loaded individually.
+*/
+__attribute__( ( target( "sse4.1" ) ) ) static inline __m128d sseAbs( __m128d x )
+{
+    return _mm_andnot_pd( _mm_set1_pd( -0.0 ), x );
+}
+
+__attribute__( ( target( "sse4.1" ) ) ) static inline double sseHorizontalSum( __m128d x )
+{
+    return _mm_cvtsd_f64( _mm_add_sd( x, _mm_unpackhi_pd( x, x ) ) );
+}
+
+__attribute__( ( target( "sse4.1" ) ) ) static double sseRowBound( unsigned count,
+                                                                 const double *coefficients,
+                                                                 const unsigned *indices,
+                                                                 const double *lowerBounds,
+                                                                 const double *upperBounds,
+                                                                 bool isUpper )
+{
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d epsilon = _mm_set1_pd( GlobalConfiguration::DEFAULT_EPSILON_FOR_COMPARISONS );
+
+    __m128d sum = zero;
+    unsigned i = 0;
+    for ( ; i + 2 <= count; i += 2 )
+    {
+        __m128d ci = _mm_loadu_pd( coefficients + i );
+        __m128d lb = _mm_set_pd( lowerBounds[indices[i + 1]], lowerBounds[indices[i]] );
+        __m128d ub = _mm_set_pd( upperBounds[indices[i + 1]], upperBounds[indices[i]] );
+
+        __m128d useUpper = isUpper ? _mm_cmpgt_pd( ci, zero ) : _mm_cmplt_pd( ci, zero );
+        __m128d multiplier = _mm_blendv_pd( lb, ub, useUpper );
+        __m128d product = _mm_mul_pd( multiplier, ci );
+
+        __m128d mask = _mm_and_pd( _mm_cmpgt_pd( sseAbs( ci ), epsilon ),
+                                   _mm_and_pd( _mm_cmpgt_pd( sseAbs( multiplier ), epsilon ),
+                                               _mm_cmpgt_pd( sseAbs( product ), epsilon ) ) );
+        sum = _mm_add_pd( sum, _mm_and_pd( product, mask ) );
+    }
+
+    return sseHorizontalSum( sum ) +
+           scalarRowBound( i, count, coefficients, indices, lowerBounds, upperBounds, isUpper );
+}
+
+__attribute__( ( target( "sse4.1" ) ) ) static void sseContributions( unsigned count,
+                                                                    const double *coefficients,
+                                                                    const unsigned *indices,
+                                                                    const double *lowerBounds,
+                                                                    const double *upperBounds,
+                                                                    double *minContributions,
+                                                                    double *maxContributions,
+                                                                    double &minSum,
+                                                                    double &maxSum,
+                                                                    unsigned &minUnbounded,
+                                                                    unsigned &maxUnbounded )
+{
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d epsilon = _mm_set1_pd( GlobalConfiguration::DEFAULT_EPSILON_FOR_COMPARISONS );
+    const __m128d infinity = _mm_set1_pd( FloatUtils::infinity() );
+    const __m128d negativeInfinity = _mm_set1_pd( FloatUtils::negativeInfinity() );
+
+    __m128d minAccumulator = zero;
+    __m128d maxAccumulator = zero;
+    unsigned i = 0;
+    for ( ; i + 2 <= count; i += 2 )
+    {
+        __m128d ci = _mm_loadu_pd( coefficients + i );
+        __m128d lb = _mm_set_pd( lowerBounds[indices[i + 1]], lowerBounds[indices[i]] );
+        __m128d ub = _mm_set_pd( upperBounds[indices[i + 1]], upperBounds[indices[i]] );
+
+        __m128d positive = _mm_cmpgt_pd( ci, zero );
+        __m128d nonZero = _mm_cmpgt_pd( sseAbs( ci ), epsilon );
+
+        __m128d minBound = _mm_blendv_pd( ub, lb, positive );
+        __m128d maxBound = _mm_blendv_pd( lb, ub, positive );
+        __m128d minIsUnbounded =
+            _mm_and_pd( _mm_cmpge_pd( sseAbs( minBound ), infinity ), nonZero );
+        __m128d maxIsUnbounded =
+            _mm_and_pd( _mm_cmpge_pd( sseAbs( maxBound ), infinity ), nonZero );
+
+        __m128d minContribution = _mm_and_pd( _mm_mul_pd( ci, minBound ), nonZero );
+        __m128d maxContribution = _mm_and_pd( _mm_mul_pd( ci, maxBound ), nonZero );
+
+        minAccumulator =
+            _mm_add_pd( minAccumulator, _mm_andnot_pd( minIsUnbounded, minContribution ) );
+        maxAccumulator =
+            _mm_add_pd( maxAccumulator, _mm_andnot_pd( maxIsUnbounded, maxContribution ) );
+        minUnbounded += __builtin_popcount( _mm_movemask_pd( minIsUnbounded ) );
+        maxUnbounded += __builtin_popcount( _mm_movemask_pd( maxIsUnbounded ) );
+
+        _mm_storeu_pd( minContributions + i,
+                       _mm_blendv_pd( minContribution, negativeInfinity, minIsUnbounded ) );
+        _mm_storeu_pd( maxContributions + i,
+                       _mm_blendv_pd( maxContribution, infinity, maxIsUnbounded ) );
+    }
+
+    minSum += sseHorizontalSum( minAccumulator );
+    maxSum += sseHorizontalSum( maxAccumulator );
+
+    scalarContributions( i,
+                         count,
+                         coefficients,
+                         indices,
+                         lowerBounds,
+                         upperBounds,
+                         minContributions,
+                         maxContributions,
+                         minSum,
+                         maxSum,
+                         minUnbounded,
+                         maxUnbounded );
+}
+
+__attribute__( ( target( "sse4.1" ) ) ) static void sseResiduals( unsigned count,
+                                                                double total,
+                                                                unsigned unbounded,
+                                                                double unboundedValue,
+                                                                const double *contributions,
+                                                                double *residuals )
+{
+    const __m128d totals = _mm_set1_pd( total );
+    const __m128d unboundedValues = _mm_set1_pd( unboundedValue );
+
+    unsigned i = 0;
+    for ( ; i + 2 <= count; i += 2 )
+    {
+        __m128d contribution = _mm_loadu_pd( contributions + i );
+        __m128d residual;
+        if ( unbounded == 0 )
+            residual = _mm_sub_pd( totals, contribution );
+        else if ( unbounded == 1 )
+            residual = _mm_blendv_pd(
+                unboundedValues, totals, _mm_cmpeq_pd( contribution, unboundedValues ) );
+        else
+            residual = unboundedValues;
+        _mm_storeu_pd( residuals + i, residual );
+    }
+
+    scalarResiduals( i, count, total, unbounded, unboundedValue, contributions, residuals );
+}
+
+/*
+  AVX2 implementations, processing four entries at a time and gathering
+  the bounds by index.
+*/
+__attribute__( ( target( "avx2" ) ) ) static inline __m256d avxAbs( __m256d x )
+{
+    return _mm256_andnot_pd( _mm256_set1_pd( -0.0 ), x );
+}
+
+__attribute__( ( target( "avx2" ) ) ) static inline double avxHorizontalSum( __m256d x )
+{
+    __m128d sum = _mm_add_pd( _mm256_castpd256_pd128( x ), _mm256_extractf128_pd( x, 1 ) );
+    return _mm_cvtsd_f64( _mm_add_sd( sum, _mm_unpackhi_pd( sum, sum ) ) );
+}
+
+__attribute__( ( target( "avx2" ) ) ) static inline __m256d avxGather( const double *values,
+                                                                     __m128i indices )
+{
+    // The masked gather, unlike the plain one, does not read an uninitialized source
+    const __m256d allLanes = _mm256_castsi256_pd( _mm256_set1_epi64x( -1 ) );
+    return _mm256_mask_i32gather_pd(
+        _mm256_setzero_pd(), values, indices, allLanes, sizeof( double ) );
+}
+
+__attribute__( ( target( "avx2" ) ) ) static double avxRowBound( unsigned count,
+                                                               const double *coefficients,
+                                                               const unsigned *indices,
+                                                               const double *lowerBounds,
+                                                               const double *upperBounds,
+                                                               bool isUpper )
+{
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d epsilon =
+        _mm256_set1_pd( GlobalConfiguration::DEFAULT_EPSILON_FOR_COMPARISONS );
+
+    __m256d sum = zero;
+    unsigned i = 0;
+    for ( ; i + 4 <= count; i += 4 )
+    {
+        __m256d ci = _mm256_loadu_pd( coefficients + i );
+        __m128i xi = _mm_loadu_si128( (const __m128i *)( indices + i ) );
+        __m256d lb = avxGather( lowerBounds, xi );
+        __m256d ub = avxGather( upperBounds, xi );
+
+        __m256d useUpper = isUpper ? _mm256_cmp_pd( ci, zero, _CMP_GT_OQ )
+                                   : _mm256_cmp_pd( ci, zero, _CMP_LT_OQ );
+        __m256d multiplier = _mm256_blendv_pd( lb, ub, useUpper );
+        __m256d product = _mm256_mul_pd( multiplier, ci );
+
+        __m256d mask = _mm256_and_pd(
+            _mm256_cmp_pd( avxAbs( ci ), epsilon, _CMP_GT_OQ ),
+            _mm256_and_pd( _mm256_cmp_pd( avxAbs( multiplier ), epsilon, _CMP_GT_OQ ),
+                           _mm256_cmp_pd( avxAbs( product ), epsilon, _CMP_GT_OQ ) ) );
+        sum = _mm256_add_pd( sum, _mm256_and_pd( product, mask ) );
+    }
+
+    return avxHorizontalSum( sum ) +
+           scalarRowBound( i, count, coefficients, indices, lowerBounds, upperBounds, isUpper );
+}
+
+__attribute__( ( target( "avx2" ) ) ) static void avxContributions( unsigned count,
+                                                                  const double *coefficients,
+                                                                  const unsigned *indices,
+                                                                  const double *lowerBounds,
+                                                                  const double *upperBounds,
+                                                                  double *minContributions,
+                                                                  double *maxContributions,
+                                                                  double &minSum,
+                                                                  double &maxSum,
+                                                                  unsigned &minUnbounded,
+                                                                  unsigned &maxUnbounded )
+{
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d epsilon =
+        _mm256_set1_pd( GlobalConfiguration::DEFAULT_EPSILON_FOR_COMPARISONS );
+    const __m256d infinity = _mm256_set1_pd( FloatUtils::infinity() );
+    const __m256d negativeInfinity = _mm256_set1_pd( FloatUtils::negativeInfinity() );
+
+    __m256d minAccumulator = zero;
+    __m256d maxAccumulator = zero;
+    unsigned i = 0;
+    for ( ; i + 4 <= count; i += 4 )
+    {
+        __m256d ci = _mm256_loadu_pd( coefficients + i );
+        __m128i xi = _mm_loadu_si128( (const __m128i *)( indices + i ) );
+        __m256d lb = avxGather( lowerBounds, xi );
+        __m256d ub = avxGather( upperBounds, xi );
+
+        __m256d positive = _mm256_cmp_pd( ci, zero, _CMP_GT_OQ );
+        __m256d nonZero = _mm256_cmp_pd( avxAbs( ci ), epsilon, _CMP_GT_OQ );
+
+        __m256d minBound = _mm256_blendv_pd( ub, lb, positive );
+        __m256d maxBound = _mm256_blendv_pd( lb, ub, positive );
+        __m256d minIsUnbounded =
+            _mm256_and_pd( _mm256_cmp_pd( avxAbs( minBound ), infinity, _CMP_GE_OQ ), nonZero );
+        __m256d maxIsUnbounded =
+            _mm256_and_pd( _mm256_cmp_pd( avxAbs( maxBound ), infinity, _CMP_GE_OQ ), nonZero );
+
+        __m256d minContribution = _mm256_and_pd( _mm256_mul_pd( ci, minBound ), nonZero );
+        __m256d maxContribution = _mm256_and_pd( _mm256_mul_pd( ci, maxBound ), nonZero );
+
+        minAccumulator =
+            _mm256_add_pd( minAccumulator, _mm256_andnot_pd( minIsUnbounded, minContribution ) );
+        maxAccumulator =
+            _mm256_add_pd( maxAccumulator, _mm256_andnot_pd( maxIsUnbounded, maxContribution ) );
+        minUnbounded += __builtin_popcount( _mm256_movemask_pd( minIsUnbounded ) );
+        maxUnbounded += __builtin_popcount( _mm256_movemask_pd( maxIsUnbounded ) );
+
+        _mm256_storeu_pd( minContributions + i,
+                          _mm256_blendv_pd( minContribution, negativeInfinity, minIsUnbounded ) );
+        _mm256_storeu_pd( maxContributions + i,
+                          _mm256_blendv_pd( maxContribution, infinity, maxIsUnbounded ) );
+    }
+
+    minSum += avxHorizontalSum( minAccumulator );
+    maxSum += avxHorizontalSum( maxAccumulator );
+
+    scalarContributions( i,
+                         count,
+                         coefficients,
+                         indices,
+                         lowerBounds,
+                         upperBounds,
+                         minContributions,
+                         maxContributions,
+                         minSum,
+                         maxSum,
+                         minUnbounded,
+                         maxUnbounded );
+}
+
+__attribute__( ( target( "avx2" ) ) ) static void avxResiduals( unsigned count,
+                                                              double total,
+                                                              unsigned unbounded,
+                                                              double unboundedValue,
+                                                              const double *contributions,
+                                                              double *residuals )
+{
+    const __m256d totals = _mm256_set1_pd( total );
+    const __m256d unboundedValues = _mm256_set1_pd( unboundedValue );
+
+    unsigned i = 0;
+    for ( ; i + 4 <= count; i += 4 )
+    {
+        __m256d contribution = _mm256_loadu_pd( contributions + i );
+        __m256d residual;
+        if ( unbounded == 0 )
+            residual = _mm256_sub_pd( totals, contribution );
+        else if ( unbounded == 1 )
+            residual = _mm256_blendv_pd(
+                unboundedValues,
+                totals,
+                _mm256_cmp_pd( contribution, unboundedValues, _CMP_EQ_OQ ) );
+        else
+            residual = unboundedValues;
+        _mm256_storeu_pd( residuals + i, residual );
+    }
+
+    scalarResiduals( i, count, total, unbounded, unboundedValue, contributions, residuals );
+}
+
+#endif // ROW_BOUND_KERNELS_X86
+
+static RowBoundKernels::Implementation detectImplementation()
+{
+#ifdef ROW_BOUND_KERNELS_X86
+    __builtin_cpu_init();
+    if ( __builtin_cpu_supports( "avx2" ) )
+        return RowBoundKernels::AVX2;
+    if ( __builtin_cpu_supports( "sse4.1" ) )
+        return RowBoundKernels::SSE;
+#endif
+    return RowBoundKernels::SCALAR;
+}
+
+static RowBoundKernels::Implementation &currentImplementation()
+{
+    static RowBoundKernels::Implementation implementation = detectImplementation();
+    return implementation;
+}
+
+RowBoundKernels::Implementation RowBoundKernels::getImplementation()
+{
+    return currentImplementation();
+}
+
+bool RowBoundKernels::isSupported( Implementation implementation )
+{
+    return implementation <= detectImplementation();
+}
+
+void RowBoundKernels::setImplementation( Implementation implementation )
+{
+    ASSERT( isSupported( implementation ) );
+    currentImplementation() = implementation;
+}
+
+double RowBoundKernels::computeRowBound( unsigned count,
+                                         const double *coefficients,
+                                         const unsigned *indices,
+                                         const double *lowerBounds,
+                                         const double *upperBounds,
+                                         bool isUpper )
+{
+#ifdef ROW_BOUND_KERNELS_X86
+    switch ( currentImplementation() )
+    {
+    case AVX2:
+        return avxRowBound( count, coefficients, indices, lowerBounds, upperBounds, isUpper );
+    case SSE:
+        return sseRowBound( count, coefficients, indices, lowerBounds, upperBounds, isUpper );
+    default:
+        break;
+    }
+#endif
+    return scalarRowBound( 0, count, coefficients, indices, lowerBounds, upperBounds, isUpper );
+}
+
+void RowBoundKernels::computeContributions( unsigned count,
+                                            const double *coefficients,
+                                            const unsigned *indices,
+                                            const double *lowerBounds,
+                                            const double *upperBounds,
+                                            double *minContributions,
+                                            double *maxContributions,
+                                            double &minSum,
+                                            double &maxSum,
+                                            unsigned &minUnbounded,
+                                            unsigned &maxUnbounded )
+{
+    minSum = 0;
+    maxSum = 0;
+    minUnbounded = 0;
+    maxUnbounded = 0;
+
+#ifdef ROW_BOUND_KERNELS_X86
+    switch ( currentImplementation() )
+    {
+    case AVX2:
+        avxContributions( count,
+                          coefficients,
+                          indices,
+                          lowerBounds,
+                          upperBounds,
+                          minContributions,
+                          maxContributions,
+                          minSum,
+                          maxSum,
+                          minUnbounded,
+                          maxUnbounded );
+        return;
+    case SSE:
+        sseContributions( count,
+                          coefficients,
+                          indices,
+                          lowerBounds,
+                          upperBounds,
+                          minContributions,
+                          maxContributions,
+                          minSum,
+                          maxSum,
+                          minUnbounded,
+                          maxUnbounded );
+        return;
+    default:
+        break;
+    }
+#endif
+    scalarContributions( 0,
+                         count,
+                         coefficients,
+                         indices,
+                         lowerBounds,
+                         upperBounds,
+                         minContributions,
+                         maxContributions,
+                         minSum,
+                         maxSum,
+                         minUnbounded,
+                         maxUnbounded );
+}
+
+void RowBoundKernels::computeResiduals( unsigned count,
+                                        double total,
+                                        unsigned unbounded,
+                                        double unboundedValue,
+                                        const double *contributions,
+                                        double *residuals )
+{
+#ifdef ROW_BOUND_KERNELS_X86
+    switch ( currentImplementation() )
+    {
+    case AVX2:
+        avxResiduals( count, total, unbounded, unboundedValue, contributions, residuals );
+        return;
+    case SSE:
+        sseResiduals( count, total, unbounded, unboundedValue, contributions, residuals );
+        return;
+    default:
+        break;
+    }
+#endif
+    scalarResiduals( 0, count, total, unbounded, unboundedValue, contributions, residuals );
+}
@@ -0,0 +1,103 @@
+/*********************                                                        */
+/*! \file RowBoundKernels.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Kernels for computing interval bounds of sparse rows, i.e. of sums
+ **
+ **     sum c_i x_i
+ **
+ ** given the lower and upper bounds of the x_i's. The bounds of the row's
+ ** variables are gathered by index, and the lower or upper bound is selected
+ ** according to the sign of each coefficient using masks rather than branches.
+ **
+ ** Each kernel has an AVX2, an SSE and a scalar implementation. The fastest
+ ** implementation supported by the CPU is selected at runtime, once. The
+ ** vectorized implementations sum in a different order than the scalar one,
+ ** so their results may differ by rounding errors.
+ **/
+
+#ifndef __RowBoundKernels_h__
+#define __RowBoundKernels_h__
+
+class RowBoundKernels
+{
+public:
+    enum Implementation {
+        SCALAR = 0,
+        SSE = 1,
+        AVX2 = 2,
+    };
+
+    /*
+      The implementation currently in use, and whether a given
+      implementation is supported on this machine. Overriding the
+      implementation is mostly intended for testing.
+    */
+    static Implementation getImplementation();
+    static bool isSupported( Implementation implementation );
+    static void setImplementation( Implementation implementation );
+
+    /*
+      Compute the lower (or upper) bound of sum c_i x_i, where c_i =
+      coefficients[i] and x_i is variable indices[i]. Coefficients,
+      bounds and products that are zero up to the default epsilon are
+      ignored.
+    */
+    static double computeRowBound( unsigned count,
+                                   const double *coefficients,
+                                   const unsigned *indices,
+                                   const double *lowerBounds,
+                                   const double *upperBounds,
+                                   bool isUpper );
+
+    /*
+      For every entry of the row, store the smallest and largest values
+      that c_i x_i can take. Entries whose coefficients are zero up to
+      the default epsilon contribute nothing.
+
+      An entry whose relevant bound is infinite is unbounded: its
+      contribution is stored as FloatUtils::negativeInfinity() (resp.
+      infinity()), it is left out of minSum (resp. maxSum), and is
+      counted in minUnbounded (resp. maxUnbounded).
+    */
+    static void computeContributions( unsigned count,
+                                      const double *coefficients,
+                                      const unsigned *indices,
+                                      const double *lowerBounds,
+                                      const double *upperBounds,
+                                      double *minContributions,
+                                      double *maxContributions,
+                                      double &minSum,
+                                      double &maxSum,
+                                      unsigned &minUnbounded,
+                                      unsigned &maxUnbounded );
+
+    /*
+      Given the per-entry contributions to a row bound, as computed by
+      computeContributions(), compute the bound of the row without each of
+      its entries:
+
+          residuals[i] = total - contributions[i]
+
+      This gives all the "row minus one entry" bounds in two linear
+      passes. A residual that still includes an unbounded entry is set to
+      unboundedValue, which should be the value used for unbounded
+      contributions, i.e. FloatUtils::negativeInfinity() for lower bounds
+      and FloatUtils::infinity() for upper bounds.
+    */
+    static void computeResiduals( unsigned count,
+                                  double total,
+                                  unsigned unbounded,
+                                  double unboundedValue,
+                                  const double *contributions,
+                                  double *residuals );
+};
+
+#endif // __RowBoundKernels_h__
@@ -18,9 +18,12 @@
 #include "Debug.h"
 #include "InfeasibleQueryException.h"
 #include "MarabouError.h"
+#include "RowBoundKernels.h"
 #include "SparseUnsortedList.h"
 #include "Statistics.h"
 
+#include <algorithm>
+
 RowBoundTightener::RowBoundTightener( const ITableau &tableau )
     : _tableau( tableau )
     , _boundManager( tableau.getBoundManager() )
@@ -28,9 +31,12 @@ RowBoundTightener::RowBoundTightener( const ITableau &tableau )
     , _upperBounds( nullptr )
     , _rows( NULL )
     , _z( NULL )
-    , _ciTimesLb( NULL )
-    , _ciTimesUb( NULL )
-    , _ciSign( NULL )
+    , _rowCoefficients( NULL )
+    , _rowIndices( NULL )
+    , _minContributions( NULL )
+    , _maxContributions( NULL )
+    , _residualMin( NULL )
+    , _residualMax( NULL )
     , _statistics( NULL )
 {
 }
@@ -59,9 +65,12 @@ void RowBoundTightener::setDimensions()
         _z = new double[_m];
     }
 
-    _ciTimesLb = new double[_n];
-    _ciTimesUb = new double[_n];
-    _ciSign = new char[_n];
+    _rowCoefficients = new double[_n];
+    _rowIndices = new unsigned[_n];
+    _minContributions = new double[_n];
+    _maxContributions = new double[_n];
+    _residualMin = new double[_n];
+    _residualMax = new double[_n];
 }
 
 RowBoundTightener::~RowBoundTightener()
@@ -85,22 +94,40 @@ void RowBoundTightener::freeMemoryIfNeeded()
         _z = NULL;
     }
 
-    if ( _ciTimesLb )
+    if ( _rowCoefficients )
+    {
+        delete[] _rowCoefficients;
+        _rowCoefficients = NULL;
+    }
+
+    if ( _rowIndices )
+    {
+        delete[] _rowIndices;
+        _rowIndices = NULL;
+    }
+
+    if ( _minContributions )
+    {
+        delete[] _minContributions;
+        _minContributions = NULL;
+    }
+
+    if ( _maxContributions )
     {
-        delete[] _ciTimesLb;
-        _ciTimesLb = NULL;
+        delete[] _maxContributions;
+        _maxContributions = NULL;
     }
 
-    if ( _ciTimesUb )
+    if ( _residualMin )
     {
-        delete[] _ciTimesUb;
-        _ciTimesUb = NULL;
+        delete[] _residualMin;
+        _residualMin = NULL;
     }
 
-    if ( _ciSign )
+    if ( _residualMax )
     {
-        delete[] _ciSign;
-        _ciSign = NULL;
+        delete[] _residualMax;
+        _residualMax = NULL;
     }
 }
 
@@ -185,10 +212,9 @@ void RowBoundTightener::examineInvertedBasisMatrix( bool untilSaturation )
                 // Dot product of the i'th row of inv(B) with the appropriate
                 // column of An
 
-                const SparseUnsortedList *column = _tableau.getSparseAColumn( row->_row[j]._var );
                 row->_row[j]._coefficient = 0;
 
-                for ( const auto &entry : *column )
+                for ( const auto &entry : _tableau.getSparseAColumn( row->_row[j]._var ) )
                     row->_row[j]._coefficient -= invB[i * _m + entry._index] * entry._value;
             }
 
@@ -243,67 +269,48 @@ unsigned RowBoundTightener::tightenOnSingleInvertedBasisRow( const TableauRow &r
 
       We wish to tighten once for y, but also once for every x.
     */
-    unsigned n = _tableau.getN();
-    unsigned m = _tableau.getM();
+    unsigned count = _tableau.getN() - _tableau.getM();
 
     unsigned result = 0;
 
-    // Compute ci * lb, ci * ub, flag signs for all entries
-    enum {
-        ZERO = 0,
-        POSITIVE = 1,
-        NEGATIVE = 2,
-    };
-
-    for ( unsigned i = 0; i < n - m; ++i )
+    // Compute the smallest and largest values of every ci xi, and their sums
+    for ( unsigned i = 0; i < count; ++i )
     {
-        double ci = row[i];
-
-        if ( FloatUtils::isZero( ci ) )
-        {
-            _ciSign[i] = ZERO;
-            _ciTimesLb[i] = 0;
-            _ciTimesUb[i] = 0;
-            continue;
-        }
-
-        _ciSign[i] = FloatUtils::isPositive( ci ) ? POSITIVE : NEGATIVE;
-
-        unsigned xi = row._row[i]._var;
-        _ciTimesLb[i] = ci * getLowerBound( xi );
-        _ciTimesUb[i] = ci * getUpperBound( xi );
+        _rowCoefficients[i] = row._row[i]._coefficient;
+        _rowIndices[i] = row._row[i]._var;
     }
 
-    // Start with a pass for y
+    double minSum;
+    double maxSum;
+    unsigned minUnbounded;
+    unsigned maxUnbounded;
+    RowBoundKernels::computeContributions( count,
+                                           _rowCoefficients,
+                                           _rowIndices,
+                                           _lowerBounds,
+                                           _upperBounds,
+                                           _minContributions,
+                                           _maxContributions,
+                                           minSum,
+                                           maxSum,
+                                           minUnbounded,
+                                           maxUnbounded );
+
+    // Start with a pass for y. A side with an unbounded entry yields no bound.
     unsigned y = row._lhs;
-    double upperBound = row._scalar;
-    double lowerBound = row._scalar;
 
-    unsigned xi;
-    double ci;
-
-    for ( unsigned i = 0; i < n - m; ++i )
-    {
-        if ( _ciSign[i] == POSITIVE )
-        {
-            lowerBound += _ciTimesLb[i];
-            upperBound += _ciTimesUb[i];
-        }
-        else
-        {
-            lowerBound += _ciTimesUb[i];
-            upperBound += _ciTimesLb[i];
-        }
-    }
-
-    result += registerTighterLowerBound(
-        y,
-        lowerBound - GlobalConfiguration::EXPLICIT_BASIS_BOUND_TIGHTENING_ROUNDING_CONSTANT,
-        row );
-    result += registerTighterUpperBound(
-        y,
-        upperBound + GlobalConfiguration::EXPLICIT_BASIS_BOUND_TIGHTENING_ROUNDING_CONSTANT,
-        row );
+    if ( minUnbounded == 0 )
+        result += registerTighterLowerBound(
+            y,
+            row._scalar + minSum -
+                GlobalConfiguration::EXPLICIT_BASIS_BOUND_TIGHTENING_ROUNDING_CONSTANT,
+            row );
+    if ( maxUnbounded == 0 )
+        result += registerTighterUpperBound(
+            y,
+            row._scalar + maxSum +
+                GlobalConfiguration::EXPLICIT_BASIS_BOUND_TIGHTENING_ROUNDING_CONSTANT,
+            row );
     if ( FloatUtils::gt( getLowerBound( y ), getUpperBound( y ) ) )
     {
         ASSERT(
@@ -314,82 +321,74 @@ unsigned RowBoundTightener::tightenOnSingleInvertedBasisRow( const TableauRow &r
     // Next, do a pass for each of the rhs variables.
     // For this, we wish to logically transform the equation into:
     //
-    //     xi = 1/ci * ( y - sum cj xj - b )
+    //     xi = 1/ci * ( y - sum cj xj - b ),    j != i
     //
     // And then compute the upper/lower bounds for xi.
     //
-    // However, for efficiency, we compute the lower and upper
-    // bounds of the expression:
-    //
-    //         y - sum ci xi - b
-    //
-    // Then, when we consider xi we adjust the computed lower and upper
-    // boudns accordingly.
+    // The bounds of sum cj xj for every i are obtained at once, by
+    // removing the contribution of xi from the bounds of the entire sum.
+    RowBoundKernels::computeResiduals( count,
+                                       minSum,
+                                       minUnbounded,
+                                       FloatUtils::negativeInfinity(),
+                                       _minContributions,
+                                       _residualMin );
+    RowBoundKernels::computeResiduals( count,
+                                       maxSum,
+                                       maxUnbounded,
+                                       FloatUtils::infinity(),
+                                       _maxContributions,
+                                       _residualMax );
 
     double auxLb = getLowerBound( y ) - row._scalar;
     double auxUb = getUpperBound( y ) - row._scalar;
+    bool yHasLowerBound = FloatUtils::isFinite( getLowerBound( y ) );
+    bool yHasUpperBound = FloatUtils::isFinite( getUpperBound( y ) );
 
-    // Now add ALL xi's
-    for ( unsigned i = 0; i < n - m; ++i )
-    {
-        if ( _ciSign[i] == NEGATIVE )
-        {
-            auxLb -= _ciTimesLb[i];
-            auxUb -= _ciTimesUb[i];
-        }
-        else
-        {
-            auxLb -= _ciTimesUb[i];
-            auxUb -= _ciTimesLb[i];
-        }
-    }
+    unsigned xi;
+    double ci;
+    double lowerBound;
+    double upperBound;
+    bool hasLowerBound;
+    bool hasUpperBound;
 
     // Now consider each individual xi
-    for ( unsigned i = 0; i < n - m; ++i )
+    for ( unsigned i = 0; i < count; ++i )
     {
-        // If ci = 0, nothing to do.
-        if ( _ciSign[i] == ZERO ||
-             FloatUtils::lt( abs( row[i] ),
+        // If ci is (almost) 0, nothing to do.
+        ci = _rowCoefficients[i];
+        if ( FloatUtils::lt( FloatUtils::abs( ci ),
                              GlobalConfiguration::MINIMAL_COEFFICIENT_FOR_TIGHTENING ) )
             continue;
 
-        lowerBound = auxLb;
-        upperBound = auxUb;
-
-        // Adjust the aux bounds to remove xi
-        if ( _ciSign[i] == NEGATIVE )
-        {
-            lowerBound += _ciTimesLb[i];
-            upperBound += _ciTimesUb[i];
-        }
-        else
-        {
-            lowerBound += _ciTimesUb[i];
-            upperBound += _ciTimesLb[i];
-        }
+        // Bounds for ci * xi, which are unavailable if anything involved is unbounded
+        hasLowerBound = yHasLowerBound && FloatUtils::isFinite( _residualMax[i] );
+        hasUpperBound = yHasUpperBound && FloatUtils::isFinite( _residualMin[i] );
+        lowerBound = auxLb - _residualMax[i];
+        upperBound = auxUb - _residualMin[i];
 
         // Now divide everything by ci, switching signs if needed.
-        ci = row[i];
         lowerBound = lowerBound / ci;
         upperBound = upperBound / ci;
 
-        if ( _ciSign[i] == NEGATIVE )
+        if ( ci < 0 )
         {
-            double temp = upperBound;
-            upperBound = lowerBound;
-            lowerBound = temp;
+            std::swap( lowerBound, upperBound );
+            std::swap( hasLowerBound, hasUpperBound );
         }
 
         // If a tighter bound is found, store it
-        xi = row._row[i]._var;
-        result += registerTighterLowerBound(
-            xi,
-            lowerBound - GlobalConfiguration::EXPLICIT_BASIS_BOUND_TIGHTENING_ROUNDING_CONSTANT,
-            row );
-        result += registerTighterUpperBound(
-            xi,
-            upperBound + GlobalConfiguration::EXPLICIT_BASIS_BOUND_TIGHTENING_ROUNDING_CONSTANT,
-            row );
+        xi = _rowIndices[i];
+        if ( hasLowerBound )
+            result += registerTighterLowerBound(
+                xi,
+                lowerBound - GlobalConfiguration::EXPLICIT_BASIS_BOUND_TIGHTENING_ROUNDING_CONSTANT,
+                row );
+        if ( hasUpperBound )
+            result += registerTighterUpperBound(
+                xi,
+                upperBound + GlobalConfiguration::EXPLICIT_BASIS_BOUND_TIGHTENING_ROUNDING_CONSTANT,
+                row );
         if ( FloatUtils::gt( getLowerBound( xi ), getUpperBound( xi ) ) )
         {
             ASSERT( FloatUtils::gt( _boundManager.getLowerBound( xi ),
@@ -446,115 +445,119 @@ unsigned RowBoundTightener::tightenOnSingleConstraintRow( unsigned row )
 
       We first compute the lower and upper bounds for the expression
 
-          sum ci xi - b
+          sum ci xi
    */
-    unsigned n = _tableau.getN();
-
     unsigned result = 0;
 
-    const SparseUnsortedList *sparseRow = _tableau.getSparseARow( row );
+    SparseSpan sparseRow = _tableau.getSparseARow( row );
     const double *b = _tableau.getRightHandSide();
 
-    double ci;
-    unsigned index;
-
-    // Compute ci * lb, ci * ub, flag signs for all entries
-    enum {
-        ZERO = 0,
-        POSITIVE = 1,
-        NEGATIVE = 2,
-    };
-
-    std::fill_n( _ciSign, n, ZERO );
-    std::fill_n( _ciTimesLb, n, 0 );
-    std::fill_n( _ciTimesUb, n, 0 );
-
-    for ( const auto &entry : *sparseRow )
+    // Compute the smallest and largest values of every ci xi, and their sums
+    unsigned count = 0;
+    for ( const auto &entry : sparseRow )
     {
-        index = entry._index;
-        ci = entry._value;
-
-        _ciSign[index] = FloatUtils::isPositive( ci ) ? POSITIVE : NEGATIVE;
-        _ciTimesLb[index] = ci * getLowerBound( index );
-        _ciTimesUb[index] = ci * getUpperBound( index );
+        _rowCoefficients[count] = entry._value;
+        _rowIndices[count] = entry._index;
+        ++count;
     }
 
+    double minSum;
+    double maxSum;
+    unsigned minUnbounded;
+    unsigned maxUnbounded;
+    RowBoundKernels::computeContributions( count,
+                                           _rowCoefficients,
+                                           _rowIndices,
+                                           _lowerBounds,
+                                           _upperBounds,
+                                           _minContributions,
+                                           _maxContributions,
+                                           minSum,
+                                           maxSum,
+                                           minUnbounded,
+                                           maxUnbounded );
+
     /*
       Do a pass for each of the rhs variables.
       For this, we wish to logically transform the equation into:
 
-          xi = 1/ci * ( b - sum cj xj )
+          xi = 1/ci * ( b - sum cj xj ),    j != i
 
       And then compute the upper/lower bounds for xi.
 
-      However, for efficiency, we compute the lower and upper
-      bounds of the expression:
-
-              b - sum ci xi
-
-      Then, when we consider xi we adjust the computed lower and upper
-      bounds accordingly.
+      The bounds of sum cj xj for every i are obtained at once, by
+      removing the contribution of xi from the bounds of the entire sum.
     */
+    RowBoundKernels::computeResiduals( count,
+                                       minSum,
+                                       minUnbounded,
+                                       FloatUtils::negativeInfinity(),
+                                       _minContributions,
+                                       _residualMin );
+    RowBoundKernels::computeResiduals( count,
+                                       maxSum,
+                                       maxUnbounded,
+                                       FloatUtils::infinity(),
+                                       _maxContributions,
+                                       _residualMax );
 
-    double auxLb = b[row];
-    double auxUb = b[row];
-
-    // Now add ALL xi's
-    for ( unsigned i = 0; i < n; ++i )
+    /*
+      Bound explanations are stored as lists, so the row is only
+      copied if proofs are produced
+    */
+    bool produceProofs = _boundManager.shouldProduceProofs();
+    if ( produceProofs )
     {
-        if ( _ciSign[i] == NEGATIVE )
-        {
-            auxLb -= _ciTimesLb[i];
-            auxUb -= _ciTimesUb[i];
-        }
-        else
-        {
-            auxLb -= _ciTimesUb[i];
-            auxUb -= _ciTimesLb[i];
-        }
+        _explanationRow.clear();
+        for ( const auto &entry : sparseRow )
+            _explanationRow.append( entry._index, entry._value );
     }
 
+    double ci;
+    unsigned index;
     double lowerBound;
     double upperBound;
+    bool hasLowerBound;
+    bool hasUpperBound;
 
     // Now consider each individual xi with non zero coefficient
-    for ( const auto &entry : *sparseRow )
+    for ( unsigned i = 0; i < count; ++i )
     {
-        index = entry._index;
+        ci = _rowCoefficients[i];
+        if ( FloatUtils::lt( FloatUtils::abs( ci ),
+                             GlobalConfiguration::MINIMAL_COEFFICIENT_FOR_TIGHTENING ) )
+            continue;
 
-        lowerBound = auxLb;
-        upperBound = auxUb;
-
-        // Adjust the aux bounds to remove xi
-        if ( _ciSign[index] == NEGATIVE )
-        {
-            lowerBound += _ciTimesLb[index];
-            upperBound += _ciTimesUb[index];
-        }
-        else
-        {
-            lowerBound += _ciTimesUb[index];
-            upperBound += _ciTimesLb[index];
-        }
+        // Bounds for ci * xi, which are unavailable if another entry is unbounded
+        hasLowerBound = FloatUtils::isFinite( _residualMax[i] );
+        hasUpperBound = FloatUtils::isFinite( _residualMin[i] );
 
         // Now divide everything by ci, switching signs if needed.
-        ci = entry._value;
-        if ( FloatUtils::lt( abs( ci ), GlobalConfiguration::MINIMAL_COEFFICIENT_FOR_TIGHTENING ) )
-            continue;
-
-        lowerBound = lowerBound / ci;
-        upperBound = upperBound / ci;
+        lowerBound = ( b[row] - _residualMax[i] ) / ci;
+        upperBound = ( b[row] - _residualMin[i] ) / ci;
 
-        if ( _ciSign[index] == NEGATIVE )
+        if ( ci < 0 )
         {
-            double temp = upperBound;
-            upperBound = lowerBound;
-            lowerBound = temp;
+            std::swap( lowerBound, upperBound );
+            std::swap( hasLowerBound, hasUpperBound );
         }
 
         // If a tighter bound is found, store it
-        result += registerTighterLowerBound( index, lowerBound, *sparseRow );
-        result += registerTighterUpperBound( index, upperBound, *sparseRow );
+        index = _rowIndices[i];
+        if ( produceProofs )
+        {
+            if ( hasLowerBound )
+                result += registerTighterLowerBound( index, lowerBound, _explanationRow );
+            if ( hasUpperBound )
+                result += registerTighterUpperBound( index, upperBound, _explanationRow );
+        }
+        else
+        {
+            if ( hasLowerBound )
+                result += registerTighterLowerBound( index, lowerBound );
+            if ( hasUpperBound )
+                result += registerTighterUpperBound( index, upperBound );
+        }
 
         if ( FloatUtils::gt( getLowerBound( index ), getUpperBound( index ) ) )
             throw InfeasibleQueryException();
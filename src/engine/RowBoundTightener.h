@@ -21,6 +21,7 @@
 #include "IRowBoundTightener.h"
 #include "ITableau.h"
 #include "Queue.h"
+#include "SparseUnsortedList.h"
 #include "TableauRow.h"
 #include "Tightening.h"
 
@@ -177,9 +178,25 @@ private:
     */
     TableauRow **_rows;
     double *_z;
-    double *_ciTimesLb;
-    double *_ciTimesUb;
-    char *_ciSign;
+
+    /*
+      Work space for the row bound kernels: the current row unpacked
+      into coefficients and variable indices, the smallest and largest
+      contributions of each entry to the row's value, and the bounds of
+      the row without each of its entries.
+    */
+    double *_rowCoefficients;
+    unsigned *_rowIndices;
+    double *_minContributions;
+    double *_maxContributions;
+    double *_residualMin;
+    double *_residualMax;
+
+    /*
+      A copy of the current constraint matrix row, used as the
+      bound explanation when proofs are produced
+    */
+    SparseUnsortedList _explanationRow;
 
     /*
       Statistics collection
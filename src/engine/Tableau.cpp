@@ -16,7 +16,6 @@
 #include "Tableau.h"
 
 #include "BasisFactorizationFactory.h"
-#include "CSRMatrix.h"
 #include "ConstraintMatrixAnalyzer.h"
 #include "Debug.h"
 #include "EntrySelectionStrategy.h"
@@ -30,6 +29,7 @@
 #include "MarabouError.h"
 #include "Options.h"
 #include "PiecewiseLinearCaseSplit.h"
+#include "SparseConstraintMatrix.h"
 #include "TableauRow.h"
 #include "TableauState.h"
 
@@ -41,10 +41,8 @@ Tableau::Tableau( IBoundManager &boundManager )
     , _upperBounds( _boundManager.getUpperBounds() )
     , _n( 0 )
     , _m( 0 )
-    , _A( NULL )
-    , _sparseColumnsOfA( NULL )
-    , _sparseRowsOfA( NULL )
-    , _denseA( NULL )
+    , _A( nullptr )
+    , _denseAColumn( NULL )
     , _changeColumn( NULL )
     , _pivotRow( NULL )
     , _b( NULL )
@@ -75,46 +73,12 @@ Tableau::~Tableau()
 
 void Tableau::freeMemoryIfNeeded()
 {
-    if ( _A )
-    {
-        delete _A;
-        _A = NULL;
-    }
+    _A = nullptr;
 
-    if ( _sparseColumnsOfA )
+    if ( _denseAColumn )
     {
-        for ( unsigned i = 0; i < _n; ++i )
-        {
-            if ( _sparseColumnsOfA[i] )
-            {
-                delete _sparseColumnsOfA[i];
-                _sparseColumnsOfA[i] = NULL;
-            }
-        }
-
-        delete[] _sparseColumnsOfA;
-        _sparseColumnsOfA = NULL;
-    }
-
-    if ( _sparseRowsOfA )
-    {
-        for ( unsigned i = 0; i < _m; ++i )
-        {
-            if ( _sparseRowsOfA[i] )
-            {
-                delete _sparseRowsOfA[i];
-                _sparseRowsOfA[i] = NULL;
-            }
-        }
-
-        delete[] _sparseRowsOfA;
-        _sparseRowsOfA = NULL;
-    }
-
-    if ( _denseA )
-    {
-        delete[] _denseA;
-        _denseA = NULL;
+        delete[] _denseAColumn;
+        _denseAColumn = NULL;
     }
 
     if ( _changeColumn )
@@ -209,36 +173,11 @@ void Tableau::setDimensions( unsigned m, unsigned n )
 
     if ( _lpSolverType == LPSolverType::NATIVE )
     {
-        _A = new CSRMatrix();
-        if ( !_A )
-            throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::A" );
+        _A = std::make_shared<SparseConstraintMatrix>();
 
-        _sparseColumnsOfA = new SparseUnsortedList *[n];
-        if ( !_sparseColumnsOfA )
-            throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::sparseColumnsOfA" );
-
-        for ( unsigned i = 0; i < n; ++i )
-        {
-            _sparseColumnsOfA[i] = new SparseUnsortedList( _m );
-            if ( !_sparseColumnsOfA[i] )
-                throw MarabouError( MarabouError::ALLOCATION_FAILED,
-                                    "Tableau::sparseColumnsOfA[i]" );
-        }
-
-        _sparseRowsOfA = new SparseUnsortedList *[m];
-        if ( !_sparseRowsOfA )
-            throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::sparseRowOfA" );
-
-        for ( unsigned i = 0; i < m; ++i )
-        {
-            _sparseRowsOfA[i] = new SparseUnsortedList( _n );
-            if ( !_sparseRowsOfA[i] )
-                throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::sparseRowOfA[i]" );
-        }
-
-        _denseA = new double[m * n];
-        if ( !_denseA )
-            throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::denseA" );
+        _denseAColumn = new double[m];
+        if ( !_denseAColumn )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::denseAColumn" );
 
         _changeColumn = new double[m];
         if ( !_changeColumn )
@@ -309,17 +248,27 @@ void Tableau::setDimensions( unsigned m, unsigned n )
 void Tableau::setConstraintMatrix( const double *A )
 {
     _A->initialize( A, _m, _n );
+}
 
-    for ( unsigned column = 0; column < _n; ++column )
-    {
-        for ( unsigned row = 0; row < _m; ++row )
-            _denseA[column * _m + row] = A[row * _n + column];
+void Tableau::setConstraintMatrix( const std::shared_ptr<SparseConstraintMatrix> &A )
+{
+    ASSERT( A->getM() == _m && A->getN() == _n );
+    _A = A;
+}
 
-        _sparseColumnsOfA[column]->initialize( _denseA + ( column * _m ), _m );
-    }
+std::shared_ptr<SparseConstraintMatrix> Tableau::getSharedConstraintMatrix() const
+{
+    return _A;
+}
+
+void Tableau::detachConstraintMatrix()
+{
+    if ( _A.use_count() <= 1 )
+        return;
 
-    for ( unsigned row = 0; row < _m; ++row )
-        _sparseRowsOfA[row]->initialize( A + ( row * _n ), _n );
+    std::shared_ptr<SparseConstraintMatrix> copy = std::make_shared<SparseConstraintMatrix>();
+    _A->storeIntoOther( copy.get() );
+    _A = copy;
 }
 
 void Tableau::markAsBasic( unsigned variable )
@@ -398,7 +347,7 @@ void Tableau::computeAssignment()
         unsigned var = _nonBasicIndexToVariable[i];
         double value = _nonBasicAssignment[i];
 
-        for ( const auto &entry : *_sparseColumnsOfA[var] )
+        for ( const auto &entry : _A->getColumnSpan( var ) )
             _workM[entry._index] -= entry._value * value;
     }
 
@@ -1584,9 +1533,7 @@ void Tableau::getTableauRow( unsigned index, TableauRow *row )
         row->_row[i]._var = _nonBasicIndexToVariable[i];
         row->_row[i]._coefficient = 0;
 
-        SparseUnsortedList *column = _sparseColumnsOfA[_nonBasicIndexToVariable[i]];
-
-        for ( const auto &entry : *column )
+        for ( const auto &entry : _A->getColumnSpan( _nonBasicIndexToVariable[i] ) )
             row->_row[i]._coefficient -= ( _multipliers[entry._index] * entry._value );
     }
 
@@ -1608,32 +1555,23 @@ void Tableau::getTableauRow( unsigned index, TableauRow *row )
 
 const SparseMatrix *Tableau::getSparseA() const
 {
-    return _A;
+    return _A.get();
 }
 
 const double *Tableau::getAColumn( unsigned variable ) const
 {
-    return _denseA + ( variable * _m );
-}
-
-void Tableau::getSparseAColumn( unsigned variable, SparseUnsortedList *result ) const
-{
-    _sparseColumnsOfA[variable]->storeIntoOther( result );
-}
-
-const SparseUnsortedList *Tableau::getSparseAColumn( unsigned variable ) const
-{
-    return _sparseColumnsOfA[variable];
+    _A->getColumnDense( variable, _denseAColumn );
+    return _denseAColumn;
 }
 
-const SparseUnsortedList *Tableau::getSparseARow( unsigned row ) const
+SparseSpan Tableau::getSparseAColumn( unsigned variable ) const
 {
-    return _sparseRowsOfA[row];
+    return _A->getColumnSpan( variable );
 }
 
-void Tableau::getSparseARow( unsigned row, SparseUnsortedList *result ) const
+SparseSpan Tableau::getSparseARow( unsigned row ) const
 {
-    _sparseRowsOfA[row]->storeIntoOther( result );
+    return _A->getRowSpan( row );
 }
 
 void Tableau::dumpEquations()
@@ -1663,11 +1601,6 @@ void Tableau::storeState( TableauState &state, TableauStateStorageLevel level )
 
         // Store matrix A
         _A->storeIntoOther( state._A );
-        for ( unsigned i = 0; i < _n; ++i )
-            _sparseColumnsOfA[i]->storeIntoOther( state._sparseColumnsOfA[i] );
-        for ( unsigned i = 0; i < _m; ++i )
-            _sparseRowsOfA[i]->storeIntoOther( state._sparseRowsOfA[i] );
-        memcpy( state._denseA, _denseA, sizeof( double ) * _m * _n );
 
         // Store right hand side vector _b
         memcpy( state._b, _b, sizeof( double ) * _m );
@@ -1729,12 +1662,7 @@ void Tableau::restoreState( const TableauState &state, TableauStateStorageLevel
         setDimensions( state._m, state._n );
 
         // Restore matrix A
-        state._A->storeIntoOther( _A );
-        for ( unsigned i = 0; i < _n; ++i )
-            state._sparseColumnsOfA[i]->storeIntoOther( _sparseColumnsOfA[i] );
-        for ( unsigned i = 0; i < _m; ++i )
-            state._sparseRowsOfA[i]->storeIntoOther( _sparseRowsOfA[i] );
-        memcpy( _denseA, state._denseA, sizeof( double ) * _m * _n );
+        state._A->storeIntoOther( _A.get() );
 
         // Restore right hand side vector _b
         memcpy( _b, state._b, sizeof( double ) * _m );
@@ -1869,20 +1797,13 @@ unsigned Tableau::addEquation( const Equation &equation )
     addRow();
 
     // Adjust the constraint matrix
+    detachConstraintMatrix();
     _A->addEmptyColumn();
     std::fill_n( _workN, _n, 0.0 );
     for ( const auto &addend : equation._addends )
-    {
         _workN[addend._variable] = addend._coefficient;
-        _sparseColumnsOfA[addend._variable]->set( _m - 1, addend._coefficient );
-        _sparseRowsOfA[_m - 1]->set( addend._variable, addend._coefficient );
-        _denseA[( addend._variable * _m ) + _m - 1] = addend._coefficient;
-    }
 
     _workN[auxVariable] = 1;
-    _sparseColumnsOfA[auxVariable]->set( _m - 1, 1 );
-    _sparseRowsOfA[_m - 1]->set( auxVariable, 1 );
-    _denseA[( auxVariable * _m ) + _m - 1] = 1;
     _A->addLastRow( _workN );
 
     // Invalidate the cost function, so that it is recomputed in the next iteration.
@@ -1959,9 +1880,7 @@ unsigned Tableau::addEquation( const Equation &equation )
     }
     else
     {
-        ConstraintMatrixAnalyzer analyzer;
-        analyzer.analyze( (const SparseUnsortedList **)_sparseRowsOfA, _m, _n );
-        List<unsigned> independentColumns = analyzer.getIndependentColumns();
+        List<unsigned> independentColumns = computeIndependentColumns();
 
         try
         {
@@ -1991,57 +1910,15 @@ void Tableau::addRow()
       that are of size _n - _m are left as is.
     */
 
-    // Allocate a larger _sparseColumnsOfA, keep old ones
-    SparseUnsortedList **newSparseColumnsOfA = new SparseUnsortedList *[newN];
-    if ( !newSparseColumnsOfA )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newSparseColumnsOfA" );
-
-    for ( unsigned i = 0; i < _n; ++i )
-    {
-        newSparseColumnsOfA[i] = _sparseColumnsOfA[i];
-        newSparseColumnsOfA[i]->incrementSize();
-    }
-
-    newSparseColumnsOfA[newN - 1] = new SparseUnsortedList( newM );
-    if ( !newSparseColumnsOfA[newN - 1] )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED,
-                            "Tableau::newSparseColumnsOfA[newN-1]" );
-
-    delete[] _sparseColumnsOfA;
-    _sparseColumnsOfA = newSparseColumnsOfA;
-
-    // Allocate a larger _sparseRowsOfA, keep old ones
-    SparseUnsortedList **newSparseRowsOfA = new SparseUnsortedList *[newM];
-    if ( !newSparseRowsOfA )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newSparseRowsOfA" );
-
-    for ( unsigned i = 0; i < _m; ++i )
-    {
-        newSparseRowsOfA[i] = _sparseRowsOfA[i];
-        newSparseRowsOfA[i]->incrementSize();
-    }
-
-    newSparseRowsOfA[newM - 1] = new SparseUnsortedList( newN );
-    if ( !newSparseRowsOfA[newM - 1] )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newSparseRowsOfA[newN-1]" );
-
-    delete[] _sparseRowsOfA;
-    _sparseRowsOfA = newSparseRowsOfA;
-
-    // Allocate a larger _denseA, keep old entries
-    double *newDenseA = new double[newM * newN];
-    if ( !newDenseA )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newDenseA" );
-
-    for ( unsigned column = 0; column < _n; ++column )
-    {
-        memcpy( newDenseA + ( column * newM ), _denseA + ( column * _m ), sizeof( double ) * _m );
-        newDenseA[column * newM + newM - 1] = 0.0;
-    }
-    std::fill_n( newDenseA + ( newN - 1 ) * newM, newM, 0.0 );
-
-    delete[] _denseA;
-    _denseA = newDenseA;
+    /*
+      The constraint matrix itself grows in place, in addEquation().
+      Allocate a new dense column buffer. Don't need to initialize
+    */
+    double *newDenseAColumn = new double[newM];
+    if ( !newDenseAColumn )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newDenseAColumn" );
+    delete[] _denseAColumn;
+    _denseAColumn = newDenseAColumn;
 
     // Allocate a new changeColumn. Don't need to initialize
     double *newChangeColumn = new double[newM];
@@ -2519,13 +2396,13 @@ void Tableau::getColumnOfBasis( unsigned column, double *result ) const
     ASSERT( column < _m );
     ASSERT( !_mergedVariables.exists( _basicIndexToVariable[column] ) );
 
-    _sparseColumnsOfA[_basicIndexToVariable[column]]->toDense( result );
+    _A->getColumnDense( _basicIndexToVariable[column], result );
 }
 
 void Tableau::getSparseBasis( SparseColumnsOfBasis &basis ) const
 {
     for ( unsigned i = 0; i < _m; ++i )
-        basis._columns[i] = _sparseColumnsOfA[_basicIndexToVariable[i]];
+        basis._columns[i] = _A->getColumnSpan( _basicIndexToVariable[i] );
 }
 
 void Tableau::getColumnOfBasis( unsigned column, SparseUnsortedList *result ) const
@@ -2533,7 +2410,23 @@ void Tableau::getColumnOfBasis( unsigned column, SparseUnsortedList *result ) co
     ASSERT( column < _m );
     ASSERT( !_mergedVariables.exists( _basicIndexToVariable[column] ) );
 
-    _sparseColumnsOfA[_basicIndexToVariable[column]]->storeIntoOther( result );
+    _A->getColumn( _basicIndexToVariable[column], result );
+}
+
+List<unsigned> Tableau::computeIndependentColumns() const
+{
+    SparseSpan *rows = new SparseSpan[_m];
+    if ( !rows )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::rows" );
+
+    for ( unsigned i = 0; i < _m; ++i )
+        rows[i] = _A->getRowSpan( i );
+
+    ConstraintMatrixAnalyzer analyzer;
+    analyzer.analyze( rows, _m, _n );
+    delete[] rows;
+
+    return analyzer.getIndependentColumns();
 }
 
 void Tableau::refreshBasisFactorization()
@@ -2544,9 +2437,7 @@ void Tableau::refreshBasisFactorization()
     }
     catch ( const MalformedBasisException & )
     {
-        ConstraintMatrixAnalyzer analyzer;
-        analyzer.analyze( (const SparseUnsortedList **)_sparseRowsOfA, _m, _n );
-        List<unsigned> independentColumns = analyzer.getIndependentColumns();
+        List<unsigned> independentColumns = computeIndependentColumns();
 
         try
         {
@@ -2593,23 +2484,13 @@ void Tableau::mergeColumns( unsigned x1, unsigned x2 )
 
     /*
       Merge column x2 of the constraint matrix into x1
-      and zero-out column x2
+      and zero-out column x2. This updates both the row and
+      the column views of the matrix.
     */
+    detachConstraintMatrix();
     _A->mergeColumns( x1, x2 );
     _mergedVariables[x2] = x1;
 
-    // Adjust sparse columns and rows, also
-    _sparseColumnsOfA[x2]->clear();
-    _A->getColumn( x1, _sparseColumnsOfA[x1] );
-
-    for ( unsigned i = 0; i < _m; ++i )
-        _sparseRowsOfA[i]->mergeEntries( x2, x1 );
-
-    // And the dense ones, too
-    for ( unsigned i = 0; i < _m; ++i )
-        _denseA[x1 * _m + i] += _denseA[x2 * _m + i];
-    std::fill_n( _denseA + x2 * _m, _m, 0 );
-
     computeAssignment();
     computeCostFunction();
 
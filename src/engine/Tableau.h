@@ -26,6 +26,7 @@
 #include "Set.h"
 #include "SparseColumnsOfBasis.h"
 #include "SparseMatrix.h"
+#include "SparseSpan.h"
 #include "SparseUnsortedList.h"
 #include "Statistics.h"
 
@@ -34,6 +35,7 @@
 class Equation;
 class ICostFunctionManager;
 class PiecewiseLinearCaseSplit;
+class SparseConstraintMatrix;
 class TableauState;
 
 class Tableau
@@ -52,9 +54,11 @@ public:
     void setDimensions( unsigned m, unsigned n );
 
     /*
-      Initialize the constraint matrix
+      Initialize the constraint matrix, either from a dense matrix or by
+      sharing the (copy-on-write) matrix of another tableau
     */
     void setConstraintMatrix( const double *A );
+    void setConstraintMatrix( const std::shared_ptr<SparseConstraintMatrix> &A );
 
     /*
       Set which variable will enter the basis. The input is the
@@ -335,15 +339,17 @@ public:
     void getTableauRow( unsigned index, TableauRow *row );
 
     /*
-      Get the original constraint matrix A or a column thereof,
-      in dense form.
+      Get the original constraint matrix A, a column thereof in
+      dense form, or a sparse view of one of its rows or columns.
+      The dense column is stored in an internal buffer and is only
+      valid until the next call. The sparse views are invalidated
+      when the matrix changes.
     */
     const SparseMatrix *getSparseA() const;
+    std::shared_ptr<SparseConstraintMatrix> getSharedConstraintMatrix() const;
     const double *getAColumn( unsigned variable ) const;
-    void getSparseAColumn( unsigned variable, SparseUnsortedList *result ) const;
-    void getSparseARow( unsigned row, SparseUnsortedList *result ) const;
-    const SparseUnsortedList *getSparseAColumn( unsigned variable ) const;
-    const SparseUnsortedList *getSparseARow( unsigned row ) const;
+    SparseSpan getSparseAColumn( unsigned variable ) const;
+    SparseSpan getSparseARow( unsigned row ) const;
 
     /*
       Store and restore the Tableau's state. Needed for case splitting
@@ -515,14 +521,13 @@ private:
     unsigned _m;
 
     /*
-      The constraint matrix A, and a collection of its
-      sparse columns. The matrix is also stored in dense
-      form (column-major).
+      The constraint matrix A, which provides both row and column
+      access, and a work buffer for scattering one of its columns
+      into dense form. A may be shared with other tableaus, in which
+      case it is copied before being modified.
     */
-    SparseMatrix *_A;
-    SparseUnsortedList **_sparseColumnsOfA;
-    SparseUnsortedList **_sparseRowsOfA;
-    double *_denseA;
+    std::shared_ptr<SparseConstraintMatrix> _A;
+    mutable double *_denseAColumn;
 
     /*
       Used to compute inv(B)*a
@@ -657,11 +662,23 @@ private:
     */
     void freeMemoryIfNeeded();
 
+    /*
+      Make sure that A is not shared with any other tableau, copying it
+      if needed, before it is modified.
+    */
+    void detachConstraintMatrix();
+
     /*
       Resize the relevant data structures to add a new row to the tableau.
     */
     void addRow();
 
+    /*
+      Run the constraint matrix analyzer on the rows of A, in order
+      to find a new set of basic variables.
+    */
+    List<unsigned> computeIndependentColumns() const;
+
     /*
       Update the variable assignment to reflect a pivot operation,
       without re-computing it from scratch.
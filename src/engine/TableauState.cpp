@@ -16,15 +16,10 @@
 #include "TableauState.h"
 
 #include "BasisFactorizationFactory.h"
-#include "CSRMatrix.h"
 #include "MarabouError.h"
-#include "SparseUnsortedList.h"
 
 TableauState::TableauState()
     : _A( NULL )
-    , _sparseColumnsOfA( NULL )
-    , _sparseRowsOfA( NULL )
-    , _denseA( NULL )
     , _b( NULL )
     , _lowerBounds( NULL )
     , _upperBounds( NULL )
@@ -45,42 +40,6 @@ TableauState::~TableauState()
         _A = NULL;
     }
 
-    if ( _sparseColumnsOfA )
-    {
-        for ( unsigned i = 0; i < _n; ++i )
-        {
-            if ( _sparseColumnsOfA[i] )
-            {
-                delete _sparseColumnsOfA[i];
-                _sparseColumnsOfA[i] = NULL;
-            }
-        }
-
-        delete[] _sparseColumnsOfA;
-        _sparseColumnsOfA = NULL;
-    }
-
-    if ( _sparseRowsOfA )
-    {
-        for ( unsigned i = 0; i < _m; ++i )
-        {
-            if ( _sparseRowsOfA[i] )
-            {
-                delete _sparseRowsOfA[i];
-                _sparseRowsOfA[i] = NULL;
-            }
-        }
-
-        delete[] _sparseRowsOfA;
-        _sparseRowsOfA = NULL;
-    }
-
-    if ( _denseA )
-    {
-        delete[] _denseA;
-        _denseA = NULL;
-    }
-
     if ( _b )
     {
         delete[] _b;
@@ -143,37 +102,10 @@ void TableauState::setDimensions( unsigned m,
     _m = m;
     _n = n;
 
-    _A = new CSRMatrix();
+    _A = new SparseConstraintMatrix();
     if ( !_A )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::A" );
 
-    _sparseColumnsOfA = new SparseUnsortedList *[n];
-    if ( !_sparseColumnsOfA )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::sparseColumnsOfA" );
-
-    for ( unsigned i = 0; i < n; ++i )
-    {
-        _sparseColumnsOfA[i] = new SparseUnsortedList;
-        if ( !_sparseColumnsOfA[i] )
-            throw MarabouError( MarabouError::ALLOCATION_FAILED,
-                                "TableauState::sparseColumnsOfA[i]" );
-    }
-
-    _sparseRowsOfA = new SparseUnsortedList *[m];
-    if ( !_sparseRowsOfA )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::sparseRowsOfA" );
-
-    for ( unsigned i = 0; i < m; ++i )
-    {
-        _sparseRowsOfA[i] = new SparseUnsortedList;
-        if ( !_sparseRowsOfA[i] )
-            throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::sparseRowsOfA[i]" );
-    }
-
-    _denseA = new double[m * n];
-    if ( !_denseA )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::denseA" );
-
     _b = new double[m];
     if ( !_b )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::b" );
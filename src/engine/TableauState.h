@@ -20,7 +20,7 @@
 #include "ITableau.h"
 #include "Map.h"
 #include "Set.h"
-#include "SparseMatrix.h"
+#include "SparseConstraintMatrix.h"
 
 class TableauState
 {
@@ -59,10 +59,7 @@ public:
     /*
       The matrix
     */
-    SparseMatrix *_A;
-    SparseUnsortedList **_sparseColumnsOfA;
-    SparseUnsortedList **_sparseRowsOfA;
-    double *_denseA;
+    SparseConstraintMatrix *_A;
 
     /*
       The right hand side
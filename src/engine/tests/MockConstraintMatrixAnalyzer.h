@@ -51,7 +51,7 @@ public:
     {
     }
 
-    void analyze( const SparseUnsortedList ** /* matrix */, unsigned /* m */, unsigned /* n */ )
+    void analyze( const SparseSpan * /* rows */, unsigned /* m */, unsigned /* n */ )
     {
     }
 
@@ -153,6 +153,11 @@ public:
         return _inputVariables;
     }
 
+    const NLR::NetworkLevelReasoner *getNetworkLevelReasoner() const override
+    {
+        return nullptr;
+    }
+
     void updateScores( DivideStrategy /**/ )
     {
     }
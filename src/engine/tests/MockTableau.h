@@ -20,6 +20,8 @@
 #include "ITableau.h"
 #include "Map.h"
 #include "MockBoundManager.h"
+#include "SparseSpan.h"
+#include "SparseUnsortedArray.h"
 #include "SparseUnsortedList.h"
 #include "TableauRow.h"
 #include "context/context.h"
@@ -495,23 +497,12 @@ public:
         return nextAColumn.get( index );
     }
 
-    void getSparseAColumn( unsigned index, SparseUnsortedList *result ) const
-    {
-        TS_ASSERT( nextAColumn.exists( index ) );
-        TS_ASSERT( nextAColumn.get( index ) );
-
-        for ( unsigned i = 0; i < lastM; ++i )
-        {
-            result->initialize( nextAColumn.get( index ), lastM );
-        }
-    }
-
-    mutable SparseUnsortedList sparseColumn;
-    const SparseUnsortedList *getSparseAColumn( unsigned index ) const
+    mutable SparseUnsortedArray sparseColumn;
+    SparseSpan getSparseAColumn( unsigned index ) const
     {
         TS_ASSERT( nextAColumn.get( index ) );
         sparseColumn.initialize( nextAColumn.get( index ), lastM );
-        return &sparseColumn;
+        return SparseSpan( sparseColumn );
     }
 
     const SparseMatrix *getSparseA() const
@@ -519,26 +510,21 @@ public:
         return NULL;
     }
 
-    double *A;
-    void getSparseARow( unsigned row, SparseUnsortedList *result ) const
+    std::shared_ptr<SparseConstraintMatrix> getSharedConstraintMatrix() const
     {
-        double *temp = new double[lastN];
-
-        for ( unsigned i = 0; i < lastN; ++i )
-        {
-            temp[i] = A[row * lastN + i];
-        }
-
-        result->initialize( temp, lastN );
+        return nullptr;
+    }
 
-        delete[] temp;
+    void setConstraintMatrix( const std::shared_ptr<SparseConstraintMatrix> & /* A */ )
+    {
     }
 
-    mutable SparseUnsortedList sparseRow;
-    const SparseUnsortedList *getSparseARow( unsigned row ) const
+    double *A;
+    mutable SparseUnsortedArray sparseRow;
+    SparseSpan getSparseARow( unsigned row ) const
     {
         sparseRow.initialize( A + ( row * lastN ), lastN );
-        return &sparseRow;
+        return SparseSpan( sparseRow );
     }
 
     void performDegeneratePivot()
@@ -16,6 +16,7 @@
 #include "LargestIntervalDivider.h"
 #include "List.h"
 #include "MStringf.h"
+#include "NetworkLevelReasoner.h"
 #include "SubQuery.h"
 #include "Vector.h"
 
@@ -203,6 +204,64 @@ public:
             delete subQuery;
         }
     }
+
+    void test_create_subqueries_scored_by_the_network()
+    {
+        //   x1 ---0---> x3 --R--> x4
+        //   x2 ---1--->
+        //
+        //   Input Region:
+        //   -2 <= x1 <= 2
+        //   -1 <= x2 <= 1
+        //
+        // x1 has the largest interval, but does not affect the output.
+        // Bisecting x2 instead fixes the ReLU in one of the halves, so x2
+        // is bisected.
+        NLR::NetworkLevelReasoner nlr;
+        nlr.addLayer( 0, NLR::Layer::INPUT, 2 );
+        nlr.addLayer( 1, NLR::Layer::WEIGHTED_SUM, 1 );
+        nlr.addLayer( 2, NLR::Layer::RELU, 1 );
+        nlr.addLayerDependency( 0, 1 );
+        nlr.addLayerDependency( 1, 2 );
+        nlr.setWeight( 0, 0, 1, 0, 0 );
+        nlr.setWeight( 0, 1, 1, 0, 1 );
+        nlr.addActivationSource( 1, 0, 2, 0 );
+        nlr.setNeuronVariable( NLR::NeuronIndex( 0, 0 ), 1 );
+        nlr.setNeuronVariable( NLR::NeuronIndex( 0, 1 ), 2 );
+        nlr.setNeuronVariable( NLR::NeuronIndex( 1, 0 ), 3 );
+        nlr.setNeuronVariable( NLR::NeuronIndex( 2, 0 ), 4 );
+
+        List<unsigned> networkInputVariables( { 1, 2 } );
+        LargestIntervalDivider divider( networkInputVariables, &nlr );
+
+        PiecewiseLinearCaseSplit previousSplit;
+        previousSplit.storeBoundTightening( Tightening( 1, -2.0, Tightening::LB ) );
+        previousSplit.storeBoundTightening( Tightening( 1, 2.0, Tightening::UB ) );
+        previousSplit.storeBoundTightening( Tightening( 2, -1.0, Tightening::LB ) );
+        previousSplit.storeBoundTightening( Tightening( 2, 1.0, Tightening::UB ) );
+
+        SubQueries subQueries;
+        divider.createSubQueries( 2, "", 0, previousSplit, 5, subQueries );
+        TS_ASSERT_EQUALS( subQueries.size(), 2u );
+
+        PiecewiseLinearCaseSplit expectedSplit1;
+        expectedSplit1.storeBoundTightening( Tightening( 1, -2.0, Tightening::LB ) );
+        expectedSplit1.storeBoundTightening( Tightening( 1, 2.0, Tightening::UB ) );
+        expectedSplit1.storeBoundTightening( Tightening( 2, -1.0, Tightening::LB ) );
+        expectedSplit1.storeBoundTightening( Tightening( 2, 0.0, Tightening::UB ) );
+
+        PiecewiseLinearCaseSplit expectedSplit2;
+        expectedSplit2.storeBoundTightening( Tightening( 1, -2.0, Tightening::LB ) );
+        expectedSplit2.storeBoundTightening( Tightening( 1, 2.0, Tightening::UB ) );
+        expectedSplit2.storeBoundTightening( Tightening( 2, 0.0, Tightening::LB ) );
+        expectedSplit2.storeBoundTightening( Tightening( 2, 1.0, Tightening::UB ) );
+
+        TS_ASSERT( *( subQueries.front()->_split ) == expectedSplit1 );
+        TS_ASSERT( *( subQueries.back()->_split ) == expectedSplit2 );
+
+        for ( const auto &subQuery : subQueries )
+            delete subQuery;
+    }
 };
 
 //
@@ -0,0 +1,331 @@
+/*********************                                                        */
+/*! \file Test_RowBoundKernels.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "FloatUtils.h"
+#include "RowBoundKernels.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cxxtest/TestSuite.h>
+
+class RowBoundKernelsTestSuite : public CxxTest::TestSuite
+{
+public:
+    enum {
+        NUMBER_OF_VARIABLES = 500,
+        MAX_ROW_LENGTH = 301,
+    };
+
+    double lowerBounds[NUMBER_OF_VARIABLES];
+    double upperBounds[NUMBER_OF_VARIABLES];
+    double coefficients[MAX_ROW_LENGTH];
+    unsigned indices[MAX_ROW_LENGTH];
+
+    RowBoundKernels::Implementation original;
+
+    void setUp()
+    {
+        original = RowBoundKernels::getImplementation();
+        srand( 1 );
+
+        for ( unsigned i = 0; i < NUMBER_OF_VARIABLES; ++i )
+        {
+            lowerBounds[i] = ( ( rand() % 2000 ) - 1500 ) / 7.0;
+            upperBounds[i] = lowerBounds[i] + ( rand() % 1000 ) / 3.0;
+        }
+
+        for ( unsigned i = 0; i < MAX_ROW_LENGTH; ++i )
+        {
+            // Include some zero and negligible coefficients
+            if ( i % 5 == 0 )
+                coefficients[i] = 0;
+            else if ( i % 7 == 0 )
+                coefficients[i] = 0.00000000001;
+            else
+                coefficients[i] = ( ( rand() % 2000 ) - 1000 ) / 9.0;
+
+            indices[i] = rand() % NUMBER_OF_VARIABLES;
+        }
+    }
+
+    void tearDown()
+    {
+        RowBoundKernels::setImplementation( original );
+    }
+
+    /*
+      Vectorized implementations sum in a different order, so results
+      are only equal up to a relative error
+    */
+    bool almostEqual( double x, double y )
+    {
+        if ( x == y )
+            return true;
+
+        double scale = std::max( 1.0, std::max( FloatUtils::abs( x ), FloatUtils::abs( y ) ) );
+        return FloatUtils::abs( x - y ) <= 0.000000001 * scale;
+    }
+
+    void test_scalar_row_bound()
+    {
+        RowBoundKernels::setImplementation( RowBoundKernels::SCALAR );
+
+        double rowCoefficients[] = { 1, -2, 0, 3 };
+        unsigned rowIndices[] = { 0, 1, 2, 3 };
+        double lbs[] = { -1, 1, -100, 0 };
+        double ubs[] = { 2, 5, 100, 4 };
+
+        // x0 - 2x1 + 3x3, x0 in [-1, 2], x1 in [1, 5], x3 in [0, 4]
+        TS_ASSERT( FloatUtils::areEqual(
+            RowBoundKernels::computeRowBound( 4, rowCoefficients, rowIndices, lbs, ubs, true ),
+            2 - 2 + 12 ) );
+        TS_ASSERT( FloatUtils::areEqual(
+            RowBoundKernels::computeRowBound( 4, rowCoefficients, rowIndices, lbs, ubs, false ),
+            -1 - 10 + 0 ) );
+
+        double minContributions[4];
+        double maxContributions[4];
+        double minSum;
+        double maxSum;
+        unsigned minUnbounded;
+        unsigned maxUnbounded;
+        RowBoundKernels::computeContributions( 4,
+                                               rowCoefficients,
+                                               rowIndices,
+                                               lbs,
+                                               ubs,
+                                               minContributions,
+                                               maxContributions,
+                                               minSum,
+                                               maxSum,
+                                               minUnbounded,
+                                               maxUnbounded );
+
+        TS_ASSERT_EQUALS( minContributions[0], -1 );
+        TS_ASSERT_EQUALS( maxContributions[0], 2 );
+        TS_ASSERT_EQUALS( minContributions[1], -10 );
+        TS_ASSERT_EQUALS( maxContributions[1], -2 );
+        TS_ASSERT_EQUALS( minContributions[2], 0 );
+        TS_ASSERT_EQUALS( maxContributions[2], 0 );
+        TS_ASSERT_EQUALS( minContributions[3], 0 );
+        TS_ASSERT_EQUALS( maxContributions[3], 12 );
+        TS_ASSERT_EQUALS( minSum, -11 );
+        TS_ASSERT_EQUALS( maxSum, 12 );
+        TS_ASSERT_EQUALS( minUnbounded, 0U );
+        TS_ASSERT_EQUALS( maxUnbounded, 0U );
+
+        double residuals[4];
+        RowBoundKernels::computeResiduals(
+            4, maxSum, maxUnbounded, FloatUtils::infinity(), maxContributions, residuals );
+        TS_ASSERT_EQUALS( residuals[0], 10 );
+        TS_ASSERT_EQUALS( residuals[1], 14 );
+        TS_ASSERT_EQUALS( residuals[2], 12 );
+        TS_ASSERT_EQUALS( residuals[3], 0 );
+    }
+
+    void test_unbounded_entries()
+    {
+        double rowCoefficients[] = { 1, -2, 0, 3, 1, 1 };
+        unsigned rowIndices[] = { 0, 1, 2, 3, 4, 5 };
+        double lbs[] = {
+            FloatUtils::negativeInfinity(), 1, FloatUtils::negativeInfinity(), 0, 0, 1 //
+        };
+        double ubs[] = { 2, 5, FloatUtils::infinity(), FloatUtils::infinity(), 1, 1 };
+
+        for ( unsigned implementation = RowBoundKernels::SCALAR;
+              implementation <= RowBoundKernels::AVX2;
+              ++implementation )
+        {
+            if ( !RowBoundKernels::isSupported( (RowBoundKernels::Implementation)implementation ) )
+                continue;
+            RowBoundKernels::setImplementation( (RowBoundKernels::Implementation)implementation );
+
+            /*
+              x0 - 2x1 + 3x3 + x4 + x5, x0 in [-inf, 2], x1 in [1, 5], x3 in [0, inf],
+              x4 in [0, 1], x5 in [1, 1]. The zero coefficient of the unbounded x2
+              is ignored. The lower bound has one unbounded entry, x0, and the
+              upper bound has one, x3.
+            */
+            double minContributions[6];
+            double maxContributions[6];
+            double minSum;
+            double maxSum;
+            unsigned minUnbounded;
+            unsigned maxUnbounded;
+            RowBoundKernels::computeContributions( 6,
+                                                   rowCoefficients,
+                                                   rowIndices,
+                                                   lbs,
+                                                   ubs,
+                                                   minContributions,
+                                                   maxContributions,
+                                                   minSum,
+                                                   maxSum,
+                                                   minUnbounded,
+                                                   maxUnbounded );
+
+            TS_ASSERT_EQUALS( minUnbounded, 1U );
+            TS_ASSERT_EQUALS( maxUnbounded, 1U );
+            TS_ASSERT_EQUALS( minSum, -10 + 0 + 0 + 1 );
+            TS_ASSERT_EQUALS( maxSum, 2 - 2 + 1 + 1 );
+            TS_ASSERT_EQUALS( minContributions[0], FloatUtils::negativeInfinity() );
+            TS_ASSERT_EQUALS( maxContributions[3], FloatUtils::infinity() );
+
+            double residualMin[6];
+            double residualMax[6];
+            RowBoundKernels::computeResiduals( 6,
+                                               minSum,
+                                               minUnbounded,
+                                               FloatUtils::negativeInfinity(),
+                                               minContributions,
+                                               residualMin );
+            RowBoundKernels::computeResiduals(
+                6, maxSum, maxUnbounded, FloatUtils::infinity(), maxContributions, residualMax );
+
+            // Only the residuals without the unbounded entry are bounded
+            TS_ASSERT_EQUALS( residualMin[0], -9 );
+            TS_ASSERT_EQUALS( residualMax[3], 2 );
+            for ( unsigned i = 0; i < 6; ++i )
+            {
+                TS_ASSERT( !FloatUtils::isNan( residualMin[i] ) );
+                TS_ASSERT( !FloatUtils::isNan( residualMax[i] ) );
+
+                if ( i != 0 )
+                    TS_ASSERT_EQUALS( residualMin[i], FloatUtils::negativeInfinity() );
+                if ( i != 3 )
+                    TS_ASSERT_EQUALS( residualMax[i], FloatUtils::infinity() );
+            }
+
+            // With two unbounded entries, all residuals are unbounded
+            ubs[4] = FloatUtils::infinity();
+            RowBoundKernels::computeContributions( 6,
+                                                   rowCoefficients,
+                                                   rowIndices,
+                                                   lbs,
+                                                   ubs,
+                                                   minContributions,
+                                                   maxContributions,
+                                                   minSum,
+                                                   maxSum,
+                                                   minUnbounded,
+                                                   maxUnbounded );
+            TS_ASSERT_EQUALS( maxUnbounded, 2U );
+            RowBoundKernels::computeResiduals(
+                6, maxSum, maxUnbounded, FloatUtils::infinity(), maxContributions, residualMax );
+            for ( unsigned i = 0; i < 6; ++i )
+                TS_ASSERT_EQUALS( residualMax[i], FloatUtils::infinity() );
+            ubs[4] = 1;
+        }
+    }
+
+    void test_implementations_agree()
+    {
+        // Make some of the variables unbounded
+        for ( unsigned i = 0; i < NUMBER_OF_VARIABLES; i += 97 )
+            lowerBounds[i] = FloatUtils::negativeInfinity();
+        for ( unsigned i = 50; i < NUMBER_OF_VARIABLES; i += 89 )
+            upperBounds[i] = FloatUtils::infinity();
+
+        for ( unsigned implementation = RowBoundKernels::SSE;
+              implementation <= RowBoundKernels::AVX2;
+              ++implementation )
+        {
+            RowBoundKernels::Implementation vectorized =
+                (RowBoundKernels::Implementation)implementation;
+            if ( !RowBoundKernels::isSupported( vectorized ) )
+                continue;
+
+            // Cover both the vectorized loops and their scalar tails, for short and long rows
+            for ( unsigned count = 0; count <= MAX_ROW_LENGTH; count += ( count < 20 ? 1 : 31 ) )
+            {
+                for ( bool isUpper : { false, true } )
+                {
+                    RowBoundKernels::setImplementation( RowBoundKernels::SCALAR );
+                    double expected = RowBoundKernels::computeRowBound(
+                        count, coefficients, indices, lowerBounds, upperBounds, isUpper );
+
+                    RowBoundKernels::setImplementation( vectorized );
+                    TS_ASSERT( almostEqual(
+                        RowBoundKernels::computeRowBound(
+                            count, coefficients, indices, lowerBounds, upperBounds, isUpper ),
+                        expected ) );
+                }
+
+                double expectedMin[MAX_ROW_LENGTH];
+                double expectedMax[MAX_ROW_LENGTH];
+                double expectedMinSum;
+                double expectedMaxSum;
+                unsigned expectedMinUnbounded;
+                unsigned expectedMaxUnbounded;
+                RowBoundKernels::setImplementation( RowBoundKernels::SCALAR );
+                RowBoundKernels::computeContributions( count,
+                                                       coefficients,
+                                                       indices,
+                                                       lowerBounds,
+                                                       upperBounds,
+                                                       expectedMin,
+                                                       expectedMax,
+                                                       expectedMinSum,
+                                                       expectedMaxSum,
+                                                       expectedMinUnbounded,
+                                                       expectedMaxUnbounded );
+
+                double expectedResiduals[MAX_ROW_LENGTH];
+                RowBoundKernels::computeResiduals( count,
+                                                   expectedMaxSum,
+                                                   expectedMaxUnbounded,
+                                                   FloatUtils::infinity(),
+                                                   expectedMax,
+                                                   expectedResiduals );
+
+                double min[MAX_ROW_LENGTH];
+                double max[MAX_ROW_LENGTH];
+                double minSum;
+                double maxSum;
+                unsigned minUnbounded;
+                unsigned maxUnbounded;
+                RowBoundKernels::setImplementation( vectorized );
+                RowBoundKernels::computeContributions( count,
+                                                       coefficients,
+                                                       indices,
+                                                       lowerBounds,
+                                                       upperBounds,
+                                                       min,
+                                                       max,
+                                                       minSum,
+                                                       maxSum,
+                                                       minUnbounded,
+                                                       maxUnbounded );
+
+                TS_ASSERT( almostEqual( minSum, expectedMinSum ) );
+                TS_ASSERT( almostEqual( maxSum, expectedMaxSum ) );
+                TS_ASSERT_EQUALS( minUnbounded, expectedMinUnbounded );
+                TS_ASSERT_EQUALS( maxUnbounded, expectedMaxUnbounded );
+
+                double residuals[MAX_ROW_LENGTH];
+                RowBoundKernels::computeResiduals(
+                    count, maxSum, maxUnbounded, FloatUtils::infinity(), max, residuals );
+
+                for ( unsigned i = 0; i < count; ++i )
+                {
+                    TS_ASSERT_EQUALS( min[i], expectedMin[i] );
+                    TS_ASSERT_EQUALS( max[i], expectedMax[i] );
+                    TS_ASSERT( !FloatUtils::isNan( residuals[i] ) );
+                    TS_ASSERT( almostEqual( residuals[i], expectedResiduals[i] ) );
+                }
+            }
+        }
+    }
+};
@@ -418,4 +418,124 @@ public:
                                       Tightening( 2U, 2.0, Tightening::UB ) ),
                            tightenings.end() );
     }
+
+    void test_examine_constraint_matrix_unbounded_variable()
+    {
+        RowBoundTightener tightener( *tableau );
+
+        tableau->setDimensions( 1, 5 );
+        tightener.setBoundsPointers( tableau->getBoundManager().getLowerBounds(),
+                                     tableau->getBoundManager().getUpperBounds() );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 0, FloatUtils::negativeInfinity() ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 0, FloatUtils::infinity() ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 1, -1 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 1, 2 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 2, FloatUtils::negativeInfinity() ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 2, FloatUtils::infinity() ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 3, 0 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 3, 1 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 4, 2 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 4, 2 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tightener.setDimensions() );
+
+        /*
+           A = | 1 -2 0  1 2 | , b = | 1  |
+
+           Equation:
+                x0 -2x1     +x3  +2x4 = 1
+
+           Ranges:
+                x0: unbounded
+                x1: [-1, 2]
+                x2: unbounded
+                x3: [0, 1]
+                x4: [2, 2]
+
+           The equation gives us that -6 <= x0 <= 1. Nothing can be
+           learned about the other variables, as their residuals include
+           the unbounded x0.
+        */
+        double A[] = { 1, -2, 0, 1, 2 };
+        double b[] = { 1 };
+
+        tableau->A = A;
+        tableau->b = b;
+
+        List<Tightening> dontCare;
+        TS_ASSERT_THROWS_NOTHING( tightener.getRowTightenings( dontCare ) );
+
+        TS_ASSERT_THROWS_NOTHING( tightener.examineConstraintMatrix( false ) );
+
+        List<Tightening> tightenings;
+        TS_ASSERT_THROWS_NOTHING( tightener.getRowTightenings( tightenings ) );
+        TS_ASSERT_EQUALS( tightenings.size(), 2U );
+
+        TS_ASSERT_DIFFERS( std::find( tightenings.begin(),
+                                      tightenings.end(),
+                                      Tightening( 0U, -6.0, Tightening::LB ) ),
+                           tightenings.end() );
+        TS_ASSERT_DIFFERS( std::find( tightenings.begin(),
+                                      tightenings.end(),
+                                      Tightening( 0U, 1.0, Tightening::UB ) ),
+                           tightenings.end() );
+
+        for ( unsigned i = 0; i < 5; ++i )
+        {
+            TS_ASSERT( !FloatUtils::isNan( tableau->getBoundManager().getLowerBound( i ) ) );
+            TS_ASSERT( !FloatUtils::isNan( tableau->getBoundManager().getUpperBound( i ) ) );
+        }
+        TS_ASSERT_EQUALS( tableau->getBoundManager().getLowerBound( 2 ),
+                          FloatUtils::negativeInfinity() );
+        TS_ASSERT_EQUALS( tableau->getBoundManager().getUpperBound( 2 ), FloatUtils::infinity() );
+    }
+
+    void test_examine_constraint_matrix_long_row_with_unbounded_variables()
+    {
+        RowBoundTightener tightener( *tableau );
+
+        const unsigned n = 40;
+        tableau->setDimensions( 1, n );
+        tightener.setBoundsPointers( tableau->getBoundManager().getLowerBounds(),
+                                     tableau->getBoundManager().getUpperBounds() );
+
+        // x0 and x1 are unbounded, all other variables are in [0, 1]
+        for ( unsigned i = 0; i < 2; ++i )
+        {
+            TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( i, FloatUtils::negativeInfinity() ) );
+            TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( i, FloatUtils::infinity() ) );
+        }
+        for ( unsigned i = 2; i < n; ++i )
+        {
+            TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( i, 0 ) );
+            TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( i, 1 ) );
+        }
+
+        TS_ASSERT_THROWS_NOTHING( tightener.setDimensions() );
+
+        double A[n];
+        for ( unsigned i = 0; i < n; ++i )
+            A[i] = ( i % 3 == 0 ) ? -1.5 : 2;
+        double b[] = { 3 };
+
+        tableau->A = A;
+        tableau->b = b;
+
+        List<Tightening> dontCare;
+        TS_ASSERT_THROWS_NOTHING( tightener.getRowTightenings( dontCare ) );
+
+        // Every residual includes at least one unbounded variable
+        TS_ASSERT_THROWS_NOTHING( tightener.examineConstraintMatrix( false ) );
+
+        List<Tightening> tightenings;
+        TS_ASSERT_THROWS_NOTHING( tightener.getRowTightenings( tightenings ) );
+        TS_ASSERT( tightenings.empty() );
+
+        for ( unsigned i = 0; i < n; ++i )
+        {
+            TS_ASSERT( !FloatUtils::isNan( tableau->getBoundManager().getLowerBound( i ) ) );
+            TS_ASSERT( !FloatUtils::isNan( tableau->getBoundManager().getUpperBound( i ) ) );
+        }
+    }
 };
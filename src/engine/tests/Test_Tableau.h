@@ -20,6 +20,7 @@
 #include "MockCostFunctionManager.h"
 #include "MockErrno.h"
 #include "Options.h"
+#include "SparseConstraintMatrix.h"
 #include "Tableau.h"
 #include "TableauRow.h"
 #include "TableauState.h"
@@ -1250,6 +1251,71 @@ public:
         TS_ASSERT_THROWS_NOTHING( delete tableau );
     }
 
+    void test_shared_constraint_matrix_is_copied_on_write()
+    {
+        Tableau *tableau = NULL;
+        Tableau *otherTableau = NULL;
+        MockCostFunctionManager costFunctionManager;
+        Context context;
+        BoundManager boundManager( context );
+        Context otherContext;
+        BoundManager otherBoundManager( otherContext );
+
+        TS_ASSERT_THROWS_NOTHING( boundManager.initialize( 7 ) );
+        TS_ASSERT( tableau = new Tableau( boundManager ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setDimensions( 3, 7 ) );
+        initializeTableauValues( *tableau );
+
+        TS_ASSERT_THROWS_NOTHING( otherBoundManager.initialize( 7 ) );
+        TS_ASSERT( otherTableau = new Tableau( otherBoundManager ) );
+        TS_ASSERT_THROWS_NOTHING( otherBoundManager.registerTableau( otherTableau ) );
+        TS_ASSERT_THROWS_NOTHING( otherTableau->setDimensions( 3, 7 ) );
+        otherTableau->registerCostFunctionManager( &costFunctionManager );
+        initializeTableauValues( *otherTableau );
+
+        // Share the matrix of the first tableau
+        std::shared_ptr<SparseConstraintMatrix> A = tableau->getSharedConstraintMatrix();
+        TS_ASSERT_THROWS_NOTHING( otherTableau->setConstraintMatrix( A ) );
+        TS_ASSERT_EQUALS( otherTableau->getSharedConstraintMatrix(), A );
+        TS_ASSERT_EQUALS( otherTableau->getSparseA(), tableau->getSparseA() );
+
+        for ( unsigned i = 0; i < 4; ++i )
+        {
+            TS_ASSERT_THROWS_NOTHING( otherTableau->setLowerBound( i, 1 ) );
+            TS_ASSERT_THROWS_NOTHING( otherTableau->setUpperBound( i, 10 ) );
+        }
+
+        TS_ASSERT_THROWS_NOTHING( otherTableau->setLowerBound( 4, 219 ) );
+        TS_ASSERT_THROWS_NOTHING( otherTableau->setUpperBound( 4, 228 ) );
+        TS_ASSERT_THROWS_NOTHING( otherTableau->setLowerBound( 5, 112 ) );
+        TS_ASSERT_THROWS_NOTHING( otherTableau->setUpperBound( 5, 114 ) );
+        TS_ASSERT_THROWS_NOTHING( otherTableau->setLowerBound( 6, 400 ) );
+        TS_ASSERT_THROWS_NOTHING( otherTableau->setUpperBound( 6, 402 ) );
+
+        List<unsigned> basics = { 4, 5, 6 };
+        TS_ASSERT_THROWS_NOTHING( otherTableau->initializeTableau( basics ) );
+
+        // Adding an equation gives the second tableau its own copy
+        Equation equation;
+        equation.addAddend( 2, 1 );
+        equation.addAddend( -4, 2 );
+        equation.setScalar( 5 );
+
+        TS_ASSERT_THROWS_NOTHING( otherTableau->addEquation( equation ) );
+
+        TS_ASSERT_DIFFERS( otherTableau->getSharedConstraintMatrix(), A );
+        TS_ASSERT_EQUALS( tableau->getSharedConstraintMatrix(), A );
+        TS_ASSERT_EQUALS( otherTableau->getSharedConstraintMatrix()->getM(), 4U );
+        TS_ASSERT_EQUALS( otherTableau->getSharedConstraintMatrix()->getN(), 8U );
+        TS_ASSERT_EQUALS( A->getM(), 3U );
+        TS_ASSERT_EQUALS( A->getN(), 7U );
+        TS_ASSERT_EQUALS( A->get( 0, 0 ), 3.0 );
+        TS_ASSERT_EQUALS( otherTableau->getSharedConstraintMatrix()->get( 3, 1 ), 2.0 );
+
+        TS_ASSERT_THROWS_NOTHING( delete otherTableau );
+        TS_ASSERT_THROWS_NOTHING( delete tableau );
+    }
+
     void test_tighten_bounds()
     {
         Tableau *tableau = NULL;
@@ -0,0 +1,381 @@
+/*********************                                                        */
+/*! \file BatchedBoundPropagator.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "BatchedBoundPropagator.h"
+
+#include "Debug.h"
+#include "FloatUtils.h"
+#include "Layer.h"
+#include "MatrixMultiplication.h"
+#include "NLRError.h"
+
+namespace NLR {
+
+BatchedBoundPropagator::BatchedBoundPropagator( const LayerOwner *layerOwner )
+    : _layerOwner( layerOwner )
+    , _numberOfBoxes( 0 )
+    , _inputLayerSize( 0 )
+{
+}
+
+bool BatchedBoundPropagator::supports( const LayerOwner *layerOwner )
+{
+    for ( const auto &pair : layerOwner->getLayerIndexToLayer() )
+    {
+        Layer::Type type = pair.second->getLayerType();
+        if ( type != Layer::INPUT && type != Layer::WEIGHTED_SUM && type != Layer::RELU )
+            return false;
+    }
+    return true;
+}
+
+void BatchedBoundPropagator::run( const Vector<Vector<double>> &inputLbs,
+                                  const Vector<Vector<double>> &inputUbs )
+{
+    ASSERT( inputLbs.size() == inputUbs.size() );
+
+    _numberOfBoxes = inputLbs.size();
+    _inputLayerSize = _layerOwner->getLayer( 0 )->getSize();
+
+    for ( const auto &pair : _layerOwner->getLayerIndexToLayer() )
+    {
+        const Layer *layer = pair.second;
+        allocateLayer( pair.first, layer->getSize() );
+
+        switch ( layer->getLayerType() )
+        {
+        case Layer::INPUT:
+            propagateInput( inputLbs, inputUbs );
+            break;
+
+        case Layer::WEIGHTED_SUM:
+            propagateWeightedSum( layer );
+            break;
+
+        case Layer::RELU:
+            propagateRelu( layer );
+            break;
+
+        default:
+            throw NLRError( NLRError::LAYER_TYPE_NOT_SUPPORTED,
+                            "Batched bound propagation only supports weighted sum and ReLU layers" );
+        }
+    }
+}
+
+unsigned BatchedBoundPropagator::getNumberOfBoxes() const
+{
+    return _numberOfBoxes;
+}
+
+const double *BatchedBoundPropagator::getLbs( unsigned layerIndex, unsigned box ) const
+{
+    return _lbs[layerIndex].data() + box * _layerOwner->getLayer( layerIndex )->getSize();
+}
+
+const double *BatchedBoundPropagator::getUbs( unsigned layerIndex, unsigned box ) const
+{
+    return _ubs[layerIndex].data() + box * _layerOwner->getLayer( layerIndex )->getSize();
+}
+
+void BatchedBoundPropagator::allocateLayer( unsigned layerIndex, unsigned size )
+{
+    unsigned boundsSize = _numberOfBoxes * size;
+    unsigned symbolicSize = _numberOfBoxes * ( _inputLayerSize + 1 ) * size;
+
+    _lbs[layerIndex].assign( boundsSize, 0 );
+    _ubs[layerIndex].assign( boundsSize, 0 );
+    _symbolicLb[layerIndex].assign( symbolicSize, 0 );
+    _symbolicUb[layerIndex].assign( symbolicSize, 0 );
+    _symbolicLbOfLb[layerIndex].assign( boundsSize, 0 );
+    _symbolicUbOfLb[layerIndex].assign( boundsSize, 0 );
+    _symbolicLbOfUb[layerIndex].assign( boundsSize, 0 );
+    _symbolicUbOfUb[layerIndex].assign( boundsSize, 0 );
+}
+
+void BatchedBoundPropagator::propagateInput( const Vector<Vector<double>> &inputLbs,
+                                             const Vector<Vector<double>> &inputUbs )
+{
+    unsigned size = _inputLayerSize;
+    Vector<double> &lbs = _lbs[0];
+    Vector<double> &ubs = _ubs[0];
+    Vector<double> &symbolicLb = _symbolicLb[0];
+    Vector<double> &symbolicUb = _symbolicUb[0];
+
+    for ( unsigned k = 0; k < _numberOfBoxes; ++k )
+    {
+        ASSERT( inputLbs[k].size() == size && inputUbs[k].size() == size );
+
+        for ( unsigned i = 0; i < size; ++i )
+        {
+            lbs[k * size + i] = inputLbs[k][i];
+            ubs[k * size + i] = inputUbs[k][i];
+
+            unsigned row = k * ( size + 1 ) + i;
+            symbolicLb[row * size + i] = 1;
+            symbolicUb[row * size + i] = 1;
+        }
+    }
+
+    _symbolicLbOfLb[0] = lbs;
+    _symbolicUbOfLb[0] = ubs;
+    _symbolicLbOfUb[0] = lbs;
+    _symbolicUbOfUb[0] = ubs;
+}
+
+void BatchedBoundPropagator::propagateWeightedSum( const Layer *layer )
+{
+    unsigned layerIndex = layer->getLayerIndex();
+    unsigned size = layer->getSize();
+    const double *bias = layer->getBiases();
+
+    Vector<double> &lbs = _lbs[layerIndex];
+    Vector<double> &ubs = _ubs[layerIndex];
+    Vector<double> &symbolicLb = _symbolicLb[layerIndex];
+    Vector<double> &symbolicUb = _symbolicUb[layerIndex];
+
+    for ( unsigned k = 0; k < _numberOfBoxes; ++k )
+    {
+        unsigned biasRow = k * ( _inputLayerSize + 1 ) + _inputLayerSize;
+        for ( unsigned i = 0; i < size; ++i )
+        {
+            lbs[k * size + i] = bias[i];
+            ubs[k * size + i] = bias[i];
+            symbolicLb[biasRow * size + i] = bias[i];
+            symbolicUb[biasRow * size + i] = bias[i];
+        }
+    }
+
+    /*
+      For every source layer, one multiplication covers the interval bounds
+      of all the boxes, and one covers their symbolic bounds and biases
+    */
+    for ( const auto &source : layer->getSourceLayers() )
+    {
+        const double *weights = layer->getWeights( source.first );
+
+        signSplitMatrixMultiplication( _lbs[source.first].data(),
+                                       _ubs[source.first].data(),
+                                       weights,
+                                       weights,
+                                       lbs.data(),
+                                       ubs.data(),
+                                       _numberOfBoxes,
+                                       source.second,
+                                       size );
+
+        signSplitMatrixMultiplication( _symbolicLb[source.first].data(),
+                                       _symbolicUb[source.first].data(),
+                                       weights,
+                                       weights,
+                                       symbolicLb.data(),
+                                       symbolicUb.data(),
+                                       _numberOfBoxes * ( _inputLayerSize + 1 ),
+                                       source.second,
+                                       size );
+    }
+
+    fixEliminatedNeurons( layer );
+    concretize( layer );
+}
+
+void BatchedBoundPropagator::propagateRelu( const Layer *layer )
+{
+    unsigned layerIndex = layer->getLayerIndex();
+    unsigned size = layer->getSize();
+
+    Vector<double> &lbs = _lbs[layerIndex];
+    Vector<double> &ubs = _ubs[layerIndex];
+    Vector<double> &symbolicLb = _symbolicLb[layerIndex];
+    Vector<double> &symbolicUb = _symbolicUb[layerIndex];
+
+    for ( unsigned i = 0; i < size; ++i )
+    {
+        if ( layer->neuronEliminated( i ) )
+            continue;
+
+        NeuronIndex source = *layer->getActivationSources( i ).begin();
+        unsigned sourceSize = _layerOwner->getLayer( source._layer )->getSize();
+        unsigned s = source._neuron;
+
+        const Vector<double> &sourceLbs = _lbs[source._layer];
+        const Vector<double> &sourceUbs = _ubs[source._layer];
+        const Vector<double> &sourceSymbolicLb = _symbolicLb[source._layer];
+        const Vector<double> &sourceSymbolicUb = _symbolicUb[source._layer];
+
+        for ( unsigned k = 0; k < _numberOfBoxes; ++k )
+        {
+            double sourceLb = sourceLbs[k * sourceSize + s];
+            double sourceUb = sourceUbs[k * sourceSize + s];
+
+            lbs[k * size + i] = FloatUtils::max( sourceLb, 0 );
+            ubs[k * size + i] = FloatUtils::max( sourceUb, 0 );
+
+            // Inactive: the symbolic bounds stay zero
+            if ( !FloatUtils::isPositive( sourceUb ) )
+                continue;
+
+            // Active, or not fixed: start from the source's symbolic bounds
+            double lowerFactor = 1;
+            double upperFactor = 1;
+            double upperShift = 0;
+
+            if ( FloatUtils::isNegative( sourceLb ) )
+            {
+                /*
+                  Not fixed. Relax as in symbolic bound tightening (see
+                  Layer::computeSymbolicBoundsForRelu): the symbolic upper
+                  bound is scaled and shifted if it may be negative, and the
+                  symbolic lower bound is scaled, or dropped if it is never
+                  positive.
+                */
+                double lbOfLb = _symbolicLbOfLb[source._layer][k * sourceSize + s];
+                double ubOfLb = _symbolicUbOfLb[source._layer][k * sourceSize + s];
+                double lbOfUb = _symbolicLbOfUb[source._layer][k * sourceSize + s];
+                double ubOfUb = _symbolicUbOfUb[source._layer][k * sourceSize + s];
+
+                if ( lbOfUb <= 0 )
+                {
+                    upperFactor = ubOfUb / ( ubOfUb - lbOfUb );
+                    upperShift = -lbOfUb * upperFactor;
+                }
+
+                if ( ubOfLb <= 0 )
+                    lowerFactor = 0;
+                else
+                    lowerFactor = ubOfLb / ( ubOfLb - lbOfLb );
+            }
+
+            unsigned firstRow = k * ( _inputLayerSize + 1 );
+            for ( unsigned j = 0; j <= _inputLayerSize; ++j )
+            {
+                unsigned row = firstRow + j;
+                symbolicLb[row * size + i] =
+                    sourceSymbolicLb[row * sourceSize + s] * lowerFactor;
+                symbolicUb[row * size + i] =
+                    sourceSymbolicUb[row * sourceSize + s] * upperFactor;
+            }
+
+            unsigned biasRow = firstRow + _inputLayerSize;
+            symbolicUb[biasRow * size + i] += upperShift;
+        }
+    }
+
+    fixEliminatedNeurons( layer );
+    concretize( layer );
+}
+
+void BatchedBoundPropagator::fixEliminatedNeurons( const Layer *layer )
+{
+    unsigned layerIndex = layer->getLayerIndex();
+    unsigned size = layer->getSize();
+
+    for ( unsigned i = 0; i < size; ++i )
+    {
+        if ( !layer->neuronEliminated( i ) )
+            continue;
+
+        double value = layer->getEliminatedNeuronValue( i );
+        for ( unsigned k = 0; k < _numberOfBoxes; ++k )
+        {
+            _lbs[layerIndex][k * size + i] = value;
+            _ubs[layerIndex][k * size + i] = value;
+
+            unsigned firstRow = k * ( _inputLayerSize + 1 );
+            for ( unsigned j = 0; j < _inputLayerSize; ++j )
+            {
+                _symbolicLb[layerIndex][( firstRow + j ) * size + i] = 0;
+                _symbolicUb[layerIndex][( firstRow + j ) * size + i] = 0;
+            }
+
+            unsigned biasRow = firstRow + _inputLayerSize;
+            _symbolicLb[layerIndex][biasRow * size + i] = value;
+            _symbolicUb[layerIndex][biasRow * size + i] = value;
+        }
+    }
+}
+
+void BatchedBoundPropagator::concretize( const Layer *layer )
+{
+    unsigned layerIndex = layer->getLayerIndex();
+    unsigned size = layer->getSize();
+
+    Vector<double> &lbs = _lbs[layerIndex];
+    Vector<double> &ubs = _ubs[layerIndex];
+    const Vector<double> &symbolicLb = _symbolicLb[layerIndex];
+    const Vector<double> &symbolicUb = _symbolicUb[layerIndex];
+    const Vector<double> &inputLbs = _lbs[0];
+    const Vector<double> &inputUbs = _ubs[0];
+
+    for ( unsigned k = 0; k < _numberOfBoxes; ++k )
+    {
+        unsigned firstRow = k * ( _inputLayerSize + 1 );
+        unsigned biasRow = firstRow + _inputLayerSize;
+
+        for ( unsigned i = 0; i < size; ++i )
+        {
+            double lbOfLb = symbolicLb[biasRow * size + i];
+            double ubOfLb = lbOfLb;
+            double lbOfUb = symbolicUb[biasRow * size + i];
+            double ubOfUb = lbOfUb;
+
+            for ( unsigned j = 0; j < _inputLayerSize; ++j )
+            {
+                double inputLb = inputLbs[k * _inputLayerSize + j];
+                double inputUb = inputUbs[k * _inputLayerSize + j];
+
+                double entry = symbolicLb[( firstRow + j ) * size + i];
+                if ( entry >= 0 )
+                {
+                    lbOfLb += entry * inputLb;
+                    ubOfLb += entry * inputUb;
+                }
+                else
+                {
+                    lbOfLb += entry * inputUb;
+                    ubOfLb += entry * inputLb;
+                }
+
+                entry = symbolicUb[( firstRow + j ) * size + i];
+                if ( entry >= 0 )
+                {
+                    lbOfUb += entry * inputLb;
+                    ubOfUb += entry * inputUb;
+                }
+                else
+                {
+                    lbOfUb += entry * inputUb;
+                    ubOfUb += entry * inputLb;
+                }
+            }
+
+            unsigned index = k * size + i;
+            _symbolicLbOfLb[layerIndex][index] = lbOfLb;
+            _symbolicUbOfLb[layerIndex][index] = ubOfLb;
+            _symbolicLbOfUb[layerIndex][index] = lbOfUb;
+            _symbolicUbOfUb[layerIndex][index] = ubOfUb;
+
+            if ( layer->neuronEliminated( i ) )
+                continue;
+
+            if ( lbOfLb > lbs[index] )
+                lbs[index] = lbOfLb;
+            if ( ubOfUb < ubs[index] )
+                ubs[index] = ubOfUb;
+        }
+    }
+}
+
+} // namespace NLR
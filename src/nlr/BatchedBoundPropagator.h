@@ -0,0 +1,105 @@
+/*********************                                                        */
+/*! \file BatchedBoundPropagator.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Interval arithmetic and symbolic bound propagation for many input boxes
+ ** at once, e.g. for scoring candidate bisections of an input region.
+ **
+ ** The bounds of each box are computed independently of the current bounds
+ ** of the network, as if the box were the whole input region. The symbolic
+ ** bounds of all the boxes are stacked in the row dimension of a single
+ ** matrix per layer, so that propagating them through a weighted sum layer
+ ** is one matrix multiplication for the whole batch.
+ **
+ ** Only networks of weighted sum and ReLU layers are supported.
+
+ **/
+
+#ifndef __BatchedBoundPropagator_h__
+#define __BatchedBoundPropagator_h__
+
+#include "LayerOwner.h"
+#include "Map.h"
+#include "Vector.h"
+
+namespace NLR {
+
+class BatchedBoundPropagator
+{
+public:
+    BatchedBoundPropagator( const LayerOwner *layerOwner );
+
+    /*
+      Whether the network only has layers that are supported
+    */
+    static bool supports( const LayerOwner *layerOwner );
+
+    /*
+      Compute the bounds of every layer, for each input box. inputLbs[k]
+      and inputUbs[k] are the bounds of the input layer's neurons in box k.
+    */
+    void run( const Vector<Vector<double>> &inputLbs, const Vector<Vector<double>> &inputUbs );
+
+    unsigned getNumberOfBoxes() const;
+
+    /*
+      The bounds of the neurons of a layer in the given box
+    */
+    const double *getLbs( unsigned layerIndex, unsigned box ) const;
+    const double *getUbs( unsigned layerIndex, unsigned box ) const;
+
+private:
+    const LayerOwner *_layerOwner;
+    unsigned _numberOfBoxes;
+    unsigned _inputLayerSize;
+
+    /*
+      For every layer index: the concrete bounds, with a row of the layer's
+      size per box; and the symbolic bounds in terms of the input layer,
+      with a block of ( inputLayerSize + 1 ) rows per box, the last of which
+      is the bias.
+    */
+    Map<unsigned, Vector<double>> _lbs;
+    Map<unsigned, Vector<double>> _ubs;
+    Map<unsigned, Vector<double>> _symbolicLb;
+    Map<unsigned, Vector<double>> _symbolicUb;
+
+    /*
+      The concretizations of the symbolic bounds, with a row per box, as
+      needed for relaxing ReLUs
+    */
+    Map<unsigned, Vector<double>> _symbolicLbOfLb;
+    Map<unsigned, Vector<double>> _symbolicUbOfLb;
+    Map<unsigned, Vector<double>> _symbolicLbOfUb;
+    Map<unsigned, Vector<double>> _symbolicUbOfUb;
+
+    void allocateLayer( unsigned layerIndex, unsigned size );
+
+    void propagateInput( const Vector<Vector<double>> &inputLbs,
+                         const Vector<Vector<double>> &inputUbs );
+    void propagateWeightedSum( const Layer *layer );
+    void propagateRelu( const Layer *layer );
+
+    /*
+      Set the symbolic and concrete bounds of the layer's eliminated
+      neurons to their constant values
+    */
+    void fixEliminatedNeurons( const Layer *layer );
+
+    /*
+      Concretize the symbolic bounds of a layer over each box, and tighten
+      its concrete bounds accordingly
+    */
+    void concretize( const Layer *layer );
+};
+
+} // namespace NLR
+
+#endif // __BatchedBoundPropagator_h__
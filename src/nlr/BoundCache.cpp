@@ -0,0 +1,541 @@
+/*********************                                                        */
+/*! \file BoundCache.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "BoundCache.h"
+
+#include "AutoFile.h"
+#include "CommonError.h"
+#include "Debug.h"
+#include "FloatUtils.h"
+#include "GlobalConfiguration.h"
+#include "Layer.h"
+#include "MStringf.h"
+#include "NLRError.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace NLR {
+
+static const char *const BOUND_CACHE_FILE_HEADER = "marabou-bound-cache 1";
+
+static const unsigned long long FNV_OFFSET_BASIS = 14695981039346656037ULL;
+static const unsigned long long FNV_PRIME = 1099511628211ULL;
+
+static void hashBytes( unsigned long long &hash, const void *data, unsigned length )
+{
+    const unsigned char *bytes = (const unsigned char *)data;
+    for ( unsigned i = 0; i < length; ++i )
+    {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+}
+
+static void hashUnsigned( unsigned long long &hash, unsigned value )
+{
+    hashBytes( hash, &value, sizeof( value ) );
+}
+
+static void hashDouble( unsigned long long &hash, double value )
+{
+    // -0.0 and 0.0 are the same bound
+    if ( value == 0 )
+        value = 0;
+    hashBytes( hash, &value, sizeof( value ) );
+}
+
+static bool isOneSided( double lb, double ub )
+{
+    return !FloatUtils::isNegative( lb ) || !FloatUtils::isPositive( ub );
+}
+
+/*
+  Eliminated neurons are left out of the network hash: the preprocessor
+  eliminates different neurons for different input boxes, and an
+  eliminated neuron is just a neuron whose bounds are fixed, which
+  entryApplies() already compares.
+*/
+unsigned long long BoundCache::computeNetworkHash( const Map<unsigned, Layer *> &layers )
+{
+    unsigned long long hash = FNV_OFFSET_BASIS;
+    for ( const auto &pair : layers )
+    {
+        const Layer *layer = pair.second;
+        unsigned size = layer->getSize();
+
+        hashUnsigned( hash, pair.first );
+        hashUnsigned( hash, layer->getLayerType() );
+        hashUnsigned( hash, size );
+        hashDouble( hash, layer->getAlpha() );
+
+        if ( layer->getLayerType() == Layer::WEIGHTED_SUM )
+        {
+            for ( const auto &source : layer->getSourceLayers() )
+            {
+                hashUnsigned( hash, source.first );
+                const double *weights = layer->getWeights( source.first );
+                for ( unsigned i = 0; i < source.second * size; ++i )
+                    hashDouble( hash, weights[i] );
+            }
+
+            const double *biases = layer->getBiases();
+            for ( unsigned i = 0; i < size; ++i )
+                hashDouble( hash, biases[i] );
+        }
+        else if ( layer->getLayerType() != Layer::INPUT )
+        {
+            for ( unsigned i = 0; i < size; ++i )
+            {
+                for ( const auto &source : layer->getActivationSources( i ) )
+                {
+                    hashUnsigned( hash, source._layer );
+                    hashUnsigned( hash, source._neuron );
+                }
+            }
+        }
+    }
+
+    return hash;
+}
+
+unsigned long long BoundCache::computeInputBoxHash( const Vector<double> &lbs,
+                                                    const Vector<double> &ubs )
+{
+    unsigned long long hash = FNV_OFFSET_BASIS;
+    for ( unsigned i = 0; i < lbs.size(); ++i )
+    {
+        hashDouble( hash, lbs[i] );
+        hashDouble( hash, ubs[i] );
+    }
+    return hash;
+}
+
+unsigned long long
+BoundCache::computePhaseFixingsHash( const Map<unsigned, Layer *> &layers,
+                                     const Map<unsigned, Vector<double>> &lbs,
+                                     const Map<unsigned, Vector<double>> &ubs )
+{
+    unsigned long long hash = FNV_OFFSET_BASIS;
+    for ( const auto &pair : layers )
+    {
+        Layer::Type type = pair.second->getLayerType();
+        if ( type != Layer::RELU && type != Layer::LEAKY_RELU && type != Layer::SIGN &&
+             type != Layer::ABSOLUTE_VALUE )
+            continue;
+
+        for ( unsigned i = 0; i < pair.second->getSize(); ++i )
+        {
+            if ( pair.second->neuronEliminated( i ) )
+                continue;
+
+            NeuronIndex source = *pair.second->getActivationSources( i ).begin();
+            if ( !lbs.exists( source._layer ) )
+                continue;
+
+            double lb = lbs[source._layer][source._neuron];
+            double ub = ubs[source._layer][source._neuron];
+            if ( !isOneSided( lb, ub ) )
+                continue;
+
+            hashUnsigned( hash, pair.first );
+            hashUnsigned( hash, i );
+            hashUnsigned( hash, FloatUtils::isNegative( lb ) ? 0 : 1 );
+        }
+    }
+    return hash;
+}
+
+unsigned BoundCache::applyTo( LayerOwner *layerOwner ) const
+{
+    const Map<unsigned, Layer *> &layers = layerOwner->getLayerIndexToLayer();
+    unsigned long long networkHash = computeNetworkHash( layers );
+
+    unsigned applied = 0;
+    for ( const auto &entry : _entries )
+    {
+        if ( entry._networkHash != networkHash || !entryApplies( entry, layers ) )
+            continue;
+
+        applyEntry( entry, layerOwner );
+        ++applied;
+    }
+
+    return applied;
+}
+
+bool BoundCache::entryApplies( const Entry &entry, const Map<unsigned, Layer *> &layers )
+{
+    if ( entry._startLbs.size() != layers.size() )
+        return false;
+
+    for ( const auto &pair : layers )
+    {
+        const Layer *layer = pair.second;
+        if ( !entry._startLbs.exists( pair.first ) ||
+             entry._startLbs[pair.first].size() != layer->getSize() )
+            return false;
+
+        const Vector<double> &startLbs = entry._startLbs[pair.first];
+        const Vector<double> &startUbs = entry._startUbs[pair.first];
+        for ( unsigned i = 0; i < layer->getSize(); ++i )
+        {
+            if ( layer->getLb( i ) < startLbs[i] || layer->getUb( i ) > startUbs[i] )
+                return false;
+        }
+    }
+
+    return true;
+}
+
+void BoundCache::applyEntry( const Entry &entry, LayerOwner *layerOwner )
+{
+    const Map<unsigned, Layer *> &layers = layerOwner->getLayerIndexToLayer();
+    const Layer *inputLayer = layerOwner->getLayer( 0 );
+    unsigned inputLayerSize = inputLayer->getSize();
+
+    for ( const auto &pair : layers )
+    {
+        Layer *layer = pair.second;
+        unsigned size = layer->getSize();
+        bool hasSymbolicBounds = entry._symbolicLb.exists( pair.first );
+
+        for ( unsigned i = 0; i < size; ++i )
+        {
+            if ( layer->neuronEliminated( i ) )
+                continue;
+
+            double lb = entry._lbs[pair.first][i];
+            double ub = entry._ubs[pair.first][i];
+
+            // The symbolic bounds are valid for any input in the box they
+            // were computed for, so they may be tighter on the current box
+            if ( hasSymbolicBounds )
+            {
+                const Vector<double> &symbolicLb = entry._symbolicLb[pair.first];
+                const Vector<double> &symbolicUb = entry._symbolicUb[pair.first];
+                double concreteLb = entry._symbolicLowerBias[pair.first][i];
+                double concreteUb = entry._symbolicUpperBias[pair.first][i];
+
+                for ( unsigned j = 0; j < inputLayerSize; ++j )
+                {
+                    double inputLb = inputLayer->getLb( j );
+                    double inputUb = inputLayer->getUb( j );
+
+                    double coefficient = symbolicLb[j * size + i];
+                    concreteLb += coefficient * ( coefficient >= 0 ? inputLb : inputUb );
+
+                    coefficient = symbolicUb[j * size + i];
+                    concreteUb += coefficient * ( coefficient >= 0 ? inputUb : inputLb );
+                }
+
+                if ( concreteLb > lb )
+                    lb = concreteLb;
+                if ( concreteUb < ub )
+                    ub = concreteUb;
+            }
+
+            unsigned variable = layer->neuronToVariable( i );
+            if ( FloatUtils::gt( lb, layer->getLb( i ) ) )
+            {
+                layer->setLb( i, lb );
+                layerOwner->receiveTighterBound( Tightening( variable, lb, Tightening::LB ) );
+            }
+
+            if ( FloatUtils::lt( ub, layer->getUb( i ) ) )
+            {
+                layer->setUb( i, ub );
+                layerOwner->receiveTighterBound( Tightening( variable, ub, Tightening::UB ) );
+            }
+        }
+    }
+}
+
+bool BoundCache::sameStartingBounds( const Entry &entry, const Entry &other )
+{
+    return entry._networkHash == other._networkHash &&
+           entry._inputBoxHash == other._inputBoxHash &&
+           entry._phaseFixingsHash == other._phaseFixingsHash &&
+           entry._startLbs == other._startLbs && entry._startUbs == other._startUbs;
+}
+
+void BoundCache::store( const LayerOwner &layerOwner,
+                        const Map<unsigned, Vector<double>> &startLbs,
+                        const Map<unsigned, Vector<double>> &startUbs,
+                        bool storeSymbolicBounds )
+{
+    const Map<unsigned, Layer *> &layers = layerOwner.getLayerIndexToLayer();
+
+    Entry entry;
+    entry._networkHash = computeNetworkHash( layers );
+    entry._inputBoxHash = computeInputBoxHash( startLbs[0], startUbs[0] );
+    entry._phaseFixingsHash = computePhaseFixingsHash( layers, startLbs, startUbs );
+    entry._startLbs = startLbs;
+    entry._startUbs = startUbs;
+
+    for ( const auto &pair : layers )
+    {
+        const Layer *layer = pair.second;
+        unsigned size = layer->getSize();
+        entry._lbs[pair.first] = Vector<double>( layer->getLbs(), layer->getLbs() + size );
+        entry._ubs[pair.first] = Vector<double>( layer->getUbs(), layer->getUbs() + size );
+
+        if ( !storeSymbolicBounds || layer->getLayerType() == Layer::INPUT ||
+             !layer->getSymbolicLb() )
+            continue;
+
+        const double *symbolicLb = layer->getSymbolicLb();
+        const double *symbolicUb = layer->getSymbolicUb();
+        const double *symbolicLowerBias = layer->getSymbolicLowerBias();
+        const double *symbolicUpperBias = layer->getSymbolicUpperBias();
+        unsigned symbolicSize = layerOwner.getLayer( 0 )->getSize() * size;
+
+        entry._symbolicLb[pair.first] = Vector<double>( symbolicLb, symbolicLb + symbolicSize );
+        entry._symbolicUb[pair.first] = Vector<double>( symbolicUb, symbolicUb + symbolicSize );
+        entry._symbolicLowerBias[pair.first] =
+            Vector<double>( symbolicLowerBias, symbolicLowerBias + size );
+        entry._symbolicUpperBias[pair.first] =
+            Vector<double>( symbolicUpperBias, symbolicUpperBias + size );
+    }
+
+    // Refine an existing entry for the same starting bounds: both results are
+    // sound, so their intersection is too
+    for ( auto &existing : _entries )
+    {
+        if ( !sameStartingBounds( existing, entry ) )
+            continue;
+
+        for ( auto &pair : existing._lbs )
+        {
+            Vector<double> &lbs = pair.second;
+            Vector<double> &ubs = existing._ubs[pair.first];
+            for ( unsigned i = 0; i < lbs.size(); ++i )
+            {
+                if ( entry._lbs[pair.first][i] > lbs[i] )
+                    lbs[i] = entry._lbs[pair.first][i];
+                if ( entry._ubs[pair.first][i] < ubs[i] )
+                    ubs[i] = entry._ubs[pair.first][i];
+            }
+        }
+
+        if ( storeSymbolicBounds )
+        {
+            existing._symbolicLb = entry._symbolicLb;
+            existing._symbolicUb = entry._symbolicUb;
+            existing._symbolicLowerBias = entry._symbolicLowerBias;
+            existing._symbolicUpperBias = entry._symbolicUpperBias;
+        }
+        return;
+    }
+
+    _entries.append( entry );
+    while ( _entries.size() > GlobalConfiguration::NLR_BOUND_CACHE_MAX_ENTRIES )
+        _entries.erase( _entries.begin() );
+}
+
+unsigned BoundCache::getNumberOfEntries() const
+{
+    return _entries.size();
+}
+
+const List<BoundCache::Entry> &BoundCache::getEntries() const
+{
+    return _entries;
+}
+
+void BoundCache::clear()
+{
+    _entries.clear();
+}
+
+/*
+  The cache file is a text file. Doubles are written in hexadecimal
+  floating point notation, so that they are read back exactly.
+
+    marabou-bound-cache 1
+    <number of entries>
+    For every entry:
+      entry <network hash> <input box hash> <phase fixings hash> <number of layers>
+      For every layer:
+        layer <index> <size> <1 if it has symbolic bounds, 0 otherwise>
+        <start lbs>
+        <start ubs>
+        <lbs>
+        <ubs>
+        If it has symbolic bounds:
+          <symbolic lb>
+          <symbolic ub>
+          <symbolic lower bias>
+          <symbolic upper bias>
+*/
+
+static String doublesToString( const Vector<double> &values )
+{
+    String result;
+    for ( unsigned i = 0; i < values.size(); ++i )
+        result += Stringf( i == 0 ? "%a" : " %a", values[i] );
+    return result + "\n";
+}
+
+void BoundCache::save( const String &path ) const
+{
+    AutoFile file( path );
+    file->open( IFile::MODE_WRITE_TRUNCATE );
+
+    file->write( Stringf( "%s\n%u\n", BOUND_CACHE_FILE_HEADER, _entries.size() ) );
+    for ( const auto &entry : _entries )
+    {
+        file->write( Stringf( "entry %llu %llu %llu %u\n",
+                              entry._networkHash,
+                              entry._inputBoxHash,
+                              entry._phaseFixingsHash,
+                              entry._lbs.size() ) );
+
+        for ( const auto &pair : entry._lbs )
+        {
+            unsigned index = pair.first;
+            bool hasSymbolicBounds = entry._symbolicLb.exists( index );
+
+            file->write( Stringf(
+                "layer %u %u %u\n", index, pair.second.size(), hasSymbolicBounds ? 1 : 0 ) );
+            file->write( doublesToString( entry._startLbs[index] ) );
+            file->write( doublesToString( entry._startUbs[index] ) );
+            file->write( doublesToString( entry._lbs[index] ) );
+            file->write( doublesToString( entry._ubs[index] ) );
+
+            if ( hasSymbolicBounds )
+            {
+                file->write( doublesToString( entry._symbolicLb[index] ) );
+                file->write( doublesToString( entry._symbolicUb[index] ) );
+                file->write( doublesToString( entry._symbolicLowerBias[index] ) );
+                file->write( doublesToString( entry._symbolicUpperBias[index] ) );
+            }
+        }
+    }
+}
+
+static void throwCorrupted( const String &path )
+{
+    throw NLRError( NLRError::BOUND_CACHE_FILE_CORRUPTED,
+                    Stringf( "Bound cache file %s is corrupted", path.ascii() ).ascii() );
+}
+
+static unsigned long long parseUnsigned( const String &token, const String &path )
+{
+    char *end;
+    unsigned long long value = strtoull( token.ascii(), &end, 10 );
+    if ( token.length() == 0 || *end != '\0' )
+        throwCorrupted( path );
+    return value;
+}
+
+static Vector<String> readTokens( IFile &file, unsigned count, const String &path )
+{
+    Vector<String> tokens;
+    for ( const auto &token : file.readLine().trim().tokenize( " " ) )
+        tokens.append( token );
+
+    if ( tokens.size() != count )
+        throwCorrupted( path );
+    return tokens;
+}
+
+static Vector<double> readDoubles( IFile &file, unsigned count, const String &path )
+{
+    Vector<double> values;
+    for ( const auto &token : readTokens( file, count, path ) )
+    {
+        char *end;
+        double value = strtod( token.ascii(), &end );
+        if ( *end != '\0' )
+            throwCorrupted( path );
+        values.append( value );
+    }
+    return values;
+}
+
+void BoundCache::load( const String &path )
+{
+    List<Entry> entries;
+
+    try
+    {
+        AutoFile file( path );
+        file->open( IFile::MODE_READ );
+
+        if ( file->readLine().trim() != BOUND_CACHE_FILE_HEADER )
+            throwCorrupted( path );
+
+        unsigned numberOfEntries = parseUnsigned( readTokens( file, 1, path )[0], path );
+        for ( unsigned e = 0; e < numberOfEntries; ++e )
+        {
+            Vector<String> tokens = readTokens( file, 5, path );
+            if ( tokens[0] != "entry" )
+                throwCorrupted( path );
+
+            Entry entry;
+            entry._networkHash = parseUnsigned( tokens[1], path );
+            entry._inputBoxHash = parseUnsigned( tokens[2], path );
+            entry._phaseFixingsHash = parseUnsigned( tokens[3], path );
+            unsigned numberOfLayers = parseUnsigned( tokens[4], path );
+
+            unsigned inputLayerSize = 0;
+            for ( unsigned l = 0; l < numberOfLayers; ++l )
+            {
+                tokens = readTokens( file, 4, path );
+                if ( tokens[0] != "layer" )
+                    throwCorrupted( path );
+
+                unsigned index = parseUnsigned( tokens[1], path );
+                unsigned size = parseUnsigned( tokens[2], path );
+                unsigned hasSymbolicBounds = parseUnsigned( tokens[3], path );
+
+                // Layers are written in order, the input layer first
+                if ( l == 0 )
+                {
+                    if ( index != 0 || hasSymbolicBounds )
+                        throwCorrupted( path );
+                    inputLayerSize = size;
+                }
+
+                entry._startLbs[index] = readDoubles( file, size, path );
+                entry._startUbs[index] = readDoubles( file, size, path );
+                entry._lbs[index] = readDoubles( file, size, path );
+                entry._ubs[index] = readDoubles( file, size, path );
+
+                if ( hasSymbolicBounds )
+                {
+                    unsigned symbolicSize = inputLayerSize * size;
+                    entry._symbolicLb[index] = readDoubles( file, symbolicSize, path );
+                    entry._symbolicUb[index] = readDoubles( file, symbolicSize, path );
+                    entry._symbolicLowerBias[index] = readDoubles( file, size, path );
+                    entry._symbolicUpperBias[index] = readDoubles( file, size, path );
+                }
+            }
+
+            entries.append( entry );
+        }
+    }
+    catch ( const CommonError &e )
+    {
+        if ( e.getCode() != CommonError::READ_FAILED )
+            throw;
+        throwCorrupted( path );
+    }
+
+    _entries = entries;
+}
+
+} // namespace NLR
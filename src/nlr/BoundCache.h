@@ -0,0 +1,116 @@
+/*********************                                                        */
+/*! \file BoundCache.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** A cache of the bounds computed by the network level reasoner, for
+ ** re-verifying the same network under many different input boxes (e.g.,
+ ** robustness sweeps over epsilon).
+ **
+ ** Each entry records the bounds of every layer that an analysis started
+ ** from, and the bounds that it computed; and, optionally, the symbolic
+ ** bounds of every layer in terms of the input layer. Entries are keyed by
+ ** a hash of the network, of the input box and of the fixed activation
+ ** phases. The results of an entry are sound for any later query on the
+ ** same network whose bounds are all contained in the entry's starting
+ ** bounds, e.g. a smaller input box: such a query can intersect its bounds
+ ** with the cached ones, and concretize the cached symbolic bounds over
+ ** its own input box.
+ **
+ ** The cache can be saved to and loaded from a file, so that it persists
+ ** across runs.
+
+ **/
+
+#ifndef __BoundCache_h__
+#define __BoundCache_h__
+
+#include "LayerOwner.h"
+#include "List.h"
+#include "MString.h"
+#include "Map.h"
+#include "Vector.h"
+
+namespace NLR {
+
+class BoundCache
+{
+public:
+    struct Entry
+    {
+        unsigned long long _networkHash;
+        unsigned long long _inputBoxHash;
+        unsigned long long _phaseFixingsHash;
+
+        // Layer index to the bounds of its neurons
+        Map<unsigned, Vector<double>> _startLbs;
+        Map<unsigned, Vector<double>> _startUbs;
+        Map<unsigned, Vector<double>> _lbs;
+        Map<unsigned, Vector<double>> _ubs;
+
+        // Layer index to its symbolic bounds in terms of the input layer, in
+        // the layout of Layer::getSymbolicLb() etc. Empty if not stored.
+        Map<unsigned, Vector<double>> _symbolicLb;
+        Map<unsigned, Vector<double>> _symbolicUb;
+        Map<unsigned, Vector<double>> _symbolicLowerBias;
+        Map<unsigned, Vector<double>> _symbolicUpperBias;
+    };
+
+    /*
+      Tighten the current bounds of the network with those of every entry
+      that applies to them, and report the tightenings to the layer owner.
+      Returns the number of entries applied.
+    */
+    unsigned applyTo( LayerOwner *layerOwner ) const;
+
+    /*
+      Store the current bounds of the network, as computed from the given
+      starting bounds. If storeSymbolicBounds is set, the symbolic bounds
+      of the layers are stored too: these must have been computed by
+      symbolic bound propagation from no tighter bounds than the starting
+      ones. An entry with the same starting bounds is refined instead of
+      duplicated.
+    */
+    void store( const LayerOwner &layerOwner,
+                const Map<unsigned, Vector<double>> &startLbs,
+                const Map<unsigned, Vector<double>> &startUbs,
+                bool storeSymbolicBounds );
+
+    void save( const String &path ) const;
+    void load( const String &path );
+
+    unsigned getNumberOfEntries() const;
+    const List<Entry> &getEntries() const;
+    void clear();
+
+    /*
+      Content hashes of the network (topology, weights and biases), of a
+      box of input bounds, and of the activation phases fixed by the bounds
+      of the activations' sources.
+    */
+    static unsigned long long computeNetworkHash( const Map<unsigned, Layer *> &layers );
+    static unsigned long long computeInputBoxHash( const Vector<double> &lbs,
+                                                   const Vector<double> &ubs );
+    static unsigned long long
+    computePhaseFixingsHash( const Map<unsigned, Layer *> &layers,
+                             const Map<unsigned, Vector<double>> &lbs,
+                             const Map<unsigned, Vector<double>> &ubs );
+
+private:
+    // Oldest first
+    List<Entry> _entries;
+
+    static bool entryApplies( const Entry &entry, const Map<unsigned, Layer *> &layers );
+    static void applyEntry( const Entry &entry, LayerOwner *layerOwner );
+    static bool sameStartingBounds( const Entry &entry, const Entry &other );
+};
+
+} // namespace NLR
+
+#endif // __BoundCache_h__
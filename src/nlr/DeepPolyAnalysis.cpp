@@ -166,42 +166,143 @@ void DeepPolyAnalysis::run()
         log( Stringf( "Running deeppoly analysis for layer %u...", index ) );
         DeepPolyElement *deepPolyElement = _deepPolyElements[index];
         deepPolyElement->execute( _deepPolyElements );
+        updateLayerBounds( index, layer, deepPolyElement );
+        log( Stringf( "Running deeppoly analysis for layer %u - done", index ) );
+    }
+}
+
+void DeepPolyAnalysis::runDemandDriven()
+{
+    if ( outputBoundsAreInfeasible() )
+        return;
+
+    log( "Running demand-driven deeppoly analysis..." );
+    runDemandDrivenPass( false );
+    if ( !outputBoundsAreInfeasible() )
+        runDemandDrivenPass( true );
+    log( "Running demand-driven deeppoly analysis - done" );
+}
+
+void DeepPolyAnalysis::runDemandDrivenPass( bool refine )
+{
+    const Map<unsigned, Layer *> &layers = _layerOwner->getLayerIndexToLayer();
+
+    unsigned lastWeightedSumIndex = 0;
+    for ( const auto &pair : layers )
+    {
+        if ( pair.second->getLayerType() == Layer::WEIGHTED_SUM )
+            lastWeightedSumIndex = pair.first;
+    }
 
-        // Extract updated bounds
-        for ( unsigned j = 0; j < deepPolyElement->getSize(); ++j )
+    for ( const auto &pair : layers )
+    {
+        unsigned index = pair.first;
+        Layer *layer = pair.second;
+
+        ASSERT( _deepPolyElements.exists( index ) );
+        log( Stringf( "Running demand-driven deeppoly analysis for layer %u...", index ) );
+        DeepPolyElement *deepPolyElement = _deepPolyElements[index];
+        if ( layer->getLayerType() != Layer::WEIGHTED_SUM || index == lastWeightedSumIndex )
+            deepPolyElement->execute( _deepPolyElements );
+        else
         {
-            if ( layer->neuronEliminated( j ) )
-                continue;
-            if ( _storeOutputSymbolicBounds && index == _layerOwner->getNumberOfLayers() - 1 )
-                continue;
-            double lb = deepPolyElement->getLowerBound( j );
-            if ( layer->getLb( j ) < lb )
-            {
-                log( Stringf( "Neuron %u_%u lower-bound updated from  %f to %f",
-                              index,
-                              j,
-                              layer->getLb( j ),
-                              lb ) );
-                layer->setLb( j, lb );
-
-                _layerOwner->receiveTighterBound(
-                    Tightening( layer->neuronToVariable( j ), lb, Tightening::LB ) );
-            }
-            double ub = deepPolyElement->getUpperBound( j );
-            if ( layer->getUb( j ) > ub )
-            {
-                log( Stringf( "Neuron %u_%u upper-bound updated from  %f to %f",
-                              index,
-                              j,
-                              layer->getUb( j ),
-                              ub ) );
-                layer->setUb( j, ub );
-
-                _layerOwner->receiveTighterBound(
-                    Tightening( layer->neuronToVariable( j ), ub, Tightening::UB ) );
-            }
+            DeepPolyWeightedSumElement *weightedSumElement =
+                static_cast<DeepPolyWeightedSumElement *>( deepPolyElement );
+            weightedSumElement->executeWithoutBackSubstitution( _deepPolyElements );
+            if ( refine )
+                weightedSumElement->refineWithBackSubstitution(
+                    _deepPolyElements, getDemandedNeurons( index, weightedSumElement ) );
+        }
+        updateLayerBounds( index, layer, deepPolyElement );
+        log( Stringf( "Running demand-driven deeppoly analysis for layer %u - done", index ) );
+    }
+}
+
+Vector<unsigned> DeepPolyAnalysis::getDemandedNeurons( unsigned index,
+                                                       const DeepPolyElement *deepPolyElement )
+{
+    const Map<unsigned, Layer *> &layers = _layerOwner->getLayerIndexToLayer();
+    Layer *layer = layers[index];
+
+    bool onlyBreakpointsAtZero = true;
+    bool hasSuccessors = false;
+    for ( const auto &pair : layers )
+    {
+        if ( !pair.second->getSourceLayers().exists( index ) )
+            continue;
+
+        hasSuccessors = true;
+        Layer::Type type = pair.second->getLayerType();
+        if ( type != Layer::RELU && type != Layer::LEAKY_RELU && type != Layer::SIGN &&
+             type != Layer::ABSOLUTE_VALUE )
+            onlyBreakpointsAtZero = false;
+    }
+
+    Vector<unsigned> neurons;
+    for ( unsigned j = 0; j < deepPolyElement->getSize(); ++j )
+    {
+        if ( layer->neuronEliminated( j ) )
+            continue;
+
+        if ( hasSuccessors && onlyBreakpointsAtZero &&
+             ( !FloatUtils::isNegative( deepPolyElement->getLowerBound( j ) ) ||
+              FloatUtils::isNegative( deepPolyElement->getUpperBound( j ) ) ) )
+            continue;
+
+        neurons.append( j );
+    }
+    return neurons;
+}
+
+bool DeepPolyAnalysis::outputBoundsAreInfeasible() const
+{
+    const Layer *outputLayer = _layerOwner->getLayer( _layerOwner->getNumberOfLayers() - 1 );
+    for ( unsigned j = 0; j < outputLayer->getSize(); ++j )
+    {
+        if ( !outputLayer->neuronEliminated( j ) &&
+             FloatUtils::gt( outputLayer->getLb( j ), outputLayer->getUb( j ) ) )
+            return true;
+    }
+    return false;
+}
+
+void DeepPolyAnalysis::updateLayerBounds( unsigned index,
+                                          Layer *layer,
+                                          DeepPolyElement *deepPolyElement )
+{
+    // Extract updated bounds
+    for ( unsigned j = 0; j < deepPolyElement->getSize(); ++j )
+    {
+        if ( layer->neuronEliminated( j ) )
+            continue;
+        if ( _storeOutputSymbolicBounds && index == _layerOwner->getNumberOfLayers() - 1 )
+            continue;
+        double lb = deepPolyElement->getLowerBound( j );
+        if ( layer->getLb( j ) < lb )
+        {
+            log( Stringf( "Neuron %u_%u lower-bound updated from  %f to %f",
+                          index,
+                          j,
+                          layer->getLb( j ),
+                          lb ) );
+            layer->setLb( j, lb );
+
+            _layerOwner->receiveTighterBound(
+                Tightening( layer->neuronToVariable( j ), lb, Tightening::LB ) );
+        }
+        double ub = deepPolyElement->getUpperBound( j );
+        if ( layer->getUb( j ) > ub )
+        {
+            log( Stringf( "Neuron %u_%u upper-bound updated from  %f to %f",
+                          index,
+                          j,
+                          layer->getUb( j ),
+                          ub ) );
+            layer->setUb( j, ub );
+
+            _layerOwner->receiveTighterBound(
+                Tightening( layer->neuronToVariable( j ), ub, Tightening::UB ) );
         }
-        log( Stringf( "Running deeppoly analysis for layer %u - done", index ) );
     }
 }
 
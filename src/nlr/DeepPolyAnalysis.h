@@ -45,6 +45,16 @@ public:
 
     void run();
 
+    /*
+      A demand-driven variant of run(). A first pass bounds every weighted
+      sum layer in terms of its immediate predecessors only, except for the
+      last one, which is back-substituted all the way to the input layer.
+      If this does not already show the output bounds to be infeasible, a
+      second pass also back-substitutes the neurons feeding an activation
+      whose relaxation depends on their bounds, e.g. an unstable ReLU.
+    */
+    void runDemandDriven();
+
 private:
     LayerOwner *_layerOwner;
     bool _storeOutputSymbolicBounds;
@@ -84,6 +94,24 @@ private:
 
     DeepPolyElement *createDeepPolyElement( Layer *layer );
 
+    /*
+      Tighten the bounds stored in the layer with those computed by its
+      abstract element, and report the tightenings to the layer owner.
+    */
+    void updateLayerBounds( unsigned index, Layer *layer, DeepPolyElement *deepPolyElement );
+
+    void runDemandDrivenPass( bool refine );
+
+    /*
+      The neurons of a weighted sum layer that the demand-driven mode should
+      back-substitute: all of them, unless all the successors of the layer
+      are piecewise-linear activations with a breakpoint at zero, in which
+      case only those whose bounds still contain zero.
+    */
+    Vector<unsigned> getDemandedNeurons( unsigned index, const DeepPolyElement *deepPolyElement );
+
+    bool outputBoundsAreInfeasible() const;
+
     void log( const String &message );
 };
 
@@ -24,6 +24,7 @@ namespace NLR {
 DeepPolyWeightedSumElement::DeepPolyWeightedSumElement( Layer *layer )
     : _workLb( NULL )
     , _workUb( NULL )
+    , _targetSize( 0 )
 {
     _layer = layer;
     _size = layer->getSize();
@@ -43,12 +44,46 @@ void DeepPolyWeightedSumElement::execute(
     allocateMemory();
     getConcreteBounds();
     // Compute bounds with back-substitution
+    _targetNeurons.clear();
+    _targetSize = _size;
     computeBoundWithBackSubstitution( deepPolyElementsBefore );
     log( "Executing - done" );
 }
 
-void DeepPolyWeightedSumElement::computeBoundWithBackSubstitution(
+void DeepPolyWeightedSumElement::executeWithoutBackSubstitution(
     const Map<unsigned, DeepPolyElement *> &deepPolyElementsBefore )
+{
+    log( "Executing without back substitution..." );
+    ASSERT( hasPredecessor() );
+    ASSERT( !_storeOutputSymbolicBounds );
+    allocateMemory();
+    getConcreteBounds();
+    _targetNeurons.clear();
+    _targetSize = _size;
+    computeBoundWithBackSubstitution( deepPolyElementsBefore, false );
+    log( "Executing without back substitution - done" );
+}
+
+void DeepPolyWeightedSumElement::refineWithBackSubstitution(
+    const Map<unsigned, DeepPolyElement *> &deepPolyElementsBefore,
+    const Vector<unsigned> &neurons )
+{
+    if ( neurons.empty() )
+        return;
+
+    log( Stringf( "Refining %u neurons with back substitution...", neurons.size() ) );
+    ASSERT( _lb && _ub );
+    _targetNeurons = neurons;
+    _targetSize = neurons.size();
+    computeBoundWithBackSubstitution( deepPolyElementsBefore );
+    _targetNeurons.clear();
+    _targetSize = _size;
+    log( "Refining with back substitution - done" );
+}
+
+void DeepPolyWeightedSumElement::computeBoundWithBackSubstitution(
+    const Map<unsigned, DeepPolyElement *> &deepPolyElementsBefore,
+    bool toInputLayer )
 {
     log( "Computing bounds with back substitution..." );
 
@@ -74,10 +109,8 @@ void DeepPolyWeightedSumElement::computeBoundWithBackSubstitution(
             log( Stringf( "Adding residual from layer %u...", predecessorIndex ) );
             allocateMemoryForResidualsIfNeeded( predecessorIndex, pair.second );
             const double *weights = _layer->getWeights( predecessorIndex );
-            memcpy(
-                _residualLb[predecessorIndex], weights, _size * pair.second * sizeof( double ) );
-            memcpy(
-                _residualUb[predecessorIndex], weights, _size * pair.second * sizeof( double ) );
+            copyTargetColumns( weights, pair.second, _residualLb[predecessorIndex] );
+            copyTargetColumns( weights, pair.second, _residualUb[predecessorIndex] );
             ++counter;
             log( Stringf( "Adding residual from layer %u - done", pair.first ) );
         }
@@ -88,12 +121,12 @@ void DeepPolyWeightedSumElement::computeBoundWithBackSubstitution(
     unsigned sourceLayerSize = precedingElement->getSize();
 
     const double *weights = _layer->getWeights( predecessorIndex );
-    memcpy( _work1SymbolicLb, weights, _size * sourceLayerSize * sizeof( double ) );
-    memcpy( _work1SymbolicUb, weights, _size * sourceLayerSize * sizeof( double ) );
+    copyTargetColumns( weights, sourceLayerSize, _work1SymbolicLb );
+    copyTargetColumns( weights, sourceLayerSize, _work1SymbolicUb );
 
     double *bias = _layer->getBiases();
-    memcpy( _workSymbolicLowerBias, bias, _size * sizeof( double ) );
-    memcpy( _workSymbolicUpperBias, bias, _size * sizeof( double ) );
+    copyTargetColumns( bias, 1, _workSymbolicLowerBias );
+    copyTargetColumns( bias, 1, _workSymbolicUpperBias );
 
     DeepPolyElement *currentElement = precedingElement;
     concretizeSymbolicBound( _work1SymbolicLb,
@@ -117,6 +150,13 @@ void DeepPolyWeightedSumElement::computeBoundWithBackSubstitution(
 
     log( Stringf( "Computing symbolic bounds with respect to layer %u - done", predecessorIndex ) );
 
+    if ( !toInputLayer )
+    {
+        clearResiduals( deepPolyElementsBefore );
+        log( "Computing bounds with back substitution - done" );
+        return;
+    }
+
     while ( currentElement->hasPredecessor() || !_residualLayerIndices.empty() )
     {
         // We have the symbolic bounds in terms of the current abstract
@@ -149,22 +189,22 @@ void DeepPolyWeightedSumElement::computeBoundWithBackSubstitution(
                         NULL,
                         _residualLb[predecessorIndex],
                         _residualUb[predecessorIndex],
-                        _size,
+                        _targetSize,
                         precedingElement );
                     ++counter;
                     log( Stringf( "Adding residual from layer %u - done", pair.first ) );
                 }
             }
 
-            std::fill_n( _work2SymbolicLb, _size * precedingElement->getSize(), 0 );
-            std::fill_n( _work2SymbolicUb, _size * precedingElement->getSize(), 0 );
+            std::fill_n( _work2SymbolicLb, _targetSize * precedingElement->getSize(), 0 );
+            std::fill_n( _work2SymbolicUb, _targetSize * precedingElement->getSize(), 0 );
             currentElement->symbolicBoundInTermsOfPredecessor( _work1SymbolicLb,
                                                                _work1SymbolicUb,
                                                                _workSymbolicLowerBias,
                                                                _workSymbolicUpperBias,
                                                                _work2SymbolicLb,
                                                                _work2SymbolicUb,
-                                                               _size,
+                                                               _targetSize,
                                                                precedingElement );
 
             // The symbolic lower-bound is
@@ -176,16 +216,16 @@ void DeepPolyWeightedSumElement::computeBoundWithBackSubstitution(
             {
                 log( Stringf( "merge residual from layer %u...", predecessorIndex ) );
                 // Add weights of this residual layer
-                for ( unsigned i = 0; i < _size * precedingElement->getSize(); ++i )
+                for ( unsigned i = 0; i < _targetSize * precedingElement->getSize(); ++i )
                 {
                     _work2SymbolicLb[i] += _residualLb[predecessorIndex][i];
                     _work2SymbolicUb[i] += _residualUb[predecessorIndex][i];
                 }
                 _residualLayerIndices.erase( predecessorIndex );
                 std::fill_n(
-                    _residualLb[predecessorIndex], _size * precedingElement->getSize(), 0 );
+                    _residualLb[predecessorIndex], _targetSize * precedingElement->getSize(), 0 );
                 std::fill_n(
-                    _residualUb[predecessorIndex], _size * precedingElement->getSize(), 0 );
+                    _residualUb[predecessorIndex], _targetSize * precedingElement->getSize(), 0 );
                 log( Stringf( "merge residual from layer %u - done", predecessorIndex ) );
             }
 
@@ -218,7 +258,7 @@ void DeepPolyWeightedSumElement::computeBoundWithBackSubstitution(
             ASSERT( residualIndex == 0 );
 
             allocateMemoryForResidualsIfNeeded( residualIndex, currentElement->getSize() );
-            unsigned matrixSize = currentElement->getSize() * _size;
+            unsigned matrixSize = currentElement->getSize() * _targetSize;
             for ( unsigned i = 0; i < matrixSize; ++i )
             {
                 _residualLb[residualIndex][i] += _work1SymbolicLb[i];
@@ -231,7 +271,7 @@ void DeepPolyWeightedSumElement::computeBoundWithBackSubstitution(
 
             currentElement = deepPolyElementsBefore[newCurrentIndex];
 
-            unsigned currentMatrixSize = currentElement->getSize() * _size;
+            unsigned currentMatrixSize = currentElement->getSize() * _targetSize;
             memcpy( _work1SymbolicLb,
                     _residualLb[newCurrentIndex],
                     currentMatrixSize * sizeof( double ) );
@@ -268,8 +308,8 @@ void DeepPolyWeightedSumElement::concretizeSymbolicBound(
     const Map<unsigned, DeepPolyElement *> &deepPolyElementsBefore )
 {
     log( "Concretizing bound..." );
-    std::fill_n( _workLb, _size, 0 );
-    std::fill_n( _workUb, _size, 0 );
+    std::fill_n( _workLb, _targetSize, 0 );
+    std::fill_n( _workUb, _targetSize, 0 );
 
     concretizeSymbolicBoundForSourceLayer(
         symbolicLb, symbolicUb, symbolicLowerBias, symbolicUpperBias, sourceElement );
@@ -283,14 +323,15 @@ void DeepPolyWeightedSumElement::concretizeSymbolicBound(
                                                NULL,
                                                residualElement );
     }
-    for ( unsigned i = 0; i < _size; ++i )
+    for ( unsigned i = 0; i < _targetSize; ++i )
     {
-        if ( _lb[i] < _workLb[i] )
-            _lb[i] = _workLb[i];
-        if ( _ub[i] > _workUb[i] )
-            _ub[i] = _workUb[i];
-        log( Stringf( "Neuron%u working LB: %f, UB: %f", i, _workLb[i], _workUb[i] ) );
-        log( Stringf( "Neuron%u LB: %f, UB: %f", i, _lb[i], _ub[i] ) );
+        unsigned neuron = _targetNeurons.empty() ? i : _targetNeurons[i];
+        if ( _lb[neuron] < _workLb[i] )
+            _lb[neuron] = _workLb[i];
+        if ( _ub[neuron] > _workUb[i] )
+            _ub[neuron] = _workUb[i];
+        log( Stringf( "Neuron%u working LB: %f, UB: %f", neuron, _workLb[i], _workUb[i] ) );
+        log( Stringf( "Neuron%u LB: %f, UB: %f", neuron, _lb[neuron], _ub[neuron] ) );
     }
 
     log( "Concretizing bound - done" );
@@ -362,10 +403,10 @@ void DeepPolyWeightedSumElement::concretizeSymbolicBoundForSourceLayer(
                       sourceLb,
                       sourceUb ) );
 
-        for ( unsigned j = 0; j < _size; ++j )
+        for ( unsigned j = 0; j < _targetSize; ++j )
         {
             // Compute lower bound
-            double weight = symbolicLb[i * _size + j];
+            double weight = symbolicLb[i * _targetSize + j];
             if ( weight >= 0 )
             {
                 _workLb[j] += ( weight * sourceLb );
@@ -376,7 +417,7 @@ void DeepPolyWeightedSumElement::concretizeSymbolicBoundForSourceLayer(
             }
 
             // Compute upper bound
-            weight = symbolicUb[i * _size + j];
+            weight = symbolicUb[i * _targetSize + j];
             if ( weight >= 0 )
             {
                 _workUb[j] += ( weight * sourceUb );
@@ -388,7 +429,7 @@ void DeepPolyWeightedSumElement::concretizeSymbolicBoundForSourceLayer(
         }
     }
 
-    for ( unsigned i = 0; i < _size; ++i )
+    for ( unsigned i = 0; i < _targetSize; ++i )
     {
         if ( symbolicLowerBias )
             _workLb[i] += symbolicLowerBias[i];
@@ -438,6 +479,33 @@ void DeepPolyWeightedSumElement::symbolicBoundInTermsOfPredecessor(
     log( Stringf( "Computing symbolic bounds with respect to layer %u - done", predecessorIndex ) );
 }
 
+void DeepPolyWeightedSumElement::copyTargetColumns( const double *matrix,
+                                                    unsigned rows,
+                                                    double *destination ) const
+{
+    if ( _targetNeurons.empty() )
+    {
+        memcpy( destination, matrix, rows * _size * sizeof( double ) );
+        return;
+    }
+
+    for ( unsigned i = 0; i < rows; ++i )
+        for ( unsigned j = 0; j < _targetSize; ++j )
+            destination[i * _targetSize + j] = matrix[i * _size + _targetNeurons[j]];
+}
+
+void DeepPolyWeightedSumElement::clearResiduals(
+    const Map<unsigned, DeepPolyElement *> &deepPolyElementsBefore )
+{
+    for ( const auto &residualLayerIndex : _residualLayerIndices )
+    {
+        unsigned matrixSize = deepPolyElementsBefore[residualLayerIndex]->getSize() * _size;
+        std::fill_n( _residualLb[residualLayerIndex], matrixSize, 0 );
+        std::fill_n( _residualUb[residualLayerIndex], matrixSize, 0 );
+    }
+    _residualLayerIndices.clear();
+}
+
 void DeepPolyWeightedSumElement::allocateMemoryForResidualsIfNeeded( unsigned residualLayerIndex,
                                                                      unsigned residualLayerSize )
 {
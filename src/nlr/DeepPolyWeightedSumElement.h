@@ -32,6 +32,23 @@ public:
     ~DeepPolyWeightedSumElement();
 
     void execute( const Map<unsigned, DeepPolyElement *> &deepPolyElements );
+
+    /*
+      Compute the bounds of this layer in terms of its immediate
+      predecessors only, without back-substituting any further. Used by
+      the demand-driven mode of DeepPolyAnalysis, which then refines only
+      the neurons whose bounds matter with refineWithBackSubstitution().
+    */
+    void executeWithoutBackSubstitution(
+        const Map<unsigned, DeepPolyElement *> &deepPolyElementsBefore );
+
+    /*
+      Tighten the bounds of the given neurons by back-substituting their
+      symbolic bounds all the way to the input layer.
+    */
+    void refineWithBackSubstitution( const Map<unsigned, DeepPolyElement *> &deepPolyElementsBefore,
+                                     const Vector<unsigned> &neurons );
+
     void symbolicBoundInTermsOfPredecessor( const double *symbolicLb,
                                             const double *symbolicUb,
                                             double *symbolicLowerBias,
@@ -54,11 +71,29 @@ private:
     Map<unsigned, double *> _residualUb;
 
     /*
-      Compute the concrete upper- and lower- bounds of this layer by concretizing
-      the symbolic bounds with respect to every preceding element.
+      The neurons whose bounds are being computed. If empty, these are all
+      the neurons of the layer; otherwise, the symbolic bounds in the
+      working memory only have a column for each of the target neurons.
+    */
+    Vector<unsigned> _targetNeurons;
+    unsigned _targetSize;
+
+    /*
+      Compute the concrete upper- and lower- bounds of the target neurons by
+      concretizing the symbolic bounds with respect to every preceding
+      element, or only with respect to the immediate predecessors if
+      toInputLayer is false.
     */
     void computeBoundWithBackSubstitution(
-        const Map<unsigned, DeepPolyElement *> &deepPolyElementsBefore );
+        const Map<unsigned, DeepPolyElement *> &deepPolyElementsBefore,
+        bool toInputLayer = true );
+
+    /*
+      Copy the columns of the target neurons out of a rows x _size matrix.
+    */
+    void copyTargetColumns( const double *matrix, unsigned rows, double *destination ) const;
+
+    void clearResiduals( const Map<unsigned, DeepPolyElement *> &deepPolyElementsBefore );
 
     /*
       Compute concrete bounds using symbolic bounds with respect to a
@@ -37,7 +37,7 @@ Layer::Layer( unsigned index, Type type, unsigned size, LayerOwner *layerOwner )
     , _type( type )
     , _size( size )
     , _layerOwner( layerOwner )
-    , _bias( NULL )
+    , _bias( nullptr )
     , _assignment( NULL )
     , _lb( NULL )
     , _ub( NULL )
@@ -58,8 +58,8 @@ void Layer::allocateMemory()
 {
     if ( _type == WEIGHTED_SUM )
     {
-        _bias = new double[_size];
-        std::fill_n( _bias, _size, 0 );
+        _bias = std::shared_ptr<double[]>( new double[_size] );
+        std::fill_n( _bias.get(), _size, 0 );
     }
 
     _lb = new double[_size];
@@ -138,7 +138,7 @@ void Layer::computeAssignment()
     if ( _type == WEIGHTED_SUM )
     {
         // Initialize to bias
-        memcpy( _assignment, _bias, sizeof( double ) * _size );
+        memcpy( _assignment, _bias.get(), sizeof( double ) * _size );
 
         // Process each of the source layers
         for ( auto &sourceLayerEntry : _sourceLayers )
@@ -146,7 +146,7 @@ void Layer::computeAssignment()
             const Layer *sourceLayer = _layerOwner->getLayer( sourceLayerEntry.first );
             const double *sourceAssignment = sourceLayer->getAssignment();
             unsigned sourceSize = sourceLayerEntry.second;
-            const double *weights = _layerToWeights[sourceLayerEntry.first];
+            const double *weights = _layerToWeights[sourceLayerEntry.first].get();
 
             for ( unsigned i = 0; i < sourceSize; ++i )
                 for ( unsigned j = 0; j < _size; ++j )
@@ -307,7 +307,7 @@ void Layer::computeSimulations()
             const Vector<Vector<double>> *sourceSimulations = sourceLayer->getSimulations();
 
             unsigned sourceSize = sourceLayerEntry.second;
-            const double *weights = _layerToWeights[sourceLayerEntry.first];
+            const double *weights = _layerToWeights[sourceLayerEntry.first].get();
 
             for ( unsigned i = 0; i < _size; ++i )
             {
@@ -487,13 +487,8 @@ void Layer::addSourceLayer( unsigned layerNumber, unsigned layerSize )
 
     if ( _type == WEIGHTED_SUM )
     {
-        _layerToWeights[layerNumber] = new double[layerSize * _size];
-        _layerToPositiveWeights[layerNumber] = new double[layerSize * _size];
-        _layerToNegativeWeights[layerNumber] = new double[layerSize * _size];
-
-        std::fill_n( _layerToWeights[layerNumber], layerSize * _size, 0 );
-        std::fill_n( _layerToPositiveWeights[layerNumber], layerSize * _size, 0 );
-        std::fill_n( _layerToNegativeWeights[layerNumber], layerSize * _size, 0 );
+        _layerToWeights[layerNumber] = std::shared_ptr<double[]>( new double[layerSize * _size] );
+        std::fill_n( _layerToWeights[layerNumber].get(), layerSize * _size, 0 );
     }
 }
 
@@ -515,21 +510,15 @@ const Set<unsigned> &Layer::getSuccessorLayers() const
 const double *Layer::getWeightMatrix( unsigned sourceLayer ) const
 {
     ASSERT( _layerToWeights.exists( sourceLayer ) );
-    return _layerToWeights[sourceLayer];
+    return _layerToWeights[sourceLayer].get();
 }
 
 void Layer::removeSourceLayer( unsigned sourceLayer )
 {
     ASSERT( _sourceLayers.exists( sourceLayer ) );
 
-    delete[] _layerToWeights[sourceLayer];
-    delete[] _layerToPositiveWeights[sourceLayer];
-    delete[] _layerToNegativeWeights[sourceLayer];
-
     _sourceLayers.erase( sourceLayer );
     _layerToWeights.erase( sourceLayer );
-    _layerToPositiveWeights.erase( sourceLayer );
-    _layerToNegativeWeights.erase( sourceLayer );
 }
 
 void Layer::setWeight( unsigned sourceLayer,
@@ -537,19 +526,11 @@ void Layer::setWeight( unsigned sourceLayer,
                        unsigned targetNeuron,
                        double weight )
 {
+    unsigned size = _sourceLayers[sourceLayer] * _size;
+    detachIfShared( _layerToWeights[sourceLayer], size );
+
     unsigned index = sourceNeuron * _size + targetNeuron;
     _layerToWeights[sourceLayer][index] = weight;
-
-    if ( weight > 0 )
-    {
-        _layerToPositiveWeights[sourceLayer][index] = weight;
-        _layerToNegativeWeights[sourceLayer][index] = 0;
-    }
-    else
-    {
-        _layerToPositiveWeights[sourceLayer][index] = 0;
-        _layerToNegativeWeights[sourceLayer][index] = weight;
-    }
 }
 
 double Layer::getWeight( unsigned sourceLayer, unsigned sourceNeuron, unsigned targetNeuron ) const
@@ -560,21 +541,12 @@ double Layer::getWeight( unsigned sourceLayer, unsigned sourceNeuron, unsigned t
 
 double *Layer::getWeights( unsigned sourceLayerIndex ) const
 {
-    return _layerToWeights[sourceLayerIndex];
-}
-
-double *Layer::getPositiveWeights( unsigned sourceLayerIndex ) const
-{
-    return _layerToPositiveWeights[sourceLayerIndex];
-}
-
-double *Layer::getNegativeWeights( unsigned sourceLayerIndex ) const
-{
-    return _layerToNegativeWeights[sourceLayerIndex];
+    return _layerToWeights[sourceLayerIndex].get();
 }
 
 void Layer::setBias( unsigned neuron, double bias )
 {
+    detachIfShared( _bias, _size );
     _bias[neuron] = bias;
 }
 
@@ -585,7 +557,17 @@ double Layer::getBias( unsigned neuron ) const
 
 double *Layer::getBiases() const
 {
-    return _bias;
+    return _bias.get();
+}
+
+void Layer::detachIfShared( std::shared_ptr<double[]> &array, unsigned size )
+{
+    if ( array.use_count() <= 1 )
+        return;
+
+    std::shared_ptr<double[]> copy( new double[size] );
+    memcpy( copy.get(), array.get(), sizeof( double ) * size );
+    array = copy;
 }
 
 void Layer::addActivationSource( unsigned sourceLayer,
@@ -776,7 +758,7 @@ void Layer::computeIntervalArithmeticBoundsForWeightedSum()
         unsigned sourceLayerIndex = sourceLayerEntry.first;
         unsigned sourceLayerSize = sourceLayerEntry.second;
         const Layer *sourceLayer = _layerOwner->getLayer( sourceLayerIndex );
-        const double *weights = _layerToWeights[sourceLayerIndex];
+        const double *weights = _layerToWeights[sourceLayerIndex].get();
 
         for ( unsigned i = 0; i < _size; ++i )
         {
@@ -2659,9 +2641,6 @@ void Layer::computeSymbolicBoundsForSoftmax()
     std::fill_n( symbolicLb, _size * _size, 0 );
     std::fill_n( symbolicUb, _size * _size, 0 );
 
-    double *_work = new double[_size * _size];
-    std::fill_n( _work, _size * _size, 0 );
-
     Set<unsigned> handledInputNeurons;
     unsigned sourceLayerSize = _size;
     SoftmaxBoundType boundType = Options::get()->getSoftmaxBoundType();
@@ -2837,94 +2816,24 @@ void Layer::computeSymbolicBoundsForSoftmax()
           newUB = oldUB * posWeights + oldLB * negWeights
           newLB = oldUB * negWeights + oldLB * posWeights
         */
-
-        for ( unsigned i = 0; i < sourceLayerSize * _size; ++i )
-        {
-            if ( symbolicLb[i] > 0 )
-                _work[i] = symbolicLb[i];
-            else
-                _work[i] = 0;
-        }
-        // _work is now positive weights in symbolicLb
-        matrixMultiplication( sourceLayer->getSymbolicLb(),
-                              _work,
-                              _symbolicLb,
-                              _inputLayerSize,
-                              sourceLayerSize,
-                              _size );
-        if ( sourceLayer->getSymbolicLowerBias() )
-            matrixMultiplication( sourceLayer->getSymbolicLowerBias(),
-                                  _work,
-                                  _symbolicLowerBias,
-                                  1,
-                                  sourceLayerSize,
-                                  _size );
-
-        for ( unsigned i = 0; i < sourceLayerSize * _size; ++i )
-        {
-            if ( symbolicLb[i] < 0 )
-                _work[i] = symbolicLb[i];
-            else
-                _work[i] = 0;
-        }
-        // _work is now negative weights in symbolicLb
-        matrixMultiplication( sourceLayer->getSymbolicUb(),
-                              _work,
-                              _symbolicLb,
-                              _inputLayerSize,
-                              sourceLayerSize,
-                              _size );
-        if ( sourceLayer->getSymbolicLowerBias() )
-            matrixMultiplication( sourceLayer->getSymbolicUpperBias(),
-                                  _work,
-                                  _symbolicLowerBias,
-                                  1,
-                                  sourceLayerSize,
-                                  _size );
-
-        for ( unsigned i = 0; i < sourceLayerSize * _size; ++i )
-        {
-            if ( symbolicUb[i] > 0 )
-                _work[i] = symbolicUb[i];
-            else
-                _work[i] = 0;
-        }
-        // _work is now positive weights in symbolicUb
-        matrixMultiplication( sourceLayer->getSymbolicUb(),
-                              _work,
-                              _symbolicUb,
-                              _inputLayerSize,
-                              sourceLayerSize,
-                              _size );
-        if ( sourceLayer->getSymbolicUpperBias() )
-            matrixMultiplication( sourceLayer->getSymbolicUpperBias(),
-                                  _work,
-                                  _symbolicUpperBias,
-                                  1,
-                                  sourceLayerSize,
-                                  _size );
-
-        for ( unsigned i = 0; i < sourceLayerSize * _size; ++i )
-        {
-            if ( symbolicUb[i] < 0 )
-                _work[i] = symbolicUb[i];
-            else
-                _work[i] = 0;
-        }
-        // _work is now negative weights in symbolicUb
-        matrixMultiplication( sourceLayer->getSymbolicLb(),
-                              _work,
-                              _symbolicUb,
-                              _inputLayerSize,
-                              sourceLayerSize,
-                              _size );
-        if ( sourceLayer->getSymbolicUpperBias() )
-            matrixMultiplication( sourceLayer->getSymbolicLowerBias(),
-                                  _work,
-                                  _symbolicUpperBias,
-                                  1,
-                                  sourceLayerSize,
-                                  _size );
+        signSplitMatrixMultiplication( sourceLayer->getSymbolicLb(),
+                                       sourceLayer->getSymbolicUb(),
+                                       symbolicLb,
+                                       symbolicUb,
+                                       _symbolicLb,
+                                       _symbolicUb,
+                                       _inputLayerSize,
+                                       sourceLayerSize,
+                                       _size );
+        signSplitMatrixMultiplication( sourceLayer->getSymbolicLowerBias(),
+                                       sourceLayer->getSymbolicUpperBias(),
+                                       symbolicLb,
+                                       symbolicUb,
+                                       _symbolicLowerBias,
+                                       _symbolicUpperBias,
+                                       1,
+                                       sourceLayerSize,
+                                       _size );
     }
 
     /*
@@ -2986,11 +2895,6 @@ void Layer::computeSymbolicBoundsForSoftmax()
         delete[] symbolicUb;
         symbolicUb = NULL;
     }
-    if ( _work )
-    {
-        delete[] _work;
-        _work = NULL;
-    }
 }
 
 void Layer::computeSymbolicBoundsForBilinear()
@@ -3235,21 +3139,16 @@ void Layer::computeSymbolicBoundsForWeightedSum()
 
     for ( unsigned i = 0; i < _size; ++i )
     {
+        _symbolicLowerBias[i] = _bias[i];
+        _symbolicUpperBias[i] = _bias[i];
+
         if ( _eliminatedNeurons.exists( i ) )
         {
-            _symbolicLowerBias[i] = _eliminatedNeurons[i];
-            _symbolicUpperBias[i] = _eliminatedNeurons[i];
-
             _symbolicLbOfLb[i] = _eliminatedNeurons[i];
             _symbolicUbOfLb[i] = _eliminatedNeurons[i];
             _symbolicLbOfUb[i] = _eliminatedNeurons[i];
             _symbolicUbOfUb[i] = _eliminatedNeurons[i];
         }
-        else
-        {
-            _symbolicLowerBias[i] = _bias[i];
-            _symbolicUpperBias[i] = _bias[i];
-        }
     }
 
     for ( const auto &sourceLayerEntry : _sourceLayers )
@@ -3264,68 +3163,39 @@ void Layer::computeSymbolicBoundsForWeightedSum()
           newUB = oldUB * posWeights + oldLB * negWeights
           newLB = oldUB * negWeights + oldLB * posWeights
         */
+        const double *weights = _layerToWeights[sourceLayerIndex].get();
+        signSplitMatrixMultiplication( sourceLayer->getSymbolicLb(),
+                                       sourceLayer->getSymbolicUb(),
+                                       weights,
+                                       weights,
+                                       _symbolicLb,
+                                       _symbolicUb,
+                                       _inputLayerSize,
+                                       sourceLayerSize,
+                                       _size );
+
+        // Add the weighted biases from the source layer
+        signSplitMatrixMultiplication( sourceLayer->getSymbolicLowerBias(),
+                                       sourceLayer->getSymbolicUpperBias(),
+                                       weights,
+                                       weights,
+                                       _symbolicLowerBias,
+                                       _symbolicUpperBias,
+                                       1,
+                                       sourceLayerSize,
+                                       _size );
+    }
+
+    // Restore the constant bounds of eliminated neurons
+    for ( const auto &eliminated : _eliminatedNeurons )
+    {
+        _symbolicLowerBias[eliminated.first] = eliminated.second;
+        _symbolicUpperBias[eliminated.first] = eliminated.second;
 
-        matrixMultiplication( sourceLayer->getSymbolicUb(),
-                              _layerToPositiveWeights[sourceLayerIndex],
-                              _symbolicUb,
-                              _inputLayerSize,
-                              sourceLayerSize,
-                              _size );
-        matrixMultiplication( sourceLayer->getSymbolicLb(),
-                              _layerToNegativeWeights[sourceLayerIndex],
-                              _symbolicUb,
-                              _inputLayerSize,
-                              sourceLayerSize,
-                              _size );
-        matrixMultiplication( sourceLayer->getSymbolicLb(),
-                              _layerToPositiveWeights[sourceLayerIndex],
-                              _symbolicLb,
-                              _inputLayerSize,
-                              sourceLayerSize,
-                              _size );
-        matrixMultiplication( sourceLayer->getSymbolicUb(),
-                              _layerToNegativeWeights[sourceLayerIndex],
-                              _symbolicLb,
-                              _inputLayerSize,
-                              sourceLayerSize,
-                              _size );
-
-        // Restore the zero bound on eliminated neurons
-        unsigned index;
-        for ( const auto &eliminated : _eliminatedNeurons )
-        {
-            for ( unsigned i = 0; i < _inputLayerSize; ++i )
-            {
-                index = i * _size + eliminated.first;
-                _symbolicLb[index] = 0;
-                _symbolicUb[index] = 0;
-            }
-        }
-
-        /*
-          Compute the biases for the new layer
-        */
-        for ( unsigned j = 0; j < _size; ++j )
+        for ( unsigned i = 0; i < _inputLayerSize; ++i )
         {
-            if ( _eliminatedNeurons.exists( j ) )
-                continue;
-
-            // Add the weighted bias from the source layer
-            for ( unsigned k = 0; k < sourceLayerSize; ++k )
-            {
-                double weight = _layerToWeights[sourceLayerIndex][k * _size + j];
-
-                if ( weight > 0 )
-                {
-                    _symbolicLowerBias[j] += sourceLayer->getSymbolicLowerBias()[k] * weight;
-                    _symbolicUpperBias[j] += sourceLayer->getSymbolicUpperBias()[k] * weight;
-                }
-                else
-                {
-                    _symbolicLowerBias[j] += sourceLayer->getSymbolicUpperBias()[k] * weight;
-                    _symbolicUpperBias[j] += sourceLayer->getSymbolicLowerBias()[k] * weight;
-                }
-            }
+            _symbolicLb[i * _size + eliminated.first] = 0;
+            _symbolicUb[i * _size + eliminated.first] = 0;
         }
     }
 
@@ -4938,7 +4808,7 @@ unsigned Layer::getLayerIndex() const
 }
 
 Layer::Layer( const Layer *other )
-    : _bias( NULL )
+    : _bias( nullptr )
     , _assignment( NULL )
     , _lb( NULL )
     , _ub( NULL )
@@ -4960,31 +4830,13 @@ Layer::Layer( const Layer *other )
 
     allocateMemory();
 
-    for ( auto &sourceLayerEntry : other->_sourceLayers )
-    {
-        addSourceLayer( sourceLayerEntry.first, sourceLayerEntry.second );
-
-        if ( other->_layerToWeights.exists( sourceLayerEntry.first ) )
-            memcpy( _layerToWeights[sourceLayerEntry.first],
-                    other->_layerToWeights[sourceLayerEntry.first],
-                    sizeof( double ) * sourceLayerEntry.second * _size );
-
-        if ( other->_layerToPositiveWeights.exists( sourceLayerEntry.first ) )
-            memcpy( _layerToPositiveWeights[sourceLayerEntry.first],
-                    other->_layerToPositiveWeights[sourceLayerEntry.first],
-                    sizeof( double ) * sourceLayerEntry.second * _size );
-
-        if ( other->_layerToNegativeWeights.exists( sourceLayerEntry.first ) )
-            memcpy( _layerToNegativeWeights[sourceLayerEntry.first],
-                    other->_layerToNegativeWeights[sourceLayerEntry.first],
-                    sizeof( double ) * sourceLayerEntry.second * _size );
-    }
+    // Share, rather than copy, the weights and biases
+    _sourceLayers = other->_sourceLayers;
+    _layerToWeights = other->_layerToWeights;
+    _bias = other->_bias;
 
     _successorLayers = other->_successorLayers;
 
-    if ( other->_bias )
-        memcpy( _bias, other->_bias, sizeof( double ) * _size );
-
     _neuronToActivationSources = other->_neuronToActivationSources;
 
     _neuronToVariable = other->_neuronToVariable;
@@ -5036,23 +4888,8 @@ double Layer::getSymbolicUbOfUb( unsigned neuron ) const
 
 void Layer::freeMemoryIfNeeded()
 {
-    for ( const auto &weights : _layerToWeights )
-        delete[] weights.second;
     _layerToWeights.clear();
-
-    for ( const auto &weights : _layerToPositiveWeights )
-        delete[] weights.second;
-    _layerToPositiveWeights.clear();
-
-    for ( const auto &weights : _layerToNegativeWeights )
-        delete[] weights.second;
-    _layerToNegativeWeights.clear();
-
-    if ( _bias )
-    {
-        delete[] _bias;
-        _bias = NULL;
-    }
+    _bias = nullptr;
 
     if ( _assignment )
     {
@@ -5301,8 +5138,6 @@ void Layer::reduceIndexFromAllMaps( unsigned startIndex )
 
     // Adjust all weight maps
     adjustWeightMapIndexing( _layerToWeights, startIndex );
-    adjustWeightMapIndexing( _layerToPositiveWeights, startIndex );
-    adjustWeightMapIndexing( _layerToNegativeWeights, startIndex );
 
     // Adjust the neuron activations
     for ( auto &neuronToSources : _neuronToActivationSources )
@@ -5315,9 +5150,10 @@ void Layer::reduceIndexFromAllMaps( unsigned startIndex )
     }
 }
 
-void Layer::adjustWeightMapIndexing( Map<unsigned, double *> &map, unsigned startIndex )
+void Layer::adjustWeightMapIndexing( Map<unsigned, std::shared_ptr<double[]>> &map,
+                                     unsigned startIndex )
 {
-    Map<unsigned, double *> copyOfWeights = map;
+    Map<unsigned, std::shared_ptr<double[]>> copyOfWeights = map;
     map.clear();
     for ( const auto &pair : copyOfWeights )
         map[pair.first >= startIndex ? pair.first - 1 : pair.first] = pair.second;
@@ -5348,7 +5184,7 @@ bool Layer::operator==( const Layer &layer ) const
 
     if ( _bias && layer._bias )
     {
-        if ( std::memcmp( _bias, layer._bias, _size * sizeof( double ) ) != 0 )
+        if ( std::memcmp( _bias.get(), layer._bias.get(), _size * sizeof( double ) ) != 0 )
             return false;
     }
 
@@ -5358,17 +5194,11 @@ bool Layer::operator==( const Layer &layer ) const
     if ( !compareWeights( _layerToWeights, layer._layerToWeights ) )
         return false;
 
-    if ( !compareWeights( _layerToPositiveWeights, layer._layerToPositiveWeights ) )
-        return false;
-
-    if ( !compareWeights( _layerToNegativeWeights, layer._layerToNegativeWeights ) )
-        return false;
-
     return true;
 }
 
-bool Layer::compareWeights( const Map<unsigned, double *> &map,
-                            const Map<unsigned, double *> &mapOfOtherLayer ) const
+bool Layer::compareWeights( const Map<unsigned, std::shared_ptr<double[]>> &map,
+                            const Map<unsigned, std::shared_ptr<double[]>> &mapOfOtherLayer ) const
 {
     if ( map.size() != mapOfOtherLayer.size() )
         return false;
@@ -5376,13 +5206,13 @@ bool Layer::compareWeights( const Map<unsigned, double *> &map,
     for ( const auto &pair : map )
     {
         unsigned key = pair.first;
-        double *value = pair.second;
+        const double *value = pair.second.get();
 
         if ( !mapOfOtherLayer.exists( key ) )
             return false;
 
-        if ( std::memcmp(
-                 value, mapOfOtherLayer[key], _size * _sourceLayers[key] * sizeof( double ) ) != 0 )
+        const double *otherValue = mapOfOtherLayer[key].get();
+        if ( std::memcmp( value, otherValue, _size * _sourceLayers[key] * sizeof( double ) ) != 0 )
         {
             return false;
         }
@@ -29,6 +29,8 @@
 #include "SignConstraint.h"
 #include "Vector.h"
 
+#include <memory>
+
 namespace NLR {
 
 class Layer
@@ -78,8 +80,6 @@ public:
     setWeight( unsigned sourceLayer, unsigned sourceNeuron, unsigned targetNeuron, double weight );
     double getWeight( unsigned sourceLayer, unsigned sourceNeuron, unsigned targetNeuron ) const;
     double *getWeights( unsigned sourceLayerIndex ) const;
-    double *getPositiveWeights( unsigned sourceLayerIndex ) const;
-    double *getNegativeWeights( unsigned sourceLayerIndex ) const;
 
     void setBias( unsigned neuron, double bias );
     double getBias( unsigned neuron ) const;
@@ -227,8 +227,8 @@ public:
     void dump() const;
     static String typeToString( Type type );
     bool operator==( const Layer &layer ) const;
-    bool compareWeights( const Map<unsigned, double *> &map,
-                         const Map<unsigned, double *> &mapOfOtherLayer ) const;
+    bool compareWeights( const Map<unsigned, std::shared_ptr<double[]>> &map,
+                         const Map<unsigned, std::shared_ptr<double[]>> &mapOfOtherLayer ) const;
 
 private:
     unsigned _layerIndex;
@@ -239,10 +239,13 @@ private:
     Map<unsigned, unsigned> _sourceLayers;
     Set<unsigned> _successorLayers;
 
-    Map<unsigned, double *> _layerToWeights;
-    Map<unsigned, double *> _layerToPositiveWeights;
-    Map<unsigned, double *> _layerToNegativeWeights;
-    double *_bias;
+    /*
+      The weights and biases are shared between copies of a layer (e.g.,
+      between the networks of the engines of a DnC run), and are copied
+      before being modified if they are shared.
+    */
+    Map<unsigned, std::shared_ptr<double[]>> _layerToWeights;
+    std::shared_ptr<double[]> _bias;
 
     double *_assignment;
 
@@ -330,7 +333,14 @@ private:
     double getSymbolicLbOfUb( unsigned neuron ) const;
     double getSymbolicUbOfUb( unsigned neuron ) const;
 
-    void adjustWeightMapIndexing( Map<unsigned, double *> &map, unsigned indexToStart );
+    void adjustWeightMapIndexing( Map<unsigned, std::shared_ptr<double[]>> &map,
+                                  unsigned indexToStart );
+
+    /*
+      Replace an array of the given size by a private copy, if it is
+      shared with another layer
+    */
+    static void detachIfShared( std::shared_ptr<double[]> &array, unsigned size );
 };
 
 } // namespace NLR
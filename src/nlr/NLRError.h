@@ -29,6 +29,7 @@ public:
         RELU_NOT_FOUND = 4,
         LAYER_NOT_FOUND = 5,
         NEURON_NOT_FOUND = 6,
+        BOUND_CACHE_FILE_CORRUPTED = 7,
     };
 
     NLRError( NLRError::Code code )
@@ -16,6 +16,7 @@
 #include "NetworkLevelReasoner.h"
 
 #include "AbsoluteValueConstraint.h"
+#include "BatchedBoundPropagator.h"
 #include "Debug.h"
 #include "FloatUtils.h"
 #include "InfeasibleQueryException.h"
@@ -30,6 +31,7 @@
 #include "Query.h"
 #include "ReluConstraint.h"
 #include "SignConstraint.h"
+#include "ThreadPool.h"
 
 #include <cstring>
 
@@ -255,11 +257,98 @@ void NetworkLevelReasoner::parameterisedSymbolicBoundPropagation( const Vector<d
 
 void NetworkLevelReasoner::deepPolyPropagation()
 {
+    if ( GlobalConfiguration::DEEP_POLY_DEMAND_DRIVEN_BACK_SUBSTITUTION )
+    {
+        demandDrivenDeepPolyPropagation();
+        return;
+    }
+
     if ( _deepPolyAnalysis == nullptr )
         _deepPolyAnalysis = std::unique_ptr<DeepPolyAnalysis>( new DeepPolyAnalysis( this ) );
     _deepPolyAnalysis->run();
 }
 
+void NetworkLevelReasoner::demandDrivenDeepPolyPropagation()
+{
+    tightenOutputBoundsWithStoredSymbolicBounds();
+
+    if ( _deepPolyAnalysis == nullptr )
+        _deepPolyAnalysis = std::unique_ptr<DeepPolyAnalysis>( new DeepPolyAnalysis( this ) );
+    _deepPolyAnalysis->runDemandDriven();
+}
+
+void NetworkLevelReasoner::tightenOutputBoundsWithStoredSymbolicBounds()
+{
+    if ( !_outputSymbolicLb.exists( 0 ) || !_layerIndexToLayer.exists( 0 ) )
+        return;
+
+    unsigned outputLayerIndex = getNumberOfLayers() - 1;
+    const Layer *inputLayer = _layerIndexToLayer[0];
+    Layer *outputLayer = _layerIndexToLayer[outputLayerIndex];
+    unsigned inputLayerSize = inputLayer->getSize();
+    unsigned outputLayerSize = outputLayer->getSize();
+
+    const Vector<double> &symbolicLb = _outputSymbolicLb[0];
+    const Vector<double> &symbolicUb = _outputSymbolicUb[0];
+    if ( symbolicLb.size() != inputLayerSize * outputLayerSize )
+        return;
+
+    // The input and output bounds do not affect the relaxations in between
+    for ( const auto &pair : _layerIndexToLayer )
+    {
+        unsigned layerIndex = pair.first;
+        const Layer *layer = pair.second;
+        if ( layerIndex == 0 || layerIndex == outputLayerIndex )
+            continue;
+
+        if ( !_outputSymbolicBoundsLayerLbs.exists( layerIndex ) ||
+             _outputSymbolicBoundsLayerLbs[layerIndex].size() != layer->getSize() )
+            return;
+
+        const Vector<double> &storedLbs = _outputSymbolicBoundsLayerLbs[layerIndex];
+        const Vector<double> &storedUbs = _outputSymbolicBoundsLayerUbs[layerIndex];
+        for ( unsigned i = 0; i < layer->getSize(); ++i )
+        {
+            if ( layer->getLb( i ) < storedLbs[i] || layer->getUb( i ) > storedUbs[i] )
+                return;
+        }
+    }
+
+    for ( unsigned j = 0; j < outputLayerSize; ++j )
+    {
+        if ( outputLayer->neuronEliminated( j ) )
+            continue;
+
+        double lb = _outputSymbolicLowerBias[0][j];
+        double ub = _outputSymbolicUpperBias[0][j];
+        for ( unsigned i = 0; i < inputLayerSize; ++i )
+        {
+            double sourceLb = inputLayer->getLb( i ) -
+                              GlobalConfiguration::SYMBOLIC_TIGHTENING_ROUNDING_CONSTANT;
+            double sourceUb = inputLayer->getUb( i ) +
+                              GlobalConfiguration::SYMBOLIC_TIGHTENING_ROUNDING_CONSTANT;
+
+            double weight = symbolicLb[i * outputLayerSize + j];
+            lb += weight >= 0 ? weight * sourceLb : weight * sourceUb;
+            weight = symbolicUb[i * outputLayerSize + j];
+            ub += weight >= 0 ? weight * sourceUb : weight * sourceLb;
+        }
+
+        if ( outputLayer->getLb( j ) < lb )
+        {
+            outputLayer->setLb( j, lb );
+            receiveTighterBound(
+                Tightening( outputLayer->neuronToVariable( j ), lb, Tightening::LB ) );
+        }
+        if ( outputLayer->getUb( j ) > ub )
+        {
+            outputLayer->setUb( j, ub );
+            receiveTighterBound(
+                Tightening( outputLayer->neuronToVariable( j ), ub, Tightening::UB ) );
+        }
+    }
+}
+
 void NetworkLevelReasoner::parameterisedDeepPoly( bool storeSymbolicBounds,
                                                   const Vector<double> &coeffs )
 {
@@ -378,9 +467,47 @@ void NetworkLevelReasoner::parameterisedDeepPoly( bool storeSymbolicBounds,
             delete newLayer;
             newLayer = NULL;
         }
+
+        // Record the bounds the symbolic bounds were computed with.
+        recordLayerBounds( _outputSymbolicBoundsLayerLbs, _outputSymbolicBoundsLayerUbs );
+    }
+}
+
+void NetworkLevelReasoner::recordLayerBounds( Map<unsigned, Vector<double>> &lbs,
+                                              Map<unsigned, Vector<double>> &ubs ) const
+{
+    lbs.clear();
+    ubs.clear();
+    for ( const auto &pair : _layerIndexToLayer )
+    {
+        const Layer *layer = pair.second;
+        Vector<double> layerLbs( layer->getSize() );
+        Vector<double> layerUbs( layer->getSize() );
+        for ( unsigned i = 0; i < layer->getSize(); ++i )
+        {
+            layerLbs[i] = layer->getLb( i );
+            layerUbs[i] = layer->getUb( i );
+        }
+        lbs[pair.first] = layerLbs;
+        ubs[pair.first] = layerUbs;
     }
 }
 
+unsigned NetworkLevelReasoner::applyCachedBounds( const BoundCache &cache )
+{
+    recordLayerBounds( _boundCacheStartLbs, _boundCacheStartUbs );
+    return cache.applyTo( this );
+}
+
+void NetworkLevelReasoner::storeBoundsInCache( BoundCache &cache, bool storeSymbolicBounds ) const
+{
+    // Nothing to store if no bounds were recorded for this network
+    if ( _boundCacheStartLbs.size() != _layerIndexToLayer.size() )
+        return;
+
+    cache.store( *this, _boundCacheStartLbs, _boundCacheStartUbs, storeSymbolicBounds );
+}
+
 void NetworkLevelReasoner::lpRelaxationPropagation()
 {
     LPFormulator lpFormulator( this );
@@ -467,6 +594,33 @@ void NetworkLevelReasoner::iterativePropagation()
     iterativePropagator.optimizeBoundsWithIterativePropagation( _layerIndexToLayer );
 }
 
+bool NetworkLevelReasoner::batchedBoundPropagation( const Vector<Vector<double>> &inputLbs,
+                                                    const Vector<Vector<double>> &inputUbs,
+                                                    Vector<Vector<double>> &outputLbs,
+                                                    Vector<Vector<double>> &outputUbs ) const
+{
+    if ( !BatchedBoundPropagator::supports( this ) )
+        return false;
+
+    BatchedBoundPropagator propagator( this );
+    propagator.run( inputLbs, inputUbs );
+
+    unsigned outputLayerIndex = _layerIndexToLayer.size() - 1;
+    unsigned outputLayerSize = _layerIndexToLayer[outputLayerIndex]->getSize();
+
+    outputLbs.clear();
+    outputUbs.clear();
+    for ( unsigned k = 0; k < propagator.getNumberOfBoxes(); ++k )
+    {
+        const double *lbs = propagator.getLbs( outputLayerIndex, k );
+        const double *ubs = propagator.getUbs( outputLayerIndex, k );
+        outputLbs.append( Vector<double>( lbs, lbs + outputLayerSize ) );
+        outputUbs.append( Vector<double>( ubs, ubs + outputLayerSize ) );
+    }
+
+    return true;
+}
+
 void NetworkLevelReasoner::intervalArithmeticBoundPropagation()
 {
     for ( unsigned i = 1; i < _layerIndexToLayer.size(); ++i )
@@ -1194,6 +1348,12 @@ const Vector<double> NetworkLevelReasoner::OptimalParameterisedSymbolicBoundTigh
     double epsilon = GlobalConfiguration::DEFAULT_EPSILON_FOR_COMPARISONS;
     double weightDecay = GlobalConfiguration::PREIMAGE_APPROXIMATION_OPTIMIZATION_WEIGHT_DECAY;
     double lr = GlobalConfiguration::PREIMAGE_APPROXIMATION_OPTIMIZATION_LEARNING_RATE;
+    bool useAdam = GlobalConfiguration::PREIMAGE_APPROXIMATION_OPTIMIZATION_USE_ADAM;
+    double beta1 = GlobalConfiguration::PREIMAGE_APPROXIMATION_OPTIMIZATION_ADAM_BETA1;
+    double beta2 = GlobalConfiguration::PREIMAGE_APPROXIMATION_OPTIMIZATION_ADAM_BETA2;
+    double adamEpsilon = GlobalConfiguration::PREIMAGE_APPROXIMATION_OPTIMIZATION_ADAM_EPSILON;
+    bool incremental =
+        GlobalConfiguration::PREIMAGE_APPROXIMATION_OPTIMIZATION_INCREMENTAL_GRADIENT;
     unsigned dimension = getNumberOfParameters();
     bool maximize = false;
     double sign = ( maximize ? 1 : -1 );
@@ -1212,14 +1372,25 @@ const Vector<double> NetworkLevelReasoner::OptimalParameterisedSymbolicBoundTigh
         guess[j] = lb + dis( rng ) * ( ub - lb );
     }
 
+    // Every volume estimate uses the same input points, so sample them once.
+    const Vector<double> points = sampleVolumeEstimationPoints();
+    const Vector<unsigned> parameterLayers = getLayerIndicesOfParameters();
+
     Vector<Vector<double>> candidates( dimension );
     Vector<double> gradient( dimension );
+    Vector<double> firstMoment( dimension, 0 );
+    Vector<double> secondMoment( dimension, 0 );
 
     for ( unsigned i = 0; i < maxIterations; ++i )
     {
-        double currentCost = EstimateVolume( guess );
-        for ( unsigned j = 0; j < dimension; ++j )
+        double currentCost = EstimateVolume( guess, points );
+        for ( unsigned k = 0; k < dimension; ++k )
         {
+            // In incremental mode, perturb the parameters of the last layers first: after a
+            // perturbation of a parameter of layer l, only layers l onwards need to be propagated
+            // again, and the layers before l still hold the bounds for the current guess.
+            unsigned j = incremental ? dimension - 1 - k : k;
+
             candidates[j] = Vector<double>( guess );
             candidates[j][j] += stepSize;
 
@@ -1229,7 +1400,8 @@ const Vector<double> NetworkLevelReasoner::OptimalParameterisedSymbolicBoundTigh
                 continue;
             }
 
-            double cost = EstimateVolume( candidates[j] );
+            double cost =
+                EstimateVolume( candidates[j], points, incremental ? parameterLayers[j] : 0 );
             gradient[j] = ( cost - currentCost ) / stepSize + weightDecay * guess[j];
         }
 
@@ -1248,7 +1420,20 @@ const Vector<double> NetworkLevelReasoner::OptimalParameterisedSymbolicBoundTigh
 
         for ( unsigned j = 0; j < dimension; ++j )
         {
-            guess[j] += sign * lr * gradient[j];
+            if ( useAdam )
+            {
+                // Adam step, with bias-corrected estimates of the gradient's first and second
+                // moments
+                firstMoment[j] = beta1 * firstMoment[j] + ( 1 - beta1 ) * gradient[j];
+                secondMoment[j] =
+                    beta2 * secondMoment[j] + ( 1 - beta2 ) * gradient[j] * gradient[j];
+                double correctedFirstMoment = firstMoment[j] / ( 1 - std::pow( beta1, i + 1 ) );
+                double correctedSecondMoment = secondMoment[j] / ( 1 - std::pow( beta2, i + 1 ) );
+                guess[j] += sign * lr * correctedFirstMoment /
+                            ( std::sqrt( correctedSecondMoment ) + adamEpsilon );
+            }
+            else
+                guess[j] += sign * lr * gradient[j];
 
             guess[j] = std::min( guess[j], upperBounds[j] );
             guess[j] = std::max( guess[j], lowerBounds[j] );
@@ -1259,18 +1444,55 @@ const Vector<double> NetworkLevelReasoner::OptimalParameterisedSymbolicBoundTigh
     return optimalCoeffs;
 }
 
-double NetworkLevelReasoner::EstimateVolume( const Vector<double> &coeffs )
+const Vector<double> NetworkLevelReasoner::sampleVolumeEstimationPoints() const
+{
+    std::mt19937_64 rng( GlobalConfiguration::VOLUME_ESTIMATION_RANDOM_SEED );
+    const Layer *inputLayer = _layerIndexToLayer[0];
+    unsigned inputLayerSize = inputLayer->getSize();
+
+    Vector<double> points( GlobalConfiguration::VOLUME_ESTIMATION_ITERATIONS * inputLayerSize, 0 );
+    for ( unsigned i = 0; i < GlobalConfiguration::VOLUME_ESTIMATION_ITERATIONS; ++i )
+    {
+        for ( unsigned j = 0; j < inputLayerSize; ++j )
+        {
+            if ( inputLayer->neuronEliminated( j ) )
+                continue;
+
+            double lb = inputLayer->getLb( j );
+            double ub = inputLayer->getUb( j );
+            std::uniform_real_distribution<> dis( lb, ub );
+            points[i * inputLayerSize + j] = dis( rng );
+        }
+    }
+
+    return points;
+}
+
+const Vector<unsigned> NetworkLevelReasoner::getLayerIndicesOfParameters() const
+{
+    Vector<unsigned> parameterLayers;
+    for ( const auto &pair : _layerIndexToLayer )
+    {
+        unsigned coeffsCount = getNumberOfParametersPerType( pair.second->getLayerType() );
+        for ( unsigned i = 0; i < coeffsCount; ++i )
+            parameterLayers.append( pair.first );
+    }
+    return parameterLayers;
+}
+
+double NetworkLevelReasoner::EstimateVolume( const Vector<double> &coeffs,
+                                             const Vector<double> &points,
+                                             unsigned firstLayerIndex )
 {
     // First, run parameterised symbolic bound propagation.
     Map<unsigned, Vector<double>> layerIndicesToParameters = getParametersForLayers( coeffs );
-    for ( unsigned i = 0; i < _layerIndexToLayer.size(); ++i )
+    for ( unsigned i = firstLayerIndex; i < _layerIndexToLayer.size(); ++i )
     {
         ASSERT( _layerIndexToLayer.exists( i ) );
         const Vector<double> &currentLayerCoeffs = layerIndicesToParameters[i];
         _layerIndexToLayer[i]->computeParameterisedSymbolicBounds( currentLayerCoeffs );
     }
 
-    std::mt19937_64 rng( GlobalConfiguration::VOLUME_ESTIMATION_RANDOM_SEED );
     double logBoxVolume = 0;
     double sigmoidSum = 0;
 
@@ -1278,6 +1500,7 @@ double NetworkLevelReasoner::EstimateVolume( const Vector<double> &coeffs )
     unsigned outputLayerIndex = _layerIndexToLayer.size() - 1;
     Layer *inputLayer = _layerIndexToLayer[inputLayerIndex];
     Layer *outputLayer = _layerIndexToLayer[outputLayerIndex];
+    unsigned inputLayerSize = inputLayer->getSize();
 
     // Calculate volume of input variables' bounding box.
     for ( unsigned index = 0; index < inputLayer->getSize(); ++index )
@@ -1294,24 +1517,10 @@ double NetworkLevelReasoner::EstimateVolume( const Vector<double> &coeffs )
         logBoxVolume += std::log( ub - lb );
     }
 
+    ASSERT( points.size() == GlobalConfiguration::VOLUME_ESTIMATION_ITERATIONS * inputLayerSize );
     for ( unsigned i = 0; i < GlobalConfiguration::VOLUME_ESTIMATION_ITERATIONS; ++i )
     {
-        // Sample input point from known bounds.
-        Map<unsigned, double> point;
-        for ( unsigned j = 0; j < inputLayer->getSize(); ++j )
-        {
-            if ( inputLayer->neuronEliminated( j ) )
-            {
-                point.insert( j, 0 );
-            }
-            else
-            {
-                double lb = inputLayer->getLb( j );
-                double ub = inputLayer->getUb( j );
-                std::uniform_real_distribution<> dis( lb, ub );
-                point.insert( j, dis( rng ) );
-            }
-        }
+        const double *point = points.data() + i * inputLayerSize;
 
         // Calculate sigmoid of maximum margin from output symbolic bounds.
         double maxMargin = 0;
@@ -1331,7 +1540,7 @@ double NetworkLevelReasoner::EstimateVolume( const Vector<double> &coeffs )
 }
 
 double NetworkLevelReasoner::calculateDifferenceFromSymbolic( const Layer *layer,
-                                                              Map<unsigned, double> &point,
+                                                              const double *point,
                                                               unsigned i ) const
 {
     unsigned size = layer->getSize();
@@ -1556,10 +1765,12 @@ const Vector<NeuronIndex> NetworkLevelReasoner::selectPMNRNeurons()
 
 const Vector<PolygonalTightening> NetworkLevelReasoner::OptimizeParameterisedPolygonalTightening()
 {
-    // Calculate successor layers, PMNR scores, symbolic bound maps before optimizing.
+    // Calculate successor layers, PMNR scores, symbolic bound maps before optimizing. The
+    // optimization only reads these maps, so that it can evaluate candidates in parallel.
     computeSuccessorLayers();
     parameterisedDeepPoly( true );
     initializePMNRScoreMap();
+    getThreadPool();
 
     // Repeatedly optimize polygonal tightenings given previously optimized ones.
     const Vector<PolygonalTightening> &selectedTightenings = generatePolygonalTighteningsForPMNR();
@@ -1618,9 +1829,14 @@ double NetworkLevelReasoner::OptimizeSingleParameterisedPolygonalTighteningWithB
     }
     unsigned range =
         std::accumulate( branchCounts.begin(), branchCounts.end(), 1, std::multiplies<unsigned>() );
-    for ( unsigned i = 0; i < range; ++i )
-    {
-        Map<NeuronIndex, unsigned> neuronToBranchIndex;
+
+    // Optimize the branch combinations in parallel, and then combine their bounds in order, so
+    // that the result does not depend on the number of workers.
+    Vector<Map<NeuronIndex, unsigned>> branchIndices( range );
+    Vector<double> feasibilityBounds( range, 0 );
+    Vector<double> branchBounds( range, 0 );
+    getThreadPool().parallelFor( range, [&]( unsigned i, unsigned worker ) {
+        Map<NeuronIndex, unsigned> &neuronToBranchIndex = branchIndices[i];
         for ( unsigned j = 0; j < neuronCount; ++j )
         {
             unsigned mask = std::accumulate( branchCounts.begin(),
@@ -1634,7 +1850,7 @@ double NetworkLevelReasoner::OptimizeSingleParameterisedPolygonalTighteningWithB
 
         // To determine some of the infeasible branch combinations, calculate a feasibility bound
         // (known upper/lower bound for max/min problem) with concretization.
-        double feasibilityBound = 0;
+        double &feasibilityBound = feasibilityBounds[i];
         for ( const auto &pair : tightening._neuronToCoefficient )
         {
             double ub = _layerIndexToLayer[pair.first._layer]->getUb( pair.first._neuron );
@@ -1649,14 +1865,20 @@ double NetworkLevelReasoner::OptimizeSingleParameterisedPolygonalTighteningWithB
             }
         }
 
-        double branchBound = OptimizeSingleParameterisedPolygonalTightening(
-            tightening, prevTightenings, maximize, feasibilityBound, neuronToBranchIndex );
+        branchBounds[i] = OptimizeSingleParameterisedPolygonalTightening(
+            tightening, prevTightenings, maximize, feasibilityBound, neuronToBranchIndex, worker );
+    } );
+
+    for ( unsigned i = 0; i < range; ++i )
+    {
+        double feasibilityBound = feasibilityBounds[i];
+        double branchBound = branchBounds[i];
 
         // If bound is stronger than known feasibility bound, store branch combination in NLR.
         if ( !FloatUtils::isFinite( branchBound ) || maximize ? branchBound > feasibilityBound
                                                               : branchBound < feasibilityBound )
         {
-            receiveInfeasibleBranches( neuronToBranchIndex );
+            receiveInfeasibleBranches( branchIndices[i] );
         }
         else
         {
@@ -1674,7 +1896,8 @@ double NetworkLevelReasoner::OptimizeSingleParameterisedPolygonalTightening(
     Vector<PolygonalTightening> &prevTightenings,
     bool maximize,
     double feasibilityBound,
-    const Map<NeuronIndex, unsigned> &neuronToBranchIndex )
+    const Map<NeuronIndex, unsigned> &neuronToBranchIndex,
+    unsigned worker )
 {
     // Search over gamma in [0, inf)^sizeOfPrevTightenings with PGD.
     unsigned maxIterations = GlobalConfiguration::INVPROP_MAX_ITERATIONS;
@@ -1692,8 +1915,15 @@ double NetworkLevelReasoner::OptimizeSingleParameterisedPolygonalTightening(
     Vector<double> previousGamma( gamma );
 
     Vector<Vector<double>> gammaCandidates( gammaDimension );
+    Vector<double> gammaCosts( gammaDimension, 0 );
     Vector<double> gammaGradient( gammaDimension );
 
+    // Candidates are evaluated in batches of one per worker (or one by one, if the workers are
+    // already busy with other tasks), and then examined in order. Evaluating a candidate has no
+    // side effects, so the result does not depend on the batch size.
+    ThreadPool &pool = getThreadPool();
+    unsigned batchSize = pool.isRunningTask() ? 1 : pool.getNumberOfWorkers();
+
     for ( unsigned i = 0; i < maxIterations; ++i )
     {
         for ( unsigned j = 0; j < gammaDimension; ++j )
@@ -1703,7 +1933,7 @@ double NetworkLevelReasoner::OptimizeSingleParameterisedPolygonalTightening(
         }
 
         double currentCost = getParameterisdPolygonalTighteningBound(
-            gamma, tightening, prevTightenings, neuronToBranchIndex );
+            gamma, tightening, prevTightenings, neuronToBranchIndex, worker );
 
         // If calculated bound is stronger than known feasibility bound, stop optimization.
         if ( !FloatUtils::isFinite( currentCost ) || maximize ? currentCost > feasibilityBound
@@ -1712,26 +1942,46 @@ double NetworkLevelReasoner::OptimizeSingleParameterisedPolygonalTightening(
             return currentCost;
         }
 
-        for ( unsigned j = 0; j < gammaDimension; ++j )
+        for ( unsigned first = 0; first < gammaDimension; first += batchSize )
         {
-            gammaCandidates[j] = Vector<double>( gamma );
-            gammaCandidates[j][j] += gammaStepSize;
-            if ( gammaCandidates[j][j] < gammaLowerBounds[j] )
+            unsigned count = std::min( batchSize, gammaDimension - first );
+            for ( unsigned j = first; j < first + count; ++j )
             {
-                gammaGradient[j] = 0;
-                continue;
+                gammaCandidates[j] = Vector<double>( gamma );
+                gammaCandidates[j][j] += gammaStepSize;
             }
 
-            double cost = getParameterisdPolygonalTighteningBound(
-                gammaCandidates[j], tightening, prevTightenings, neuronToBranchIndex );
-            if ( !FloatUtils::isFinite( cost ) || maximize ? cost > feasibilityBound
-                                                           : cost < feasibilityBound )
+            pool.parallelFor( count, [&]( unsigned k, unsigned candidateWorker ) {
+                unsigned j = first + k;
+                if ( gammaCandidates[j][j] < gammaLowerBounds[j] )
+                    return;
+
+                gammaCosts[j] = getParameterisdPolygonalTighteningBound( gammaCandidates[j],
+                                                                         tightening,
+                                                                         prevTightenings,
+                                                                         neuronToBranchIndex,
+                                                                         candidateWorker );
+            } );
+
+            for ( unsigned j = first; j < first + count; ++j )
             {
-                return cost;
-            }
+                if ( gammaCandidates[j][j] < gammaLowerBounds[j] )
+                {
+                    gammaGradient[j] = 0;
+                    continue;
+                }
 
-            gammaGradient[j] = ( cost - currentCost ) / gammaStepSize;
-            bestBound = ( maximize ? std::max( bestBound, cost ) : std::min( bestBound, cost ) );
+                double cost = gammaCosts[j];
+                if ( !FloatUtils::isFinite( cost ) || maximize ? cost > feasibilityBound
+                                                               : cost < feasibilityBound )
+                {
+                    return cost;
+                }
+
+                gammaGradient[j] = ( cost - currentCost ) / gammaStepSize;
+                bestBound =
+                    ( maximize ? std::max( bestBound, cost ) : std::min( bestBound, cost ) );
+            }
         }
 
         bool gradientIsZero = true;
@@ -1761,36 +2011,60 @@ double NetworkLevelReasoner::getParameterisdPolygonalTighteningBound(
     const Vector<double> &gamma,
     PolygonalTightening &tightening,
     Vector<PolygonalTightening> &prevTightenings,
-    const Map<NeuronIndex, unsigned> &neuronToBranchIndex )
-{
+    const Map<NeuronIndex, unsigned> &neuronToBranchIndex,
+    unsigned worker )
+{
+    // This may run concurrently on several workers, so the symbolic bound maps are only read,
+    // through const references, and intermediate results are kept in the worker's scratch state.
+    const Map<unsigned, Vector<double>> &predecessorSymbolicLb = _predecessorSymbolicLb;
+    const Map<unsigned, Vector<double>> &predecessorSymbolicUb = _predecessorSymbolicUb;
+    const Map<unsigned, Vector<double>> &predecessorSymbolicLowerBias =
+        _predecessorSymbolicLowerBias;
+    const Map<unsigned, Vector<double>> &predecessorSymbolicUpperBias =
+        _predecessorSymbolicUpperBias;
+    const Map<NeuronIndex, Vector<double>> &symbolicLbPerBranch = _neuronToSymbolicLbPerBranch;
+    const Map<NeuronIndex, Vector<double>> &symbolicUbPerBranch = _neuronToSymbolicUbPerBranch;
+    const Map<NeuronIndex, Vector<double>> &symbolicLowerBiasPerBranch =
+        _neuronToSymbolicLowerBiasPerBranch;
+    const Map<NeuronIndex, Vector<double>> &symbolicUpperBiasPerBranch =
+        _neuronToSymbolicUpperBiasPerBranch;
+
+    ASSERT( worker < _polygonalTighteningScratch.size() );
+    PolygonalTighteningScratch &scratch = _polygonalTighteningScratch[worker];
+
     // Recursively compute vectors mu, muHat for every layer with the backpropagation procedure.
     unsigned numLayers = _layerIndexToLayer.size();
     unsigned maxLayer = _layerIndexToLayer.size() - 1;
     unsigned prevTigheningsCount = prevTightenings.size();
     unsigned inputLayerSize = _layerIndexToLayer[0]->getSize();
     double sign = ( tightening._type == PolygonalTightening::LB ? 1 : -1 );
-    Vector<Vector<double>> mu( numLayers );
-    Vector<Vector<double>> muHat( numLayers );
+    Vector<Vector<double>> &mu = scratch._mu;
+    Vector<Vector<double>> &muHat = scratch._muHat;
+    if ( mu.size() != numLayers )
+    {
+        mu = Vector<Vector<double>>( numLayers );
+        muHat = Vector<Vector<double>>( numLayers );
+    }
 
     for ( unsigned layerIndex = numLayers; layerIndex-- > 0; )
     {
         Layer *layer = _layerIndexToLayer[layerIndex];
         unsigned size = layer->getSize();
-        mu[layerIndex] = Vector<double>( size, 0 );
-        muHat[layerIndex] = Vector<double>( size, 0 );
+        mu[layerIndex].assign( size, 0 );
+        muHat[layerIndex].assign( size, 0 );
 
         if ( layerIndex < maxLayer )
         {
-            for ( unsigned i = 0; i < size; ++i )
+            for ( unsigned successorIndex : layer->getSuccessorLayers() )
             {
-                for ( unsigned successorIndex : layer->getSuccessorLayers() )
-                {
-                    const Layer *successorLayer = _layerIndexToLayer[successorIndex];
-                    unsigned successorSize = successorLayer->getSize();
+                const Layer *successorLayer = _layerIndexToLayer[successorIndex];
+                unsigned successorSize = successorLayer->getSize();
 
-                    if ( successorLayer->getLayerType() == Layer::WEIGHTED_SUM )
+                if ( successorLayer->getLayerType() == Layer::WEIGHTED_SUM )
+                {
+                    const double *weights = successorLayer->getWeightMatrix( layerIndex );
+                    for ( unsigned i = 0; i < size; ++i )
                     {
-                        const double *weights = successorLayer->getWeightMatrix( layerIndex );
                         for ( unsigned j = 0; j < successorSize; ++j )
                         {
                             if ( !successorLayer->neuronEliminated( j ) )
@@ -1800,57 +2074,52 @@ double NetworkLevelReasoner::getParameterisdPolygonalTighteningBound(
                             }
                         }
                     }
-                    else
+                }
+                else
+                {
+                    // Go over the activation sources of every successor neuron, and add its
+                    // contribution to the sources in the current layer. A neuron which appears
+                    // more than once among the sources is only counted at its first appearance,
+                    // so remember the last successor (plus one) seen for every neuron.
+                    Vector<unsigned> &lastSuccessor = scratch._lastSuccessor;
+                    lastSuccessor.assign( size, 0 );
+                    for ( unsigned j = 0; j < successorSize; ++j )
                     {
-                        for ( unsigned j = 0; j < successorSize; ++j )
+                        if ( successorLayer->neuronEliminated( j ) )
+                            continue;
+
+                        NeuronIndex successor( successorIndex, j );
+                        unsigned inputIndex = 0;
+                        for ( const auto &sourceIndex : successorLayer->getActivationSources( j ) )
                         {
-                            // Find the index of the current neuron in the successor's activation
-                            // sources list.
-                            bool found = false;
-                            unsigned inputIndex = 0;
-                            List<NeuronIndex> sources = successorLayer->getActivationSources( j );
-                            for ( const auto &sourceIndex : sources )
+                            unsigned i = sourceIndex._neuron;
+                            if ( sourceIndex._layer == layerIndex && lastSuccessor[i] != j + 1 )
                             {
-                                if ( sourceIndex._layer == layerIndex && sourceIndex._neuron == i )
+                                lastSuccessor[i] = j + 1;
+
+                                // When branching selected neurons, use predecessor symbolic
+                                // bounds for current branch.
+                                double symbolicLb;
+                                double symbolicUb;
+                                if ( neuronToBranchIndex.exists( successor ) )
                                 {
-                                    found = true;
-                                    break;
+                                    unsigned branch = neuronToBranchIndex[successor];
+                                    symbolicLb = symbolicLbPerBranch[successor][branch];
+                                    symbolicUb = symbolicUbPerBranch[successor][branch];
                                 }
-                                ++inputIndex;
-                            }
-                            NeuronIndex successor( successorIndex, j );
-                            if ( found )
-                            {
-                                if ( !successorLayer->neuronEliminated( j ) )
+                                else
                                 {
-                                    // When branching selected neurons, use predecessor symbolic
-                                    // bounds for current branch.
-                                    if ( neuronToBranchIndex.exists( successor ) )
-                                    {
-                                        muHat[layerIndex][i] +=
-                                            std::max( mu[successorIndex][j], 0.0 ) *
-                                            getSymbolicUbPerBranch(
-                                                successor )[neuronToBranchIndex[successor]];
-
-                                        muHat[layerIndex][i] -=
-                                            std::max( -mu[successorIndex][j], 0.0 ) *
-                                            getSymbolicLbPerBranch(
-                                                successor )[neuronToBranchIndex[successor]];
-                                    }
-                                    else
-                                    {
-                                        muHat[layerIndex][i] +=
-                                            std::max( mu[successorIndex][j], 0.0 ) *
-                                            getPredecessorSymbolicUb(
-                                                successorIndex )[successorSize * inputIndex + j];
-
-                                        muHat[layerIndex][i] -=
-                                            std::max( -mu[successorIndex][j], 0.0 ) *
-                                            getPredecessorSymbolicLb(
-                                                successorIndex )[successorSize * inputIndex + j];
-                                    }
+                                    unsigned entry = successorSize * inputIndex + j;
+                                    symbolicLb = predecessorSymbolicLb[successorIndex][entry];
+                                    symbolicUb = predecessorSymbolicUb[successorIndex][entry];
                                 }
+
+                                muHat[layerIndex][i] +=
+                                    std::max( mu[successorIndex][j], 0.0 ) * symbolicUb;
+                                muHat[layerIndex][i] -=
+                                    std::max( -mu[successorIndex][j], 0.0 ) * symbolicLb;
                             }
+                            ++inputIndex;
                         }
                     }
                 }
@@ -1866,7 +2135,7 @@ double NetworkLevelReasoner::getParameterisdPolygonalTighteningBound(
                                      sign * tightening.getCoeff( NeuronIndex( layerIndex, i ) );
                 for ( unsigned j = 0; j < prevTigheningsCount; ++j )
                 {
-                    PolygonalTightening pt = prevTightenings[j];
+                    const PolygonalTightening &pt = prevTightenings[j];
                     double prevCoeff = pt.getCoeff( NeuronIndex( layerIndex, i ) );
                     double currentSign = ( pt._type == PolygonalTightening::LB ? 1 : -1 );
                     mu[layerIndex][i] += currentSign * gamma[j] * prevCoeff;
@@ -1876,13 +2145,14 @@ double NetworkLevelReasoner::getParameterisdPolygonalTighteningBound(
     }
 
     // Compute global bound for input space minimization problem.
-    Vector<double> inputLayerBound( inputLayerSize, 0 );
+    Vector<double> &inputLayerBound = scratch._inputLayerBound;
+    inputLayerBound.assign( inputLayerSize, 0 );
     for ( unsigned i = 0; i < inputLayerSize; ++i )
     {
         inputLayerBound[i] += sign * tightening.getCoeff( NeuronIndex( 0, i ) ) - muHat[0][i];
         for ( unsigned j = 0; j < prevTigheningsCount; ++j )
         {
-            PolygonalTightening pt = prevTightenings[j];
+            const PolygonalTightening &pt = prevTightenings[j];
             double prevCoeff = pt.getCoeff( NeuronIndex( 0, i ) );
             double currentSign = ( pt._type == PolygonalTightening::LB ? 1 : -1 );
             inputLayerBound[i] -= currentSign * gamma[j] * prevCoeff;
@@ -1893,7 +2163,7 @@ double NetworkLevelReasoner::getParameterisdPolygonalTighteningBound(
     double bound = 0;
     for ( unsigned i = 0; i < prevTigheningsCount; ++i )
     {
-        PolygonalTightening pt = prevTightenings[i];
+        const PolygonalTightening &pt = prevTightenings[i];
         double currentSign = ( pt._type == PolygonalTightening::LB ? 1 : -1 );
         bound += currentSign * gamma[i] * pt._value;
     }
@@ -1925,17 +2195,18 @@ double NetworkLevelReasoner::getParameterisdPolygonalTighteningBound(
                     NeuronIndex index( layerIndex, i );
                     if ( neuronToBranchIndex.exists( index ) )
                     {
+                        unsigned branch = neuronToBranchIndex[index];
                         bound -= std::max( mu[layerIndex][i], 0.0 ) *
-                                 getSymbolicUpperBiasPerBranch( index )[neuronToBranchIndex[index]];
+                                 symbolicUpperBiasPerBranch[index][branch];
                         bound += std::max( -mu[layerIndex][i], 0.0 ) *
-                                 getSymbolicLowerBiasPerBranch( index )[neuronToBranchIndex[index]];
+                                 symbolicLowerBiasPerBranch[index][branch];
                     }
                     else
                     {
                         bound -= std::max( mu[layerIndex][i], 0.0 ) *
-                                 getPredecessorSymbolicUpperBias( layerIndex )[i];
+                                 predecessorSymbolicUpperBias[layerIndex][i];
                         bound += std::max( -mu[layerIndex][i], 0.0 ) *
-                                 getPredecessorSymbolicLowerBias( layerIndex )[i];
+                                 predecessorSymbolicLowerBias[layerIndex][i];
                     }
                 }
                 else
@@ -1958,8 +2229,9 @@ double NetworkLevelReasoner::getParameterisdPolygonalTighteningBound(
 
 void NetworkLevelReasoner::initializePMNRScoreMap()
 {
-    // Clear PMNR score map.
+    // Clear PMNR score map, and initialize BBPS branching points and branch symbolic bound maps.
     _neuronToPMNRScores.clear();
+    initializeBBPSBranchingMaps();
     for ( const auto &pair : _layerIndexToLayer )
     {
         for ( const auto &index : pair.second->getNonfixedNeurons() )
@@ -1971,9 +2243,6 @@ void NetworkLevelReasoner::initializePMNRScoreMap()
 
 double NetworkLevelReasoner::calculatePMNRBBPSScore( NeuronIndex index )
 {
-    // Initialize BBPS branching points and branch symbolic bound maps.
-    initializeBBPSBranchingMaps();
-
     Layer *outputLayer = _layerIndexToLayer[getNumberOfLayers() - 1];
     unsigned outputLayerSize = outputLayer->getSize();
     unsigned layerIndex = index._layer;
@@ -1982,25 +2251,27 @@ double NetworkLevelReasoner::calculatePMNRBBPSScore( NeuronIndex index )
 
     // We have the symbolic bounds map of the output layer in terms of the given neuron's layer.
     // Concretize all neurons except from the given neuron.
+    const Vector<double> outputSymbolicLb = getOutputSymbolicLb( layerIndex );
+    const Vector<double> outputSymbolicUb = getOutputSymbolicUb( layerIndex );
+    const Vector<double> outputSymbolicLowerBias = getOutputSymbolicLowerBias( layerIndex );
+    const Vector<double> outputSymbolicUpperBias = getOutputSymbolicUpperBias( layerIndex );
     Vector<double> concretizedOutputSymbolicLb( outputLayerSize, 0 );
     Vector<double> concretizedOutputSymbolicUb( outputLayerSize, 0 );
     Vector<double> concretizedOutputSymbolicLowerBias( outputLayerSize, 0 );
     Vector<double> concretizedOutputSymbolicUpperBias( outputLayerSize, 0 );
     for ( unsigned i = 0; i < outputLayerSize; ++i )
     {
-        concretizedOutputSymbolicLb[i] =
-            getOutputSymbolicLb( layerIndex )[outputLayerSize * neuron + i];
-        concretizedOutputSymbolicUb[i] =
-            getOutputSymbolicUb( layerIndex )[outputLayerSize * neuron + i];
-        concretizedOutputSymbolicLowerBias[i] = getOutputSymbolicLowerBias( layerIndex )[i];
-        concretizedOutputSymbolicUpperBias[i] = getOutputSymbolicUpperBias( layerIndex )[i];
+        concretizedOutputSymbolicLb[i] = outputSymbolicLb[outputLayerSize * neuron + i];
+        concretizedOutputSymbolicUb[i] = outputSymbolicUb[outputLayerSize * neuron + i];
+        concretizedOutputSymbolicLowerBias[i] = outputSymbolicLowerBias[i];
+        concretizedOutputSymbolicUpperBias[i] = outputSymbolicUpperBias[i];
 
         for ( unsigned j = 0; j < layer->getSize(); ++j )
         {
             if ( j != neuron )
             {
-                double lowerWeight = getOutputSymbolicLb( layerIndex )[outputLayerSize * j + i];
-                double upperWeight = getOutputSymbolicUb( layerIndex )[outputLayerSize * j + i];
+                double lowerWeight = outputSymbolicLb[outputLayerSize * j + i];
+                double upperWeight = outputSymbolicUb[outputLayerSize * j + i];
                 concretizedOutputSymbolicLowerBias[i] += lowerWeight > 0
                                                            ? lowerWeight * layer->getLb( j )
                                                            : lowerWeight * layer->getUb( j );
@@ -2091,46 +2362,74 @@ void NetworkLevelReasoner::initializeBBPSBranchingMaps()
     _neuronToSymbolicLowerBiasPerBranch.clear();
     _neuronToSymbolicUpperBiasPerBranch.clear();
 
-    // Calculate branching points, symbolic bounds for non-fixed neurons which support branching.
+    // Find the non-fixed neurons which support branching.
+    Vector<NeuronIndex> neurons;
     for ( const auto &pair : _layerIndexToLayer )
     {
         const Layer *layer = pair.second;
-        for ( const auto &index : layer->getNonfixedNeurons() )
+        if ( supportsInvpropBranching( layer->getLayerType() ) )
         {
-            if ( supportsInvpropBranching( layer->getLayerType() ) )
-            {
-                std::pair<NeuronIndex, double> point = calculateBranchingPoint( index );
-                _neuronToBBPSBranchingPoints.insert( index, point );
-
-                NeuronIndex sourceIndex = point.first;
-                double value = point.second;
-                const Layer *sourceLayer = _layerIndexToLayer[sourceIndex._layer];
-                double sourceLb = sourceLayer->getLb( sourceIndex._neuron );
-                double sourceUb = sourceLayer->getUb( sourceIndex._neuron );
-                const Vector<double> values = Vector<double>( { sourceLb, value, sourceUb } );
-
-                unsigned branchCount = values.size() - 1;
-                Vector<double> symbolicLbPerBranch = Vector<double>( branchCount, 0 );
-                Vector<double> symbolicUbPerBranch = Vector<double>( branchCount, 0 );
-                Vector<double> symbolicLowerBiasPerBranch = Vector<double>( branchCount, 0 );
-                Vector<double> symbolicUpperBiasPerBranch = Vector<double>( branchCount, 0 );
-
-                calculateSymbolicBoundsPerBranch( index,
-                                                  sourceIndex,
-                                                  values,
-                                                  symbolicLbPerBranch,
-                                                  symbolicUbPerBranch,
-                                                  symbolicLowerBiasPerBranch,
-                                                  symbolicUpperBiasPerBranch,
-                                                  branchCount );
-
-                _neuronToSymbolicLbPerBranch.insert( index, symbolicLbPerBranch );
-                _neuronToSymbolicUbPerBranch.insert( index, symbolicUbPerBranch );
-                _neuronToSymbolicLowerBiasPerBranch.insert( index, symbolicLowerBiasPerBranch );
-                _neuronToSymbolicUpperBiasPerBranch.insert( index, symbolicUpperBiasPerBranch );
-            }
+            for ( const auto &index : layer->getNonfixedNeurons() )
+                neurons.append( index );
         }
     }
+
+    // Calculate their branching points and branch symbolic bounds in parallel, and then store
+    // them in the maps.
+    unsigned neuronCount = neurons.size();
+    Vector<std::pair<NeuronIndex, double>> points( neuronCount );
+    Vector<Vector<double>> symbolicLbPerBranch( neuronCount );
+    Vector<Vector<double>> symbolicUbPerBranch( neuronCount );
+    Vector<Vector<double>> symbolicLowerBiasPerBranch( neuronCount );
+    Vector<Vector<double>> symbolicUpperBiasPerBranch( neuronCount );
+    getThreadPool().parallelFor( neuronCount, [&]( unsigned i, unsigned ) {
+        NeuronIndex index = neurons[i];
+        points[i] = calculateBranchingPoint( index );
+
+        NeuronIndex sourceIndex = points[i].first;
+        double value = points[i].second;
+        const Layer *sourceLayer = _layerIndexToLayer[sourceIndex._layer];
+        double sourceLb = sourceLayer->getLb( sourceIndex._neuron );
+        double sourceUb = sourceLayer->getUb( sourceIndex._neuron );
+        const Vector<double> values = Vector<double>( { sourceLb, value, sourceUb } );
+
+        unsigned branchCount = values.size() - 1;
+        symbolicLbPerBranch[i] = Vector<double>( branchCount, 0 );
+        symbolicUbPerBranch[i] = Vector<double>( branchCount, 0 );
+        symbolicLowerBiasPerBranch[i] = Vector<double>( branchCount, 0 );
+        symbolicUpperBiasPerBranch[i] = Vector<double>( branchCount, 0 );
+
+        calculateSymbolicBoundsPerBranch( index,
+                                          sourceIndex,
+                                          values,
+                                          symbolicLbPerBranch[i],
+                                          symbolicUbPerBranch[i],
+                                          symbolicLowerBiasPerBranch[i],
+                                          symbolicUpperBiasPerBranch[i],
+                                          branchCount );
+    } );
+
+    for ( unsigned i = 0; i < neuronCount; ++i )
+    {
+        NeuronIndex index = neurons[i];
+        _neuronToBBPSBranchingPoints.insert( index, points[i] );
+        _neuronToSymbolicLbPerBranch.insert( index, symbolicLbPerBranch[i] );
+        _neuronToSymbolicUbPerBranch.insert( index, symbolicUbPerBranch[i] );
+        _neuronToSymbolicLowerBiasPerBranch.insert( index, symbolicLowerBiasPerBranch[i] );
+        _neuronToSymbolicUpperBiasPerBranch.insert( index, symbolicUpperBiasPerBranch[i] );
+    }
+}
+
+ThreadPool &NetworkLevelReasoner::getThreadPool()
+{
+    unsigned numberOfWorkers = std::max( Options::get()->getInt( Options::NUM_WORKERS ), 1 );
+    if ( !_threadPool || _threadPool->getNumberOfWorkers() != numberOfWorkers )
+    {
+        ASSERT( !_threadPool || !_threadPool->isRunningTask() );
+        _threadPool = std::unique_ptr<ThreadPool>( new ThreadPool( numberOfWorkers ) );
+        _polygonalTighteningScratch = Vector<PolygonalTighteningScratch>( numberOfWorkers );
+    }
+    return *_threadPool;
 }
 
 const std::pair<NeuronIndex, double>
@@ -16,6 +16,7 @@
 #ifndef __NetworkLevelReasoner_h__
 #define __NetworkLevelReasoner_h__
 
+#include "BoundCache.h"
 #include "DeepPolyAnalysis.h"
 #include "ITableau.h"
 #include "LPFormulator.h"
@@ -31,6 +32,8 @@
 
 #include <memory>
 
+class ThreadPool;
+
 namespace NLR {
 
 /*
@@ -160,6 +163,16 @@ public:
     void symbolicBoundPropagation();
     void parameterisedSymbolicBoundPropagation( const Vector<double> &coeffs );
     void deepPolyPropagation();
+
+    /*
+      Demand-driven DeepPoly: see DeepPolyAnalysis::runDemandDriven(). The
+      output symbolic bounds stored by the last parameterisedDeepPoly( true ),
+      if still sound, are applied to the output layer first, in case they
+      already settle the query. Invoked by deepPolyPropagation() if
+      GlobalConfiguration::DEEP_POLY_DEMAND_DRIVEN_BACK_SUBSTITUTION is set.
+    */
+    void demandDrivenDeepPolyPropagation();
+
     void parameterisedDeepPoly( bool storeSymbolicBounds = false,
                                 const Vector<double> &coeffs = Vector<double>( {} ) );
     void lpRelaxationPropagation();
@@ -168,6 +181,27 @@ public:
     void MILPTighteningForOneLayer( unsigned targetIndex );
     void iterativePropagation();
 
+    /*
+      Bound caching across queries on the same network (see BoundCache.h):
+      applyCachedBounds() tightens the current bounds with every cached
+      entry that applies to them, and records the current bounds as the
+      starting point of the analysis that follows. storeBoundsInCache()
+      then caches the bounds that the analysis computed.
+    */
+    unsigned applyCachedBounds( const BoundCache &cache );
+    void storeBoundsInCache( BoundCache &cache, bool storeSymbolicBounds ) const;
+
+    /*
+      Batched bound propagation (see BatchedBoundPropagator.h): compute the
+      bounds of the output layer for each of several input boxes at once,
+      independently of the current bounds. Returns false, and computes
+      nothing, if the network has layers that are not supported.
+    */
+    bool batchedBoundPropagation( const Vector<Vector<double>> &inputLbs,
+                                  const Vector<Vector<double>> &inputUbs,
+                                  Vector<Vector<double>> &outputLbs,
+                                  Vector<Vector<double>> &outputUbs ) const;
+
     void receiveTighterBound( Tightening tightening );
     void getConstraintTightenings( List<Tightening> &tightenings );
     void clearConstraintTightenings();
@@ -302,6 +336,20 @@ private:
     Map<unsigned, Vector<double>> _outputSymbolicLowerBias;
     Map<unsigned, Vector<double>> _outputSymbolicUpperBias;
 
+    /*
+      The bounds of each layer at the time the output symbolic bounds were
+      stored. The relaxations these were computed with remain sound for as
+      long as the bounds of every layer stay within these.
+    */
+    Map<unsigned, Vector<double>> _outputSymbolicBoundsLayerLbs;
+    Map<unsigned, Vector<double>> _outputSymbolicBoundsLayerUbs;
+
+    /*
+      The bounds of each layer before the cached bounds were applied
+    */
+    Map<unsigned, Vector<double>> _boundCacheStartLbs;
+    Map<unsigned, Vector<double>> _boundCacheStartUbs;
+
     Map<NeuronIndex, double> _neuronToPMNRScores;
 
     Map<NeuronIndex, std::pair<NeuronIndex, double>> _neuronToBBPSBranchingPoints;
@@ -312,6 +360,17 @@ private:
 
     void freeMemoryIfNeeded();
 
+    /*
+      Tighten the bounds of the output layer by concretizing the stored
+      output symbolic bounds with respect to the input layer, if these are
+      still sound.
+    */
+    void tightenOutputBoundsWithStoredSymbolicBounds();
+
+    // Copy the current bounds of every layer
+    void recordLayerBounds( Map<unsigned, Vector<double>> &lbs,
+                            Map<unsigned, Vector<double>> &ubs ) const;
+
     // Map each neuron to a linear expression representing its weighted sum
     void generateLinearExpressionForWeightedSumLayer(
         Map<unsigned, LinearExpression> &variableToExpression,
@@ -346,13 +405,24 @@ private:
     // Optimize biases of generated parameterised polygonal tightenings.
     const Vector<PolygonalTightening> OptimizeParameterisedPolygonalTightening();
 
-    // Estimate Volume of parameterised symbolic bound tightening.
-    double EstimateVolume( const Vector<double> &coeffs );
+    // Estimate Volume of parameterised symbolic bound tightening, over the given sample of input
+    // points. Only the layers from firstLayerIndex onwards are propagated; the symbolic bounds of
+    // the layers before it should already correspond to coeffs.
+    double EstimateVolume( const Vector<double> &coeffs,
+                           const Vector<double> &points,
+                           unsigned firstLayerIndex = 0 );
+
+    // Sample input points uniformly from the input layer's bounds, for estimating volumes. The
+    // points are stored consecutively, each one as a vector of the input layer's size.
+    const Vector<double> sampleVolumeEstimationPoints() const;
+
+    // Return the index of the layer of each optimizable parameter.
+    const Vector<unsigned> getLayerIndicesOfParameters() const;
 
     // Return difference between given point and upper and lower bounds determined by parameterised
     // SBT relaxation.
     double calculateDifferenceFromSymbolic( const Layer *layer,
-                                            Map<unsigned, double> &point,
+                                            const double *point,
                                             unsigned i ) const;
 
     // Heuristically generating optimizable polygonal tightening for PMNR.
@@ -361,13 +431,15 @@ private:
     // Heuristically select neurons for PMNR.
     const Vector<NeuronIndex> selectPMNRNeurons();
 
-    // Optimize biases of generated parameterised polygonal tightenings.
+    // Optimize biases of generated parameterised polygonal tightenings. The candidate gammas of
+    // every iteration are evaluated in parallel; worker is the index of the calling worker.
     double OptimizeSingleParameterisedPolygonalTightening(
         PolygonalTightening &tightening,
         Vector<PolygonalTightening> &prevTightenings,
         bool maximize,
         double feasibilityBound,
-        const Map<NeuronIndex, unsigned> &neuronToBranchIndex = Map<NeuronIndex, unsigned>( {} ) );
+        const Map<NeuronIndex, unsigned> &neuronToBranchIndex = Map<NeuronIndex, unsigned>( {} ),
+        unsigned worker = 0 );
 
     double OptimizeSingleParameterisedPolygonalTighteningWithBranching(
         PolygonalTightening &tightening,
@@ -375,12 +447,31 @@ private:
         bool maximize,
         double bound );
 
-    // Get current lower bound for selected parameterised polygonal tightenings' biases.
+    // Get current lower bound for selected parameterised polygonal tightenings' biases. May run
+    // concurrently on different workers, each one using its own scratch state.
     double getParameterisdPolygonalTighteningBound(
         const Vector<double> &gamma,
         PolygonalTightening &tightening,
         Vector<PolygonalTightening> &prevTightenings,
-        const Map<NeuronIndex, unsigned> &neuronToBranchIndex = Map<NeuronIndex, unsigned>( {} ) );
+        const Map<NeuronIndex, unsigned> &neuronToBranchIndex = Map<NeuronIndex, unsigned>( {} ),
+        unsigned worker = 0 );
+
+    /*
+      Workers for evaluating independent candidates of polygonal tightening
+      optimization in parallel, as many as the NUM_WORKERS option, and the
+      scratch state of each worker for computing tightening bounds
+    */
+    struct PolygonalTighteningScratch
+    {
+        Vector<Vector<double>> _mu;
+        Vector<Vector<double>> _muHat;
+        Vector<double> _inputLayerBound;
+        Vector<unsigned> _lastSuccessor;
+    };
+
+    std::unique_ptr<ThreadPool> _threadPool;
+    Vector<PolygonalTighteningScratch> _polygonalTighteningScratch;
+    ThreadPool &getThreadPool();
 
     /*
       Store previous biases for each ReLU neuron in a map for getPreviousBias()
@@ -0,0 +1,185 @@
+/*********************                                                        */
+/*! \file Test_BatchedBoundPropagator.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "BatchedBoundPropagator.h"
+#include "FloatUtils.h"
+#include "Layer.h"
+#include "NetworkLevelReasoner.h"
+#include "Vector.h"
+
+#include <cxxtest/TestSuite.h>
+
+class BatchedBoundPropagatorTestSuite : public CxxTest::TestSuite
+{
+public:
+    void populateNetwork( NLR::NetworkLevelReasoner &nlr )
+    {
+        /*
+              2      R       1
+          x0 --- x2 ---> x4 --- x6
+            \    /              /
+           1 \  /              /
+              \/           -1 /
+              /\             /
+           3 /  \           /
+            /    \   R     /
+          x1 --- x3 ---> x5
+              1
+        */
+
+        // Create the layers
+        nlr.addLayer( 0, NLR::Layer::INPUT, 2 );
+        nlr.addLayer( 1, NLR::Layer::WEIGHTED_SUM, 2 );
+        nlr.addLayer( 2, NLR::Layer::RELU, 2 );
+        nlr.addLayer( 3, NLR::Layer::WEIGHTED_SUM, 1 );
+
+        // Mark layer dependencies
+        for ( unsigned i = 1; i <= 3; ++i )
+            nlr.addLayerDependency( i - 1, i );
+
+        // Weights
+        nlr.setWeight( 0, 0, 1, 0, 2 );
+        nlr.setWeight( 0, 0, 1, 1, 1 );
+        nlr.setWeight( 0, 1, 1, 0, 3 );
+        nlr.setWeight( 0, 1, 1, 1, 1 );
+        nlr.setWeight( 2, 0, 3, 0, 1 );
+        nlr.setWeight( 2, 1, 3, 0, -1 );
+
+        // Mark the ReLU sources
+        nlr.addActivationSource( 1, 0, 2, 0 );
+        nlr.addActivationSource( 1, 1, 2, 1 );
+
+        // Variable indexing
+        nlr.setNeuronVariable( NLR::NeuronIndex( 0, 0 ), 0 );
+        nlr.setNeuronVariable( NLR::NeuronIndex( 0, 1 ), 1 );
+
+        nlr.setNeuronVariable( NLR::NeuronIndex( 1, 0 ), 2 );
+        nlr.setNeuronVariable( NLR::NeuronIndex( 1, 1 ), 3 );
+
+        nlr.setNeuronVariable( NLR::NeuronIndex( 2, 0 ), 4 );
+        nlr.setNeuronVariable( NLR::NeuronIndex( 2, 1 ), 5 );
+
+        nlr.setNeuronVariable( NLR::NeuronIndex( 3, 0 ), 6 );
+    }
+
+    void assertBounds( const NLR::BatchedBoundPropagator &propagator,
+                       unsigned layer,
+                       unsigned box,
+                       const Vector<double> &expectedLbs,
+                       const Vector<double> &expectedUbs )
+    {
+        for ( unsigned i = 0; i < expectedLbs.size(); ++i )
+        {
+            TS_ASSERT( FloatUtils::areEqual( propagator.getLbs( layer, box )[i], expectedLbs[i] ) );
+            TS_ASSERT( FloatUtils::areEqual( propagator.getUbs( layer, box )[i], expectedUbs[i] ) );
+        }
+    }
+
+    void test_relus_active_and_not_fixed()
+    {
+        NLR::NetworkLevelReasoner nlr;
+        populateNetwork( nlr );
+
+        TS_ASSERT( NLR::BatchedBoundPropagator::supports( &nlr ) );
+
+        NLR::BatchedBoundPropagator propagator( &nlr );
+        TS_ASSERT_THROWS_NOTHING(
+            propagator.run( Vector<Vector<double>>( { { 4, 1 }, { -1, -1 } } ),
+                            Vector<Vector<double>>( { { 6, 5 }, { 1, 1 } } ) ) );
+        TS_ASSERT_EQUALS( propagator.getNumberOfBoxes(), 2u );
+
+        /*
+          Box 0: x0: [4, 6], x1: [1, 5]. Both ReLUs are active:
+
+          x2 = x4 = 2x0 + 3x1   : [11, 27]
+          x3 = x5 =  x0 + x1    : [5, 11]
+          x6      =  x0 + 2x1   : [6, 16]
+        */
+        assertBounds( propagator, 1, 0, { 11, 5 }, { 27, 11 } );
+        assertBounds( propagator, 2, 0, { 11, 5 }, { 27, 11 } );
+        assertBounds( propagator, 3, 0, { 6 }, { 16 } );
+
+        /*
+          Box 1: x0: [-1, 1], x1: [-1, 1]. Neither ReLU is fixed:
+
+          x2 = 2x0 + 3x1 : [-5, 5]
+          x3 =  x0 + x1  : [-2, 2]
+
+          x4.lb = x0 + 1.5x1, x4.ub = x0 + 1.5x1 + 2.5   : [0, 5]
+          x5.lb = 0.5x0 + 0.5x1, x5.ub = 0.5x0 + 0.5x1 + 1 : [0, 2]
+
+          x6.lb = 0.5x0 + x1 - 1   : [-2.5, 0.5]
+          x6.ub = 0.5x0 + x1 + 2.5 : [1, 4]
+
+          With interval arithmetic x6 is in [-2, 5], so x6: [-2, 4]
+        */
+        assertBounds( propagator, 1, 1, { -5, -2 }, { 5, 2 } );
+        assertBounds( propagator, 2, 1, { 0, 0 }, { 5, 2 } );
+        assertBounds( propagator, 3, 1, { -2 }, { 4 } );
+    }
+
+    void test_bounds_are_sound()
+    {
+        NLR::NetworkLevelReasoner nlr;
+        populateNetwork( nlr );
+
+        Vector<Vector<double>> inputLbs( { { -1, -1 }, { -1, 0 }, { 0.5, -3 } } );
+        Vector<Vector<double>> inputUbs( { { 1, 1 }, { 0, 0.5 }, { 2, 1 } } );
+
+        Vector<Vector<double>> outputLbs;
+        Vector<Vector<double>> outputUbs;
+        TS_ASSERT( nlr.batchedBoundPropagation( inputLbs, inputUbs, outputLbs, outputUbs ) );
+        TS_ASSERT_EQUALS( outputLbs.size(), 3u );
+
+        for ( unsigned k = 0; k < inputLbs.size(); ++k )
+        {
+            TS_ASSERT_EQUALS( outputLbs[k].size(), 1u );
+
+            for ( unsigned a = 0; a <= 10; ++a )
+            {
+                for ( unsigned b = 0; b <= 10; ++b )
+                {
+                    double input[2] = {
+                        inputLbs[k][0] + ( inputUbs[k][0] - inputLbs[k][0] ) * a / 10,
+                        inputLbs[k][1] + ( inputUbs[k][1] - inputLbs[k][1] ) * b / 10,
+                    };
+                    double output[1];
+                    nlr.evaluate( input, output );
+
+                    TS_ASSERT( FloatUtils::gte( output[0], outputLbs[k][0] ) );
+                    TS_ASSERT( FloatUtils::lte( output[0], outputUbs[k][0] ) );
+                }
+            }
+        }
+    }
+
+    void test_unsupported_layers()
+    {
+        NLR::NetworkLevelReasoner nlr;
+        nlr.addLayer( 0, NLR::Layer::INPUT, 1 );
+        nlr.addLayer( 1, NLR::Layer::SIGN, 1 );
+        nlr.addLayerDependency( 0, 1 );
+        nlr.addActivationSource( 0, 0, 1, 0 );
+
+        TS_ASSERT( !NLR::BatchedBoundPropagator::supports( &nlr ) );
+
+        Vector<Vector<double>> outputLbs;
+        Vector<Vector<double>> outputUbs;
+        TS_ASSERT( !nlr.batchedBoundPropagation( Vector<Vector<double>>( { { 0 } } ),
+                                                 Vector<Vector<double>>( { { 1 } } ),
+                                                 outputLbs,
+                                                 outputUbs ) );
+    }
+};
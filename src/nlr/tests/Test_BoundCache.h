@@ -0,0 +1,319 @@
+/*********************                                                        */
+/*! \file Test_BoundCache.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "../../engine/tests/MockTableau.h"
+#include "BoundCache.h"
+#include "FloatUtils.h"
+#include "Layer.h"
+#include "MockErrno.h"
+#include "MockFileFactory.h"
+#include "NLRError.h"
+#include "NetworkLevelReasoner.h"
+#include "Options.h"
+#include "Tightening.h"
+
+#include <cxxtest/TestSuite.h>
+
+class BoundCacheTestSuite : public CxxTest::TestSuite
+{
+public:
+    void setUp()
+    {
+        Options::get()->setString( Options::SYMBOLIC_BOUND_TIGHTENING_TYPE, "sbt" );
+    }
+
+    void tearDown()
+    {
+        Options::get()->setString( Options::SYMBOLIC_BOUND_TIGHTENING_TYPE, "deeppoly" );
+    }
+
+    void populateNetwork( NLR::NetworkLevelReasoner &nlr, MockTableau &tableau )
+    {
+        /*
+              2      R       1
+          x0 --- x2 ---> x4 --- x6
+            \    /              /
+           1 \  /              /
+              \/           -1 /
+              /\             /
+           3 /  \           /
+            /    \   R     /
+          x1 --- x3 ---> x5
+              1
+        */
+
+        // Create the layers
+        nlr.addLayer( 0, NLR::Layer::INPUT, 2 );
+        nlr.addLayer( 1, NLR::Layer::WEIGHTED_SUM, 2 );
+        nlr.addLayer( 2, NLR::Layer::RELU, 2 );
+        nlr.addLayer( 3, NLR::Layer::WEIGHTED_SUM, 1 );
+
+        // Mark layer dependencies
+        for ( unsigned i = 1; i <= 3; ++i )
+            nlr.addLayerDependency( i - 1, i );
+
+        // Weights
+        nlr.setWeight( 0, 0, 1, 0, 2 );
+        nlr.setWeight( 0, 0, 1, 1, 1 );
+        nlr.setWeight( 0, 1, 1, 0, 3 );
+        nlr.setWeight( 0, 1, 1, 1, 1 );
+        nlr.setWeight( 2, 0, 3, 0, 1 );
+        nlr.setWeight( 2, 1, 3, 0, -1 );
+
+        // Mark the ReLU sources
+        nlr.addActivationSource( 1, 0, 2, 0 );
+        nlr.addActivationSource( 1, 1, 2, 1 );
+
+        // Variable indexing
+        nlr.setNeuronVariable( NLR::NeuronIndex( 0, 0 ), 0 );
+        nlr.setNeuronVariable( NLR::NeuronIndex( 0, 1 ), 1 );
+
+        nlr.setNeuronVariable( NLR::NeuronIndex( 1, 0 ), 2 );
+        nlr.setNeuronVariable( NLR::NeuronIndex( 1, 1 ), 3 );
+
+        nlr.setNeuronVariable( NLR::NeuronIndex( 2, 0 ), 4 );
+        nlr.setNeuronVariable( NLR::NeuronIndex( 2, 1 ), 5 );
+
+        nlr.setNeuronVariable( NLR::NeuronIndex( 3, 0 ), 6 );
+
+        // Very loose bounds for neurons except inputs
+        double large = 1000000;
+
+        tableau.getBoundManager().initialize( 7 );
+        for ( unsigned i = 2; i < 7; ++i )
+        {
+            tableau.setLowerBound( i, -large );
+            tableau.setUpperBound( i, large );
+        }
+
+        nlr.setTableau( &tableau );
+    }
+
+    void setInputBounds( MockTableau &tableau, double lb0, double ub0, double lb1, double ub1 )
+    {
+        tableau.setLowerBound( 0, lb0 );
+        tableau.setUpperBound( 0, ub0 );
+        tableau.setLowerBound( 1, lb1 );
+        tableau.setUpperBound( 1, ub1 );
+    }
+
+    // Run SBT on the network with inputs x0: [4, 6], x1: [1, 5], and cache
+    // the results
+    void populateCache( NLR::BoundCache &cache, bool storeSymbolicBounds )
+    {
+        NLR::NetworkLevelReasoner nlr;
+        MockTableau tableau;
+        populateNetwork( nlr, tableau );
+        setInputBounds( tableau, 4, 6, 1, 5 );
+
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_EQUALS( nlr.applyCachedBounds( cache ), 0u );
+        TS_ASSERT_THROWS_NOTHING( nlr.symbolicBoundPropagation() );
+        TS_ASSERT_THROWS_NOTHING( nlr.storeBoundsInCache( cache, storeSymbolicBounds ) );
+    }
+
+    void assertBounds( const NLR::NetworkLevelReasoner &nlr, double expected[7][2] )
+    {
+        unsigned variable = 0;
+        for ( unsigned layer = 0; layer < nlr.getNumberOfLayers(); ++layer )
+        {
+            for ( unsigned i = 0; i < nlr.getLayer( layer )->getSize(); ++i, ++variable )
+            {
+                TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( layer )->getLb( i ),
+                                                 expected[variable][0] ) );
+                TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( layer )->getUb( i ),
+                                                 expected[variable][1] ) );
+            }
+        }
+    }
+
+    void test_contained_box_reuses_symbolic_bounds()
+    {
+        NLR::BoundCache cache;
+        populateCache( cache, true );
+        TS_ASSERT_EQUALS( cache.getNumberOfEntries(), 1u );
+
+        NLR::NetworkLevelReasoner nlr;
+        MockTableau tableau;
+        populateNetwork( nlr, tableau );
+        setInputBounds( tableau, 4, 5, 2, 3 );
+
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_EQUALS( nlr.applyCachedBounds( cache ), 1u );
+
+        /*
+          The cached symbolic bounds, concretized over the new box:
+
+          x2 = x4 = 2x0 + 3x1   : [14, 19]
+          x3 = x5 =  x0 + x1    : [6, 8]
+          x6      =  x0 + 2x1   : [8, 11]
+        */
+        double expected[7][2] = {
+            { 4, 5 }, { 2, 3 }, { 14, 19 }, { 6, 8 }, { 14, 19 }, { 6, 8 }, { 8, 11 },
+        };
+        assertBounds( nlr, expected );
+
+        List<Tightening> tightenings;
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( tightenings ) );
+        TS_ASSERT_EQUALS( tightenings.size(), 10u );
+        TS_ASSERT( tightenings.exists( Tightening( 6, 8, Tightening::LB ) ) );
+        TS_ASSERT( tightenings.exists( Tightening( 6, 11, Tightening::UB ) ) );
+    }
+
+    void test_contained_box_reuses_concrete_bounds()
+    {
+        NLR::BoundCache cache;
+        populateCache( cache, false );
+
+        NLR::NetworkLevelReasoner nlr;
+        MockTableau tableau;
+        populateNetwork( nlr, tableau );
+        setInputBounds( tableau, 4, 5, 2, 3 );
+
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_EQUALS( nlr.applyCachedBounds( cache ), 1u );
+
+        // Without symbolic bounds, only the bounds computed for the cached
+        // box carry over
+        double expected[7][2] = {
+            { 4, 5 }, { 2, 3 }, { 11, 27 }, { 5, 11 }, { 11, 27 }, { 5, 11 }, { 6, 16 },
+        };
+        assertBounds( nlr, expected );
+    }
+
+    void test_box_not_contained_is_not_reused()
+    {
+        NLR::BoundCache cache;
+        populateCache( cache, true );
+
+        NLR::NetworkLevelReasoner nlr;
+        MockTableau tableau;
+        populateNetwork( nlr, tableau );
+        setInputBounds( tableau, 3, 5, 2, 3 );
+
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_EQUALS( nlr.applyCachedBounds( cache ), 0u );
+
+        List<Tightening> tightenings;
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( tightenings ) );
+        TS_ASSERT( tightenings.empty() );
+    }
+
+    void test_different_network_is_not_reused()
+    {
+        NLR::BoundCache cache;
+        populateCache( cache, true );
+
+        NLR::NetworkLevelReasoner nlr;
+        MockTableau tableau;
+        populateNetwork( nlr, tableau );
+        nlr.setWeight( 2, 1, 3, 0, -2 );
+        setInputBounds( tableau, 4, 5, 2, 3 );
+
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_EQUALS( nlr.applyCachedBounds( cache ), 0u );
+    }
+
+    void test_same_box_refines_entry()
+    {
+        NLR::BoundCache cache;
+        populateCache( cache, false );
+
+        NLR::NetworkLevelReasoner nlr;
+        MockTableau tableau;
+        populateNetwork( nlr, tableau );
+        setInputBounds( tableau, 4, 6, 1, 5 );
+
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_EQUALS( nlr.applyCachedBounds( cache ), 1u );
+
+        // A later analysis finds a tighter upper bound for x6, but a looser
+        // lower bound for x2
+        nlr.getLayerIndexToLayer()[3]->setUb( 0, 12 );
+        nlr.getLayerIndexToLayer()[1]->setLb( 0, 10 );
+        TS_ASSERT_THROWS_NOTHING( nlr.storeBoundsInCache( cache, false ) );
+
+        TS_ASSERT_EQUALS( cache.getNumberOfEntries(), 1u );
+        const NLR::BoundCache::Entry &entry = *cache.getEntries().begin();
+        TS_ASSERT( FloatUtils::areEqual( entry._ubs[3][0], 12 ) );
+        TS_ASSERT( FloatUtils::areEqual( entry._lbs[3][0], 6 ) );
+        TS_ASSERT( FloatUtils::areEqual( entry._lbs[1][0], 11 ) );
+
+        // Another box gets its own entry
+        NLR::NetworkLevelReasoner other;
+        MockTableau otherTableau;
+        populateNetwork( other, otherTableau );
+        setInputBounds( otherTableau, 0, 1, 0, 1 );
+        TS_ASSERT_THROWS_NOTHING( other.obtainCurrentBounds() );
+        TS_ASSERT_EQUALS( other.applyCachedBounds( cache ), 0u );
+        TS_ASSERT_THROWS_NOTHING( other.storeBoundsInCache( cache, false ) );
+        TS_ASSERT_EQUALS( cache.getNumberOfEntries(), 2u );
+    }
+
+    void test_save_and_load()
+    {
+        NLR::BoundCache cache;
+        populateCache( cache, true );
+
+        String contents;
+        {
+            MockFileFactory fileFactory;
+            TS_ASSERT_THROWS_NOTHING( cache.save( "cache.txt" ) );
+            TS_ASSERT_EQUALS( fileFactory.mockFile.lastPath, "cache.txt" );
+            TS_ASSERT_EQUALS( fileFactory.mockFile.lastOpenMode, IFile::MODE_WRITE_TRUNCATE );
+            contents = fileFactory.mockFile.writtenLines;
+        }
+
+        NLR::BoundCache loaded;
+        {
+            MockFileFactory fileFactory;
+            fileFactory.mockFile.writtenLines = contents;
+            TS_ASSERT_THROWS_NOTHING( loaded.load( "cache.txt" ) );
+        }
+
+        TS_ASSERT_EQUALS( loaded.getNumberOfEntries(), 1u );
+        const NLR::BoundCache::Entry &expected = *cache.getEntries().begin();
+        const NLR::BoundCache::Entry &entry = *loaded.getEntries().begin();
+        TS_ASSERT_EQUALS( entry._networkHash, expected._networkHash );
+        TS_ASSERT_EQUALS( entry._inputBoxHash, expected._inputBoxHash );
+        TS_ASSERT_EQUALS( entry._phaseFixingsHash, expected._phaseFixingsHash );
+        TS_ASSERT( entry._startLbs == expected._startLbs );
+        TS_ASSERT( entry._startUbs == expected._startUbs );
+        TS_ASSERT( entry._lbs == expected._lbs );
+        TS_ASSERT( entry._ubs == expected._ubs );
+        TS_ASSERT( entry._symbolicLb == expected._symbolicLb );
+        TS_ASSERT( entry._symbolicUb == expected._symbolicUb );
+        TS_ASSERT( entry._symbolicLowerBias == expected._symbolicLowerBias );
+        TS_ASSERT( entry._symbolicUpperBias == expected._symbolicUpperBias );
+    }
+
+    void test_load_corrupted_file()
+    {
+        NLR::BoundCache cache;
+        populateCache( cache, false );
+
+        MockErrno mockErrno;
+        MockFileFactory fileFactory;
+        fileFactory.mockFile.writtenLines = "marabou-bound-cache 1\n1\nentry 1 2 3\n";
+
+        TS_ASSERT_THROWS_EQUALS( cache.load( "cache.txt" ),
+                                 const NLRError &e,
+                                 e.getCode(),
+                                 NLRError::BOUND_CACHE_FILE_CORRUPTED );
+
+        // The cache is left unchanged
+        TS_ASSERT_EQUALS( cache.getNumberOfEntries(), 1u );
+    }
+};
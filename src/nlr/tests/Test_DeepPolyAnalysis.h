@@ -441,6 +441,154 @@ public:
             TS_ASSERT( existsBound( bounds, bound ) );
     }
 
+    void test_deeppoly_demand_driven_relus()
+    {
+        NLR::NetworkLevelReasoner nlr;
+        MockTableau tableau;
+        nlr.setTableau( &tableau );
+        populateNetwork( nlr, tableau );
+
+        tableau.setLowerBound( 0, -1 );
+        tableau.setUpperBound( 0, 1 );
+        tableau.setLowerBound( 1, -1 );
+        tableau.setUpperBound( 1, 1 );
+
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( nlr.demandDrivenDeepPolyPropagation() );
+
+        /*
+          Same as test_deeppoly_relus, except that x6 feeds a stable ReLU, so
+          it is only bounded in terms of x4 and x5:
+
+          x6: [0, 4]
+          x8: [0, 4]
+
+          This does not affect the bounds of the output layer.
+        */
+
+        double expectedBounds[5][2][2] = {
+            { { -2, 2 }, { -2, 2 } },
+            { { 0, 2 }, { 0, 2 } },
+            { { 0, 4 }, { -2, 2 } },
+            { { 0, 4 }, { 0, 2 } },
+            { { 1, 5.5 }, { 0, 2 } },
+        };
+
+        for ( unsigned i = 1; i <= 5; ++i )
+        {
+            for ( unsigned j = 0; j < 2; ++j )
+            {
+                TS_ASSERT( FloatUtils::areEqual(
+                    nlr.getLayer( i )->getLb( j ), expectedBounds[i - 1][j][0], 0.0001 ) );
+                TS_ASSERT( FloatUtils::areEqual(
+                    nlr.getLayer( i )->getUb( j ), expectedBounds[i - 1][j][1], 0.0001 ) );
+            }
+        }
+    }
+
+    void test_deeppoly_demand_driven_same_output_bounds()
+    {
+        typedef void ( DeepPolyAnalysisTestSuite::*Populate )( NLR::NetworkLevelReasoner &,
+                                                               MockTableau & );
+        List<Populate> networks( {
+            &DeepPolyAnalysisTestSuite::populateNetwork,
+            &DeepPolyAnalysisTestSuite::populateResidualNetwork1,
+            &DeepPolyAnalysisTestSuite::populateResidualNetwork2,
+            &DeepPolyAnalysisTestSuite::populateNetworkWithSigmoidsAndRound,
+        } );
+
+        for ( Populate populate : networks )
+        {
+            NLR::NetworkLevelReasoner nlr;
+            MockTableau tableau;
+            nlr.setTableau( &tableau );
+            ( this->*populate )( nlr, tableau );
+
+            NLR::NetworkLevelReasoner demandDrivenNlr;
+            MockTableau demandDrivenTableau;
+            demandDrivenNlr.setTableau( &demandDrivenTableau );
+            ( this->*populate )( demandDrivenNlr, demandDrivenTableau );
+
+            for ( MockTableau *t : { &tableau, &demandDrivenTableau } )
+            {
+                t->setLowerBound( 0, -1 );
+                t->setUpperBound( 0, 1 );
+                if ( nlr.getLayer( 0 )->getSize() > 1 )
+                {
+                    t->setLowerBound( 1, -1 );
+                    t->setUpperBound( 1, 1 );
+                }
+            }
+
+            TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+            TS_ASSERT_THROWS_NOTHING( nlr.deepPolyPropagation() );
+            TS_ASSERT_THROWS_NOTHING( demandDrivenNlr.obtainCurrentBounds() );
+            TS_ASSERT_THROWS_NOTHING( demandDrivenNlr.demandDrivenDeepPolyPropagation() );
+
+            const NLR::Layer *outputLayer = nlr.getLayer( nlr.getNumberOfLayers() - 1 );
+            const NLR::Layer *demandDrivenOutputLayer =
+                demandDrivenNlr.getLayer( demandDrivenNlr.getNumberOfLayers() - 1 );
+            for ( unsigned i = 0; i < outputLayer->getSize(); ++i )
+            {
+                TS_ASSERT( FloatUtils::areEqual(
+                    outputLayer->getLb( i ), demandDrivenOutputLayer->getLb( i ), 0.00001 ) );
+                TS_ASSERT( FloatUtils::areEqual(
+                    outputLayer->getUb( i ), demandDrivenOutputLayer->getUb( i ), 0.00001 ) );
+            }
+        }
+    }
+
+    void test_deeppoly_demand_driven_stored_symbolic_bounds()
+    {
+        NLR::NetworkLevelReasoner nlr;
+        MockTableau tableau;
+        nlr.setTableau( &tableau );
+        populateNetwork( nlr, tableau );
+
+        tableau.setLowerBound( 0, -1 );
+        tableau.setUpperBound( 0, 1 );
+        tableau.setLowerBound( 1, -1 );
+        tableau.setUpperBound( 1, 1 );
+
+        // Store the output symbolic bounds, which also tightens every layer
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( nlr.parameterisedDeepPoly( true ) );
+
+        // Loosen the output bounds, and require x10 <= 0.5. The stored bounds
+        // give x10 >= 1, so the analysis stops right after applying them.
+        NLR::Layer *outputLayer = nlr.getLayerIndexToLayer()[5];
+        outputLayer->setLb( 0, -1000 );
+        outputLayer->setUb( 0, 0.5 );
+        outputLayer->setLb( 1, -1000 );
+        outputLayer->setUb( 1, 1000 );
+        nlr.clearConstraintTightenings();
+
+        TS_ASSERT_THROWS_NOTHING( nlr.demandDrivenDeepPolyPropagation() );
+
+        List<Tightening> expectedBounds( { Tightening( 10, 1, Tightening::LB ),
+                                           Tightening( 11, 0, Tightening::LB ),
+                                           Tightening( 11, 2, Tightening::UB ) } );
+
+        List<Tightening> bounds;
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+        TS_ASSERT_EQUALS( expectedBounds.size(), bounds.size() );
+        for ( const auto &bound : expectedBounds )
+            TS_ASSERT( existsBound( bounds, bound ) );
+
+        // Once a hidden layer is looser than when the bounds were stored,
+        // they are no longer used, and the analysis runs from the input
+        nlr.getLayerIndexToLayer()[3]->setUb( 0, 1000 );
+        outputLayer->setLb( 0, -1000 );
+        nlr.clearConstraintTightenings();
+
+        TS_ASSERT_THROWS_NOTHING( nlr.demandDrivenDeepPolyPropagation() );
+
+        bounds.clear();
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+        TS_ASSERT( existsBound( bounds, Tightening( 6, 4, Tightening::UB ) ) );
+        TS_ASSERT( existsBound( bounds, Tightening( 10, 1, Tightening::LB ) ) );
+    }
+
     void populateMaxNetwork( NLR::NetworkLevelReasoner &nlr, MockTableau &tableau )
     {
         /*
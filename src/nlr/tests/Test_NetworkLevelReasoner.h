@@ -2497,6 +2497,40 @@ public:
         TS_ASSERT( FloatUtils::areEqual( output1[1], output2[1] ) );
     }
 
+    void test_store_into_other_shares_weights()
+    {
+        NLR::NetworkLevelReasoner nlr;
+
+        populateNetwork( nlr );
+
+        NLR::NetworkLevelReasoner nlr2;
+
+        TS_ASSERT_THROWS_NOTHING( nlr.storeIntoOther( nlr2 ) );
+
+        // The weights and biases are shared, not copied
+        TS_ASSERT_EQUALS( nlr.getLayer( 1 )->getWeights( 0 ), nlr2.getLayer( 1 )->getWeights( 0 ) );
+        TS_ASSERT_EQUALS( nlr.getLayer( 3 )->getWeights( 2 ), nlr2.getLayer( 3 )->getWeights( 2 ) );
+        TS_ASSERT_EQUALS( nlr.getLayer( 1 )->getBiases(), nlr2.getLayer( 1 )->getBiases() );
+
+        // Changing them in one network does not affect the other
+        double weight = nlr.getLayer( 1 )->getWeight( 0, 0, 1 );
+        double bias = nlr.getLayer( 1 )->getBias( 0 );
+
+        nlr2.setWeight( 0, 0, 1, 1, weight + 1 );
+        nlr2.setBias( 1, 0, bias + 1 );
+
+        TS_ASSERT_DIFFERS( nlr.getLayer( 1 )->getWeights( 0 ),
+                           nlr2.getLayer( 1 )->getWeights( 0 ) );
+        TS_ASSERT_DIFFERS( nlr.getLayer( 1 )->getBiases(), nlr2.getLayer( 1 )->getBiases() );
+        TS_ASSERT_EQUALS( nlr.getLayer( 1 )->getWeight( 0, 0, 1 ), weight );
+        TS_ASSERT_EQUALS( nlr2.getLayer( 1 )->getWeight( 0, 0, 1 ), weight + 1 );
+        TS_ASSERT_EQUALS( nlr.getLayer( 1 )->getBias( 0 ), bias );
+        TS_ASSERT_EQUALS( nlr2.getLayer( 1 )->getBias( 0 ), bias + 1 );
+
+        // Weights of other layers are still shared
+        TS_ASSERT_EQUALS( nlr.getLayer( 3 )->getWeights( 2 ), nlr2.getLayer( 3 )->getWeights( 2 ) );
+    }
+
     void test_store_into_other_with_sigmoids()
     {
         NLR::NetworkLevelReasoner nlr;
@@ -312,11 +312,14 @@ void SmtLibWriter::addLeakyReLUConstraint( unsigned b,
 
 void SmtLibWriter::addTableauRow( const SparseUnsortedList &row, List<String> &instance )
 {
+    if ( row.empty() )
+        return;
+
     unsigned size = row.getSize();
 
     // Avoid adding a redundant last element
-    auto it = --row.end();
-    if ( std::isnan( it->_value ) || FloatUtils::isZero( it->_value ) )
+    const auto *last = row.end() - 1;
+    if ( std::isnan( last->_value ) || FloatUtils::isZero( last->_value ) )
         --size;
 
     if ( !size )